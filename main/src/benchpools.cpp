@@ -63,7 +63,8 @@ int main(int argc, char** argv) {
                                                         {"bpool",new n_pools::Pool<Msg, boost::pool<>>(128)},{"slabpool",new n_pools::SlabPool<Msg>(tsize)},
                                                         {"dynpool",new n_pools::DynamicSlabPool<Msg>(128)} ,{"stackpool", new n_pools::StackPool<Msg>(128)},
                                                         {"newdel", new n_pools::Pool<Msg, std::false_type>(tsize/2)},
-                                                        {"cfpool",new n_pools::CFPool<Msg>(128)}
+                                                        {"cfpool",new n_pools::CFPool<Msg>(128)},
+                                                        {"sizeclass",new n_pools::SizeClassPool<Msg>(128)}
                                                           };
         //size_t allocsize = (tsize*sizeof(Msg))/(1024*1024);
         //std::cout << "Benchmark will allocate at least " << allocsize << " MB " << std::endl;
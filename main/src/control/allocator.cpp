@@ -29,7 +29,8 @@ void Allocator::setSimType(SimType type)
 	assert(((type & SimType::CLASSIC)
 		^ (type & SimType::CONSERVATIVE)
 		^ (type & SimType::DYNAMIC)
-		^ (type & SimType::OPTIMISTIC)) && "Simulation type is not an enum value of SimType.");
+		^ (type & SimType::OPTIMISTIC)
+		^ (type & SimType::HYBRID)) && "Simulation type is not an enum value of SimType.");
 	m_simtype = type;
 }
 
@@ -0,0 +1,56 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include <algorithm>
+#include <numeric>
+#include "control/balancepolicy.h"
+
+namespace n_control {
+
+ThresholdBalancePolicy::ThresholdBalancePolicy(double imbalance, std::size_t maxMoves)
+	: m_imbalance(imbalance), m_maxMoves(maxMoves)
+{
+}
+
+std::vector<Migration> ThresholdBalancePolicy::balance(const std::vector<CoreLoad>& loads)
+{
+	std::vector<Migration> moves;
+	if(loads.size() < 2)
+		return moves;
+	const auto busier = [](const CoreLoad& l, const CoreLoad& r){return l.m_busy < r.m_busy;};
+	const std::size_t busiest = std::max_element(loads.begin(), loads.end(), busier) - loads.begin();
+	const std::size_t idlest = std::min_element(loads.begin(), loads.end(), busier) - loads.begin();
+	if(busiest == idlest || loads[busiest].m_busy <= m_imbalance * loads[idlest].m_busy)
+		return moves;
+
+	const std::vector<std::size_t>& events = loads[busiest].m_events;
+	const std::size_t total = std::accumulate(events.begin(), events.end(), std::size_t(0));
+	if(total == 0)
+		return moves;
+	// Half the difference in busy time, in transitions of the busiest core.
+	double budget = double(loads[busiest].m_busy - loads[idlest].m_busy) / 2.0
+		* double(total) / double(loads[busiest].m_busy);
+
+	std::vector<std::size_t> order(events.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&events](std::size_t l, std::size_t r){return events[l] > events[r];});
+	for(std::size_t id : order){
+		if(moves.size() == m_maxMoves || events[id] == 0)
+			break;
+		// A model that is too busy would only make the other core the busiest.
+		if(double(events[id]) > budget)
+			continue;
+		moves.emplace_back(busiest, id, idlest);
+		budget -= double(events[id]);
+	}
+	return moves;
+}
+
+} /* namespace n_control */
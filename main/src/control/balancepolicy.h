@@ -0,0 +1,98 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_CONTROL_BALANCEPOLICY_H_
+#define SRC_CONTROL_BALANCEPOLICY_H_
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace n_control {
+
+/**
+ * What a core measured since the last balance round.
+ */
+struct CoreLoad
+{
+	/// Time (ns) the core spent in simulation steps.
+	std::size_t m_busy;
+	/// Nr of transitions (including undone ones) of each model, indexed by local id.
+	std::vector<std::size_t> m_events;
+
+	CoreLoad()
+		: m_busy(0)
+	{;}
+};
+
+/**
+ * Move a model to another core.
+ */
+struct Migration
+{
+	/// Core the model is on.
+	std::size_t m_core;
+	/// Local id of the model on that core.
+	std::size_t m_model;
+	/// Core the model moves to.
+	std::size_t m_target;
+
+	Migration(std::size_t core, std::size_t model, std::size_t target)
+		: m_core(core), m_model(model), m_target(target)
+	{;}
+};
+
+/**
+ * Decides which models move between the cores of an optimistic simulation, each balance round.
+ * Subclass to provide another policy.
+ * @see Controller::setBalancePolicy
+ */
+class BalancePolicy
+{
+public:
+	BalancePolicy() = default;
+	virtual ~BalancePolicy(){;}
+
+	/**
+	 * @param loads : per core, what it measured since the last balance round.
+	 * @return the models to move, a move the cores can't make yet is skipped.
+	 */
+	virtual
+	std::vector<Migration>
+	balance(const std::vector<CoreLoad>& loads) = 0;
+};
+
+/**
+ * Default policy : if the busiest core spent more than imbalance times as long in its steps as the least busy one,
+ * its most active models move there until about half the difference is moved.
+ * A model's share of its core's busy time is taken to be its share of the core's transitions.
+ */
+class ThresholdBalancePolicy: public BalancePolicy
+{
+private:
+	double m_imbalance;
+	std::size_t m_maxMoves;
+
+public:
+	/**
+	 * @param imbalance : ratio of busy times that triggers a move, > 1.
+	 * @param maxMoves : nr of models that can move in a single round.
+	 */
+	ThresholdBalancePolicy(double imbalance = 1.25, std::size_t maxMoves = 4);
+
+	std::vector<Migration>
+	balance(const std::vector<CoreLoad>& loads) override;
+};
+
+typedef std::shared_ptr<BalancePolicy> t_balancepolicyptr;
+
+} /* namespace n_control */
+
+#endif /* SRC_CONTROL_BALANCEPOLICY_H_ */
@@ -9,11 +9,19 @@
  */
 
 #include "control/controller.h"
+#include "control/executor.h"
+#include "control/snapshot.h"
 #include "tools/flags.h"
 #include <deque>
 #include <thread>
 #include <chrono>
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+#include <cerrno>
+#include <unistd.h>
 #include "tools/objectfactory.h"
+#include "tools/stringtools.h"
 #include "pools/pools.h"
 
 using namespace n_tools;
@@ -23,14 +31,19 @@ namespace n_control {
 Controller::Controller(std::string name, std::vector<t_coreptr>& cores,
         std::shared_ptr<Allocator>& alloc, n_tracers::t_tracersetptr& tracers,
         size_t saveInterval, size_t turns)
-	: m_simType(SimType::CLASSIC), m_hasMainModel(false), m_isSimulating(false), m_name(name), m_checkTermTime(
+	: m_simType(SimType::CLASSIC), m_hasMainModel(false), m_isSimulating(false), m_hasRun(false), m_name(name), m_checkTermTime(
 	false), m_checkTermCond(false), m_saveInterval(saveInterval), m_zombieIdleThreshold(10),m_cores(cores), m_allocator(
-	        alloc), m_tracers(tracers), m_dsPhase(false), m_sleep_gvt_thread(200), m_rungvt(false), m_turns(turns)
+	        alloc), m_tracers(tracers), m_dsPhase(false), m_sleep_gvt_thread(200), m_adaptive_gvt(true), m_historyBudget(0), m_rungvt(false), m_turns(turns), m_workers(0),
+	m_balancePolicy(nullptr), m_balanceRounds(8), m_balancing(false), m_balanceDue(0), m_balanced(0), m_balanceArrived(0),
+	m_balanceAborted(false), m_migrated(0)
 #ifdef USE_STAT
 	, m_gvtStarted("_controller/gvt_started", ""),
-	m_gvtSecondRound("_controller/gvt_2nd_rounds", ""),
-	m_gvtFailed("_controller/gvt_failed", ""),
-	m_gvtFound("_controller/gvt_found", "")
+	m_gvtFound("_controller/gvt_found", ""),
+	m_gvtShorter("_controller/gvt_interval_shortened", ""),
+	m_gvtLonger("_controller/gvt_interval_lengthened", ""),
+	m_gvtInterval("_controller/gvt_interval_total", "ms"),
+	m_gvtCancelbacks("_controller/cancelbacks", ""),
+	m_migrations("_controller/migrations", "")
 #endif
 {
         n_pools::setMain();
@@ -40,35 +53,17 @@ Controller::~Controller()
 {
 }
 
-//enum CTRLSTAT_TYPE{GVT_2NDRND,GVT_FOUND,GVT_START,GVT_FAILED};
-
-void Controller::logStat(CTRLSTAT_TYPE ev)
+void Controller::logGVTStats()
 {
 #ifdef USE_STAT
-
-        switch(ev){
-        case GVT_2NDRND:{
-                ++m_gvtSecondRound;
-                break;
-        }
-        case GVT_FAILED:{
-                ++m_gvtFailed;
-                break;
-        }
-        case GVT_START:{
-                ++m_gvtStarted;
-                break;
-        }
-        case GVT_FOUND:{
-                ++m_gvtFound;
-                break;
-        }
-        default:
-                LOG_ERROR("No such stattype");
-        //case GVT
-        }
-//#else // TODO use compiler attribute pure, allows compiler to ignore fcall().
-        // see http://stackoverflow.com/questions/6623879/c-optimizing-function-with-no-side-effects
+	if(!m_sharedGVT)
+		return;
+	m_gvtStarted += m_sharedGVT->getRounds();
+	m_gvtFound += m_sharedGVT->getFound();
+	m_gvtShorter += m_sharedGVT->getShortened();
+	m_gvtLonger += m_sharedGVT->getLengthened();
+	m_gvtInterval += m_sharedGVT->getWaited();
+	m_gvtCancelbacks += m_sharedGVT->getCancelbacks();
 #endif
 }
 
@@ -170,6 +165,30 @@ void Controller::emptyAllCores()
 	m_root.reset(); // reset root
 }
 
+void Controller::setWorkerThreads(std::size_t workers)
+{
+	assert(m_isSimulating == false && "Cannot change the nr of worker threads during simulation");
+	m_workers = workers;
+}
+
+std::size_t Controller::getWorkerThreads() const
+{
+	return m_workers;
+}
+
+void Controller::setBalancePolicy(const t_balancepolicyptr& policy, std::size_t rounds)
+{
+	assert(m_isSimulating == false && "Cannot change the balance policy during simulation");
+	assert(rounds > 0 && "A balance round needs at least one new GVT.");
+	m_balancePolicy = policy;
+	m_balanceRounds = rounds;
+}
+
+std::size_t Controller::getMigrations() const
+{
+	return m_migrated;
+}
+
 void Controller::setGVTInterval(std::size_t ms)
 {
 	this->m_sleep_gvt_thread.store(ms);
@@ -180,6 +199,110 @@ std::size_t Controller::getGVTInterval()
 	return this->m_sleep_gvt_thread;
 }
 
+void Controller::setAdaptiveGVT(bool adaptive)
+{
+	m_adaptive_gvt.store(adaptive);
+}
+
+bool Controller::isAdaptiveGVT() const
+{
+	return m_adaptive_gvt.load();
+}
+
+void Controller::setHistoryBudget(std::size_t budget)
+{
+	m_historyBudget = budget;
+}
+
+std::size_t Controller::getCancelbacks() const
+{
+	return m_sharedGVT? m_sharedGVT->getCancelbacks() : 0;
+}
+
+std::vector<t_atomicmodelptr> Controller::getAtomics() const
+{
+	std::vector<t_atomicmodelptr> models;
+	for (const auto& core : m_cores) {
+		for (std::size_t i = 0; i < core->getModelCount(); ++i)
+			models.push_back(core->getModel(i));
+	}
+	return models;
+}
+
+void Controller::saveSnapshot(std::ostream& out)
+{
+	assert(m_isSimulating == false && "Can't save a snapshot while simulating.");
+	t_timestamp time = t_timestamp::infinity();
+	for (const auto& core : m_cores)
+		time = std::min(time, core->getTime());
+	writeSnapshot(out, getAtomics(), time);
+}
+
+void Controller::saveSnapshot(const std::string& path)
+{
+	std::ofstream out(path, std::ios::binary);
+	if (!out.is_open())
+		throw std::logic_error("File not open : " + path);
+	saveSnapshot(out);
+}
+
+t_timestamp Controller::loadSnapshot(std::istream& in)
+{
+	assert(m_isSimulating == false && "Can't load a snapshot while simulating.");
+	return readSnapshot(in, getAtomics());
+}
+
+t_timestamp Controller::loadSnapshot(const std::string& path)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in.is_open())
+		throw std::logic_error("File not open : " + path);
+	return loadSnapshot(in);
+}
+
+pid_t Controller::fork()
+{
+	assert(m_isSimulating == false && "Can't fork while simulating.");
+	if (m_simType != SimType::CLASSIC && m_simType != SimType::CONSERVATIVE)
+		throw std::logic_error("Only a classic or conservative simulation can be forked.");
+	for (const auto& core : m_cores) {
+		// The helpers of the pool don't exist in the child.
+		if (core->getForkJoinPool())
+			throw std::logic_error("Can't fork a simulation with transition threads.");
+	}
+	LOG_INFO("CONTROLLER: forking simulation.");
+	LOG_FLUSH;
+	// Buffered output would be written by both processes.
+	m_tracers->flushTracers();
+	std::cout.flush();
+	const pid_t pid = ::fork();
+	if (pid < 0)
+		throw std::system_error(errno, std::system_category(), "Can't fork simulation");
+	if (pid == 0) {
+		const std::string suffix = "." + n_tools::toString(getpid());
+		LOG_FORK(suffix);
+		m_tracers->forkTracers(suffix);
+		LOG_INFO("CONTROLLER: continuing forked simulation.");
+	}
+	return pid;
+}
+
+void Controller::continueCores()
+{
+	if (m_simType != SimType::CLASSIC && m_simType != SimType::CONSERVATIVE)
+		throw std::logic_error("Only a classic or conservative simulation can be continued.");
+	for (const auto& core : m_cores) {
+		std::vector<t_atomicmodelptr> models;
+		for (std::size_t i = 0; i < core->getModelCount(); ++i)
+			models.push_back(core->getModel(i));
+		core->clearModels();
+		for (const auto& model : models) {
+			model->restoreTime(model->getTimeLast(), model->getTimeNext());
+			core->addModel(model);
+		}
+	}
+}
+
 void Controller::distributeTerminationTime(t_timestamp ntime)
 {
 	for (const auto& core : m_cores) {
@@ -196,7 +319,12 @@ void Controller::simulate()
 		return;
 	}
 	LOG_DEBUG("simulating to ending time: ", m_checkTermTime? m_terminationTime:t_timestamp::infinity());
-	m_tracers->startTrace();
+	if (m_hasRun) {
+		continueCores();
+		m_tracers->continueTrace();
+	} else {
+		m_tracers->startTrace();
+	}
 	m_isSimulating = true;
         
         for (const auto& core : m_cores) {
@@ -216,6 +344,7 @@ void Controller::simulate()
 		simDEVS();
 		break;
 	case SimType::OPTIMISTIC:
+	case SimType::HYBRID:
                 simOPDEVS();
 		break;
 	case SimType::CONSERVATIVE:
@@ -235,6 +364,7 @@ void Controller::simulate()
 	m_tracers->finishTrace();
 
 	m_isSimulating = false;
+	m_hasRun = true;
 }
 
 void Controller::simDEVS()
@@ -264,6 +394,26 @@ void Controller::simDEVS()
 void Controller::simOPDEVS()
 {
 	this->m_rungvt.store(true);
+	// The cores compute GVT among themselves, from their simulation steps.
+	m_sharedGVT = n_tools::createObject<n_model::SharedGVT>(m_cores.size(), m_sleep_gvt_thread.load(), m_adaptive_gvt.load());
+	m_sharedGVT->setHistoryBudget(m_historyBudget);
+	for (const auto& core : m_cores)
+		core->setSharedGVT(m_sharedGVT);
+	m_balancing = m_balancePolicy && m_simType == SimType::OPTIMISTIC;
+	if (m_balancing) {
+		m_balanceDue.store(m_balanceRounds);
+		m_balanced.store(0);
+		m_balanceArrived = 0;
+		m_balanceAborted = false;
+		m_balanceWaiting.assign(m_cores.size(), 0);
+		m_busy.assign(m_cores.size(), 0);
+	}
+        if(useExecutor()){
+                runExecutor(true);
+                m_lastGVT = t_timestamp(m_sharedGVT->getGVT(), 0);
+                logGVTStats();
+                return;
+        }
         std::atomic<int> atint(m_cores.size());
         std::condition_variable cv;
         std::mutex mu;
@@ -276,15 +426,20 @@ void Controller::simOPDEVS()
 		LOG_INFO("CONTROLLER: Started thread # ", i);
 	}
         
-	this->startGVTThread();
-        
 	for (auto& t : m_threads) {
 		t.join();
 	}
+	m_threads.clear();
+	m_lastGVT = t_timestamp(m_sharedGVT->getGVT(), 0);
+	logGVTStats();
 }
 
 void Controller::simCPDEVS()
 {	
+        if(useExecutor()){
+                runExecutor(false);
+                return;
+        }
         std::atomic<int> atint(m_cores.size());
         std::condition_variable cv;
         std::mutex mu;
@@ -299,6 +454,7 @@ void Controller::simCPDEVS()
 	for (auto& t : m_threads) {
 		t.join();
 	}
+	m_threads.clear();
 }
 
 void Controller::simDSDEVS()
@@ -327,13 +483,6 @@ void Controller::simDSDEVS()
 	}
 }
 
-void Controller::startGVTThread()
-{
-	std::thread charlie(&beginGVT, std::ref(*this), std::ref(m_rungvt));
-	charlie.join();
-	LOG_INFO("Controller:: GVT thread joined");
-}
-
 bool Controller::check()
 {
 	for (const auto& core : m_cores) {
@@ -439,6 +588,185 @@ bool Controller::isInDSPhase() const
 	return m_dsPhase;
 }
 
+bool Controller::stepOptimistic(std::size_t coreid)
+{
+        if (m_balancing && waitBalance(coreid))
+                return true;
+        const auto& core = m_cores[coreid];
+        if (core->getZombieRounds() > m_zombieIdleThreshold) {
+                LOG_INFO("CVWORKER: Thread for core ", core->getCoreID(),
+                        " Core is zombie, yielding thread. [round ", core->getZombieRounds(), "]");
+                core->setLive(false);
+        }
+
+        if (!core->isLive()) {
+                bool quit = true;
+                for (const auto& coreentry : m_cores) {
+                        if (coreentry->isLive()) {
+                                quit = false;
+                                break;
+                        }
+                }
+                if (quit) {
+                        if (!core->existTransientMessage()) {// If we've sent a message or there is one waiting, we can't quit (revert)
+                                LOG_INFO("CVWORKER: Thread ", std::this_thread::get_id(), " for core ", core->getCoreID(),
+                                        " all other threads are stopped or idle, network is idle, quitting, gvt_run = false now.");
+                                m_rungvt.store(false);
+                                return false;
+                        }else{
+                                LOG_INFO("CVWORKER: Thread for core ", core->getCoreID(),
+                                        " all other threads are stopped or idle, network still reports transients, idling.");
+                                if(!m_rungvt){// If 1 or more cores have stopped, network can remain transient, we can't guarantee it emptying.
+                                        LOG_INFO("CVWORKER: Thread for core ", core->getCoreID(), " at least one core has quit, have to exit as well.");
+                                        return false;
+                                }
+                        }
+                }
+                // An idle core waits on the others, don't spin on a shared cpu.
+                std::this_thread::yield();
+        }
+        LOG_DEBUG("CVWORKER: Thread for core ", core->getCoreID(), " running simstep [zrounds:", core->getZombieRounds(), "]");
+        if (m_balancing) {
+                const auto start = std::chrono::steady_clock::now();
+                core->runSmallStep();
+                m_busy[coreid] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start).count();
+                return true;
+        }
+        core->runSmallStep();
+        return true;
+}
+
+bool Controller::waitBalance(std::size_t coreid)
+{
+        std::size_t& round = m_balanceWaiting[coreid];
+        if (round == 0) {
+                if (m_sharedGVT->getFound() < m_balanceDue.load())
+                        return false;
+                std::lock_guard<std::mutex> lock(m_balanceLock);
+                if (m_balanceAborted)
+                        return false;
+                round = m_balanced.load() + 1;
+                if (++m_balanceArrived == m_cores.size()) {
+                        LOG_INFO("CONTROLLER: Core ", coreid, " starting balance round ", round);
+                        this->balance();
+                        m_balanceArrived = 0;
+                        m_balanced.store(round);
+                        round = 0;
+                        return false;
+                }
+        }
+        if (m_balanced.load() >= round) {
+                round = 0;
+                return false;
+        }
+        if (!m_rungvt.load()) {
+                // A core has quit, the others may never arrive.
+                std::lock_guard<std::mutex> lock(m_balanceLock);
+                if (m_balanced.load() < round) {
+                        LOG_INFO("CONTROLLER: Core ", coreid, " giving up on balance round ", round);
+                        m_balanceAborted = true;
+                        m_balanceDue.store(std::numeric_limits<std::size_t>::max());
+                        --m_balanceArrived;
+                }
+                round = 0;
+                return false;
+        }
+        std::this_thread::yield();
+        return true;
+}
+
+void Controller::balance()
+{
+        // A round in progress may already have counted the times the moves change.
+        if (m_sharedGVT->isActive()) {
+                m_balanceDue.store(m_sharedGVT->getFound() + 1);
+                return;
+        }
+        m_balanceDue.store(m_sharedGVT->getFound() + m_balanceRounds);
+        std::vector<CoreLoad> loads(m_cores.size());
+        for (std::size_t i = 0; i < m_cores.size(); ++i) {
+                const t_coreptr& core = m_cores[i];
+                loads[i].m_busy = m_busy[i];
+                m_busy[i] = 0;
+                loads[i].m_events.resize(core->getModelCount());
+                for (std::size_t id = 0; id < core->getModelCount(); ++id) {
+                        loads[i].m_events[id] = core->getModel(id)->getEvents();
+                        core->getModel(id)->resetEvents();
+                }
+        }
+        std::vector<Migration> moves = m_balancePolicy->balance(loads);
+        // A move renumbers the last model of its core, so the highest ids of a core move first.
+        std::sort(moves.begin(), moves.end(), [](const Migration& l, const Migration& r){
+                return l.m_core != r.m_core? l.m_core < r.m_core : l.m_model > r.m_model;
+        });
+        const t_timestamp::t_time gvt = m_sharedGVT->getGVT();
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+                const Migration& move = moves[i];
+                if (move.m_core >= m_cores.size() || move.m_target >= m_cores.size() || move.m_core == move.m_target
+                        || move.m_model >= loads[move.m_core].m_events.size()
+                        || (i && move.m_core == moves[i-1].m_core && move.m_model == moves[i-1].m_model))
+                        continue;
+                if (m_cores[move.m_core]->migrateModel(move.m_model, *m_cores[move.m_target], gvt)) {
+                        LOG_INFO("CONTROLLER: Moved model ", move.m_model, " from core ", move.m_core, " to core ", move.m_target);
+                        ++m_migrated;
+                        m_migrations += 1;
+                }
+        }
+}
+
+bool Controller::stepConservative(std::size_t coreid)
+{
+        const auto& core = m_cores[coreid];
+        if (!core->isLive()) {
+                LOG_DEBUG(" Core no longer live :: ", core->getCoreID(), " exiting working function."); // don't log time (^sync)
+                return false;
+        }
+        LOG_DEBUG("CVWORKER: Thread for core ", core->getCoreID(), " running simstep");
+        core->runSmallStep();
+        return true;
+}
+
+bool Controller::useExecutor() const
+{
+        return m_workers != 0 && m_workers < m_cores.size();
+}
+
+void Controller::runExecutor(bool optimistic)
+{
+        WorkStealingExecutor executor(m_workers, m_cores.size());
+        LOG_INFO("CONTROLLER: Running ", m_cores.size(), " cores on ", m_workers, " worker threads.");
+        executor.start(
+                [this, optimistic](std::size_t id, std::size_t round)->bool{
+                        const auto& core = m_cores[id];
+                        if(round == 0)
+                                core->initThread();
+                        if(round == m_turns){
+                                // Same safety catch as the thread per core workers.
+                                LOG_WARNING("CVWORKER: ", core->getCoreID(), " overran nr of simulation steps allowed !!");
+                                core->setLive(false);
+                                m_rungvt.store(false);
+                                return false;
+                        }
+                        if(optimistic){
+                                if(!stepOptimistic(id)){
+                                        m_rungvt.store(false);             // Lets the other cores quit.
+                                        return false;
+                                }
+                                return true;
+                        }
+                        return stepConservative(id);
+                },
+                [this](std::size_t id)->void{
+                        const auto& core = m_cores[id];
+                        core->setLive(false);
+                        LOG_DEBUG("Core ", core->getCoreID(), "exiting.");
+                        core->shutDown();
+                });
+        executor.join();
+        LOG_INFO("CONTROLLER: Executor finished, workers stole ", executor.steals(), " cores.");
+}
+
 void cvworker(std::size_t myid, std::size_t turns, Controller& ctrl, std::atomic<int>& atint, std::mutex& mu, std::condition_variable& cv)
 {
         const auto& core = ctrl.m_cores[myid];
@@ -451,42 +779,10 @@ void cvworker(std::size_t myid, std::size_t turns, Controller& ctrl, std::atomic
         LOG_DEBUG("CVWORKER : TURNS == ctrl", ctrl.m_turns, " turns = ", turns);
         size_t i = 0;
         for (; i < turns; ++i) {		// Turns are only here to avoid possible infinite loop
-                if (core->getZombieRounds() > ctrl.m_zombieIdleThreshold) {
-                        LOG_INFO("CVWORKER: Thread for core ", core->getCoreID(),
-                                " Core is zombie, yielding thread. [round ", core->getZombieRounds(), "]");
-                        core->setLive(false);
-                }
-                        
-                
-                if (!core->isLive()) {
-                        bool quit = true;
-                        for (const auto& coreentry : ctrl.m_cores) {
-                                if (coreentry->isLive()) {
-                                        quit = false;
-                                        break;
-                                }
-                        }
-                        if (quit) {              
-                                if (!core->existTransientMessage()) {// If we've sent a message or there is one waiting, we can't quit (revert)
-                                        LOG_INFO("CVWORKER: Thread ", std::this_thread::get_id(), " ", myid, " for core ", core->getCoreID(),
-                                                " all other threads are stopped or idle, network is idle, quitting, gvt_run = false now.");
-                                        ctrl.m_rungvt.store(false);
-                                        break;
-                                }else{
-                                        LOG_INFO("CVWORKER: Thread ", myid, " for core ", core->getCoreID(),
-                                " all other threads are stopped or idle, network still reports transients, idling.");
-                                        if(!ctrl.m_rungvt){// If 1 or more cores have stopped, network can remain transient, we can't guarantee it emptying.
-                                                LOG_INFO("CVWORKER: Thread ", myid, " for core ", core->getCoreID(), " at least one core has quit, have to exit as well.");
-                                                break;
-                                        }
-                                }
-                        }
-                }
-                LOG_DEBUG("CVWORKER: Thread for core ", core->getCoreID(), " running simstep in round ", i,
-                        " [zrounds:", core->getZombieRounds(), "]");
-                core->runSmallStep();
+                if(!ctrl.stepOptimistic(myid))
+                        break;
         }
-        ctrl.m_rungvt.store(false);             // Required to halt gvt.
+        ctrl.m_rungvt.store(false);             // Lets the other cores quit.
          // Wait for all other cores to go idle.
         // Should a core have reached the nr of turns (a safety catch), make sure we set Live ourselves.
         if(i==turns){
@@ -515,6 +811,16 @@ void cvworker(std::size_t myid, std::size_t turns, Controller& ctrl, std::atomic
         LOG_DEBUG("CVWORKER: Thread ", std::this_thread::get_id(), " for core ", core->getCoreID(),
                 " exiting working function,  setting gvt intercept flag to false.");
         at_exit();
+        // A model that moved to another core can hold memory from our pools, which are freed when this thread exits.
+        {
+                std::unique_lock<std::mutex> lk(mu);
+                atint -= 1;
+                const int exited = -int(ctrl.m_cores.size());
+                if(atint > exited)
+                        cv.wait(lk, [&atint, exited]{return atint.load() <= exited;});
+                else
+                        cv.notify_all();
+        }
 }
 
 void cvworker_con(std::size_t myid, std::size_t turns, Controller& ctrl, std::atomic<int>& atint, std::mutex& mu, std::condition_variable& cv)
@@ -525,12 +831,8 @@ void cvworker_con(std::size_t myid, std::size_t turns, Controller& ctrl, std::at
         core->initThread();
 	for (; i < turns; ++i) {		// Turns are only here to avoid possible infinite loop
 
-		if (!core->isLive()) {          
-                        LOG_DEBUG(" Core no longer live :: ", core->getCoreID(), " exiting working function."); // don't log time (^sync)
+		if (!ctrl.stepConservative(myid))
                         break;
-		}
-                LOG_DEBUG("CVWORKER: Thread for core ", core->getCoreID(), " running simstep in round ", i );
-                core->runSmallStep();
 	}
         // Wait for all other cores to go idle.
         // Should a core have reached the nr of turns (a safety catch), make sure we set Live ourselves.
@@ -579,98 +881,16 @@ void cvworker_con(std::size_t myid, std::size_t turns, Controller& ctrl, std::at
         */
         LOG_DEBUG("CVWORKER: Thread for core ", core->getCoreID(), " exiting working function");
         core->shutDown();
-}
-
-void beginGVT(Controller& ctrl, std::atomic<bool>& m_rungvt)
-{
-	constexpr std::size_t infguard = 100;
-	std::size_t i = 0;
-
-	while(m_rungvt.load()==true){
-		if(infguard < ++i){
-			LOG_WARNING("Controller :: GVT overran max ", infguard, " nr of invocations, breaking off.");
-			m_rungvt.store(false);
-			break;
-		}
-		std::chrono::milliseconds ms { ctrl.getGVTInterval() };// Wait before running gvt, this prevents an obvious gvt of zero.
-		std::this_thread::sleep_for(ms);
-		LOG_INFO("Controller:: starting GVT");
-		runGVT(ctrl, m_rungvt);
-	}
-}
-
-void runGVT(Controller& cont, std::atomic<bool>& gvtsafe)
-{
-	if (not gvtsafe) {
-		LOG_INFO("Controller:  rungvt set to false by some Core thread, stopping GVT.");
-		return;
-	}
-        cont.logStat(GVT_START);
-        
-	const std::size_t corecount = cont.m_cores.size();
-	t_controlmsg cmsg = n_tools::createObject<ControlMessage>(corecount, t_timestamp::infinity(),
-	        t_timestamp::infinity());
-
-        /// Let Pinit start first round
-        const t_coreptr& first = cont.m_cores[0];
-        first->receiveControl(cmsg, 0, gvtsafe);
-	for (size_t i = 1; i < corecount; ++i) {
-		cont.m_cores[i]->receiveControl(cmsg, 0, gvtsafe);
-		if (gvtsafe == false) {
-			LOG_INFO("Controller rungvt set to false by some Core thread, stopping GVT.");
-			return;
-		}
-	}
-        
-	/// First round done, let Pinit check if we have found a gvt.
-	first->receiveControl(cmsg, 1, gvtsafe);
-        if (gvtsafe == false) {
-                LOG_INFO("Controller rungvt set to false by some Core thread, stopping GVT.");
-                return;
+        // Received messages are released into the sender's pools, which are freed when that thread exits.
+        {
+                std::unique_lock<std::mutex> lk(mu);
+                atint -= 1;
+                const int exited = -int(ctrl.m_cores.size());
+                if(atint > exited)
+                        cv.wait(lk, [&atint, exited]{return atint.load() <= exited;});
+                else
+                        cv.notify_all();
         }
-        
-	if (cmsg->isGvtFound()) {
-		cont.logStat(GVT_FOUND);
-		LOG_INFO("Controller: found GVT after first round, gvt=", cmsg->getGvt(), " updating cores.");
-		for (const auto& ucore : cont.m_cores)
-			ucore->setGVT(cmsg->getGvt());
-		n_tracers::traceUntil(cmsg->getGvt());
-		cont.m_lastGVT = cmsg->getGvt();
-	} else {
-                ///// 2nd round initiated.
-		cont.logStat(GVT_2NDRND);
-		if (gvtsafe == false) {
-			LOG_INFO("Controller rungvt set to false by some Core thread, stopping GVT.");
-			return;
-		}
-		for (std::size_t j = 1; j < corecount; ++j){
-			cont.m_cores[j]->receiveControl(cmsg, 1, gvtsafe);
-                        if (gvtsafe == false) {
-                                LOG_INFO("Controller rungvt set to false by some Core thread, stopping GVT.");
-                                return;
-                        }       
-                }
-                if (gvtsafe == false) {
-			LOG_INFO("Controller rungvt set to false by some Core thread, stopping GVT.");
-			return;
-		}
-                first->receiveControl(cmsg, 2, gvtsafe);  // Controlmessage must be passed to Invoking core again.
-                
-		if (cmsg->isGvtFound()) {
-			cont.logStat(GVT_FOUND);
-			LOG_INFO("Controller: found GVT after second round, gvt=", cmsg->getGvt(), " updating cores.");
-
-			for (const auto& ucore : cont.m_cores)
-				ucore->setGVT(cmsg->getGvt());
-			n_tracers::traceUntil(cmsg->getGvt());
-			cont.m_lastGVT = cmsg->getGvt();
-		} else {
-			cont.logStat(GVT_FAILED);
-                        gvtsafe.store(false);
-			LOG_ERROR("Controller : Algorithm did not find GVT in second round. Stopping invocations of algorithm.");
-                        cmsg->logMessageState();
-		}
-	}
 }
 
 } /* namespace n_control */
@@ -17,13 +17,16 @@
 #include <atomic>
 #include <memory>
 #include <thread>
+#include <mutex>
 #include <condition_variable>
+#include <sys/types.h>
 #include "network/timestamp.h"
 #include "model/atomicmodel.h"
 #include "model/coupledmodel.h"
 #include "model/rootmodel.h"
 #include "model/port.h"
 #include "control/allocator.h"
+#include "control/balancepolicy.h"
 #include "model/core.h"
 #include "tracers/tracers.h"
 #include "tools/globallog.h"
@@ -38,8 +41,6 @@ using n_model::t_coreptr;
 using n_model::t_atomicmodelptr;
 using n_model::t_coupledmodelptr;
 
-enum CTRLSTAT_TYPE{GVT_2NDRND,GVT_FOUND,GVT_START,GVT_FAILED};
-
 /**
  * @brief Provides control over a simulation
  */
@@ -49,6 +50,7 @@ private:
 	SimType m_simType;
 	bool m_hasMainModel;
 	bool m_isSimulating;
+	bool m_hasRun;
 
 	std::string m_name;
 
@@ -67,22 +69,36 @@ private:
 	n_tracers::t_tracersetptr m_tracers;
 	t_timestamp m_lastGVT;
 
+	/**
+	 * GVT of the running (or last) optimistic simulation.
+	 */
+	n_model::t_sharedgvtptr m_sharedGVT;
+
 	DSSharedState m_sharedState;
 	bool m_dsPhase;
 
 	std::vector<std::thread> m_threads;
 
 	/**
-	 * Interval time (in milliseconds) during which consecutive gvt calculations are performed.
-	 * A GVT thread will run [5ms |run| interval | interval | ... ].
-	 * @attention : The OS will schedule at least interval sleep time, but more is of course possible.
+	 * Interval time (in milliseconds) between the end of a gvt calculation and the start of the next.
 	 * @synchronized
 	 */
 	std::atomic<std::size_t> m_sleep_gvt_thread;
 
 	/**
-	 * Shared memory flag. Used to signal between threads simulating Cores and
-	 * the GVT thread whether or not the last should continue.
+	 * If true, the GVT interval adapts to the growth of the cores' history,
+	 * starting from (and at most GVT_BACKOFF times) m_sleep_gvt_thread.
+	 */
+	std::atomic<bool> m_adaptive_gvt;
+
+	/**
+	 * Nr of messages and states the optimistic cores may keep together, 0 if unbounded.
+	 */
+	std::size_t m_historyBudget;
+
+	/**
+	 * Shared memory flag. Used to signal between threads simulating Cores
+	 * whether or not they should continue.
 	 * False means interrupt at earliest possible time to do so cleanly.
 	 */
 	std::atomic<bool> 	m_rungvt;
@@ -91,12 +107,60 @@ private:
          * Designate how many (possibly including idle) rounds any core can run.
          */
         std::size_t             m_turns;
-        
-        /// Add keyword inline, if we can't use __attribute(pure)__, 
-        /// inline + ifdef will convince compiler the function is empty, and throw it
-        // away if we're nog statlogging.
-        inline
-        void logStat(enum CTRLSTAT_TYPE);
+
+        /**
+         * Nr of OS threads the parallel cores are run on.
+         * Zero (default) or >= the nr of cores : one thread per core.
+         * Otherwise the cores are multiplexed over this many workers by a WorkStealingExecutor.
+         */
+        std::size_t             m_workers;
+
+        /**
+         * Decides which models move between cores in an optimistic simulation, nullptr if models stay put.
+         */
+        t_balancepolicyptr      m_balancePolicy;
+
+        /**
+         * Nr of GVT advances between two balance rounds.
+         */
+        std::size_t             m_balanceRounds;
+
+        /**
+         * True while the running simulation balances its cores.
+         */
+        bool                    m_balancing;
+
+        /**
+         * Nr of GVT advances (SharedGVT::getFound) from which the next balance round is due.
+         */
+        std::atomic<std::size_t> m_balanceDue;
+
+        /**
+         * Nr of completed balance rounds, and of cores waiting for the next one.
+         * Arriving and giving up are serialized by m_balanceLock, so a round never starts while a core
+         * that gave up is running a step.
+         */
+        std::atomic<std::size_t> m_balanced;
+        std::size_t             m_balanceArrived;
+        bool                    m_balanceAborted;
+        std::mutex              m_balanceLock;
+
+        /**
+         * Per core : the balance round it waits for (0 if none), and the time (ns) spent in steps since the last round.
+         * Only touched by the thread running the core, or by the last core to arrive while all others wait.
+         */
+        std::vector<std::size_t> m_balanceWaiting;
+        std::vector<std::size_t> m_busy;
+
+        /**
+         * Nr of models moved to another core.
+         */
+        std::size_t             m_migrated;
+
+        /**
+         * Add the counters of the last optimistic simulation's GVT to the statistics.
+         */
+        void logGVTStats();
 
 public:
 	Controller(std::string name, std::vector<t_coreptr>& cores,
@@ -117,6 +181,9 @@ public:
 
 	/**
 	 * @brief Main loop, starts simulation
+	 * Calling it again after the simulation stopped continues it, up to the new termination time.
+	 * The trace output continues as well, tracers take back the footer of the previous run.
+	 * @throw std::logic_error if a simulation other than classic or conservative is continued.
 	 */
 	void simulate();
         
@@ -137,21 +204,97 @@ public:
 	 */
 	void setTerminationCondition(t_terminationfunctor termination_condition);
 
+	/**
+	 * @brief Set the nr of worker threads that run the cores in a parallel simulation.
+	 * @param workers : 0 to run each core on its own thread.
+	 * @see WorkStealingExecutor
+	 */
+	void setWorkerThreads(std::size_t workers);
+
+	/**
+	 * @return the nr of worker threads, 0 if each core has its own thread.
+	 */
+	std::size_t getWorkerThreads() const;
+
+	/**
+	 * @brief Move models between cores during an optimistic simulation.
+	 * Every rounds GVT advances, all cores stop between two steps, the policy decides from what they measured
+	 * which models move, and the models move with their pending messages.
+	 * @param policy : nullptr (default) to keep each model on the core it was allocated to.
+	 * @note Only optimistic simulations balance. A conservative core promises its neighbours that it won't send
+	 * messages before its lookahead, which a model moving in could break.
+	 * @see Optimisticcore::migrateModel
+	 */
+	void setBalancePolicy(const t_balancepolicyptr& policy, std::size_t rounds = 8);
+
+	/**
+	 * @return the nr of models moved to another core by the balance policy.
+	 */
+	std::size_t getMigrations() const;
+
 	/**
 	 * Update the GVT interval with a new value.
 	 */
 	void setGVTInterval(std::size_t ms);
 
 	/**
-	 * Return the current GVT threading interval.
+	 * Return the configured GVT interval, the interval a simulation starts with.
 	 */
 	std::size_t
 	getGVTInterval();
 
 	/**
-	 * @brief Start thread for GVT
+	 * Enable or disable adapting the GVT interval during the simulation (default enabled).
+	 * @see n_model::adaptGVTInterval
+	 */
+	void setAdaptiveGVT(bool adaptive);
+
+	bool isAdaptiveGVT() const;
+
+	/**
+	 * Bound the nr of messages and states the optimistic cores keep for reverts (default 0, unbounded).
+	 * Over budget, the core furthest ahead of GVT rolls back and a GVT round starts right away.
+	 * @see n_model::Optimisticcore::cancelback
+	 */
+	void setHistoryBudget(std::size_t budget);
+
+	/**
+	 * @return the nr of rollbacks to keep the history within budget, 0 if no optimistic simulation ran.
+	 */
+	std::size_t getCancelbacks() const;
+
+	/**
+	 * @brief Write the state and times of all models to a binary snapshot, to resume from with loadSnapshot.
+	 * Call after simulate : the cores stopped at the same time and no message is in transit, in any simulation type.
+	 * @note Only the states are saved, members of a model outside its state are not.
+	 * @throw std::logic_error if a state can't be written, see ToBinary.
+	 * @see writeSnapshot
 	 */
-	void startGVTThread();
+	void saveSnapshot(std::ostream& out);
+	void saveSnapshot(const std::string& path);
+
+	/**
+	 * @brief Restore all models from a snapshot, they resume from the times it holds.
+	 * Call after adding the same models (by name) as the simulation that saved it, and before simulate.
+	 * @return the time the snapshot was taken, the termination time should lie beyond it.
+	 * @throw std::logic_error if the snapshot can't be read or does not match the models.
+	 * @see readSnapshot
+	 */
+	t_timestamp loadSnapshot(std::istream& in);
+	t_timestamp loadSnapshot(const std::string& path);
+
+	/**
+	 * @brief Fork the process, to continue the simulation in a branch that shares the memory of the models copy on write.
+	 * Call after simulate : the cores stopped at the same time and no message is in transit.
+	 * Both processes can then change models (parameters, states) and continue with simulate.
+	 * The child logs in the log file with suffix "." followed by its pid. File tracers continue in a copy of their
+	 * file with the same suffix, output on the console of both processes is interleaved.
+	 * @return the pid of the child in the parent, 0 in the child.
+	 * @attention Only the calling thread exists in the child, end it with _exit.
+	 * @throw std::logic_error if the simulation is not classic or conservative, or a core has a fork join pool.
+	 * @throw std::system_error if the process can't be forked.
+	 */
+	pid_t fork();
 
 	/**
 	 * @brief Adds a connection during Dynamic Structured DEVS
@@ -211,11 +354,57 @@ private:
         
         void simCPDEVS();
 
+	/**
+	 * @brief Run a single round on an optimistic core.
+	 * @return false if the core is done and should not be run again.
+	 */
+	bool stepOptimistic(std::size_t coreid);
+
+	/**
+	 * @brief Balance round barrier, called before each step of an optimistic core.
+	 * A core arrives once a round is due, and waits until all cores have arrived.
+	 * The last one to arrive runs the round with all other cores stopped.
+	 * @return true if the core waits and should not run a step now.
+	 */
+	bool waitBalance(std::size_t coreid);
+
+	/**
+	 * @brief Let the balance policy move models between the (stopped) cores.
+	 */
+	void balance();
+
+	/**
+	 * @brief Run a single round on a conservative core.
+	 * @return false if the core is done and should not be run again.
+	 */
+	bool stepConservative(std::size_t coreid);
+
+	/**
+	 * @return true if the cores have to be multiplexed over fewer worker threads.
+	 */
+	bool useExecutor() const;
+
+	/**
+	 * @brief Run all cores on m_workers threads with a WorkStealingExecutor.
+	 * @param optimistic : if true, runs the GVT thread alongside the workers.
+	 */
+	void runExecutor(bool optimistic);
+
 	/**
 	 * @brief Simulation setup and loop using Dynamic Structure DEVS
 	 */
 	void simDSDEVS();
 
+	/**
+	 * @return the models of all cores.
+	 */
+	std::vector<t_atomicmodelptr> getAtomics() const;
+
+	/**
+	 * @brief Let the cores continue a stopped simulation from the times of their models.
+	 */
+	void continueCores();
+
 	/**
 	 * @brief Removes models from all cores
 	 */
@@ -237,9 +426,6 @@ private:
 	 */
 	void distributeTerminationTime(t_timestamp);
 
-	friend
-	void runGVT(Controller&, std::atomic<bool>& rungvt);
-
 	friend
 	void cvworker( std::size_t myid, std::size_t turns,Controller&, std::atomic<int>& atint, std::mutex& mu, std::condition_variable& cv);
         
@@ -261,16 +447,23 @@ public:
 //#ifdef USE_STAT
 private:
 	n_tools::t_uintstat m_gvtStarted;
-	n_tools::t_uintstat m_gvtSecondRound;
-	n_tools::t_uintstat m_gvtFailed;
 	n_tools::t_uintstat m_gvtFound;
+	n_tools::t_uintstat m_gvtShorter;
+	n_tools::t_uintstat m_gvtLonger;
+	/// Sum of all intervals the GVT thread waited, divide by m_gvtStarted for the mean.
+	n_tools::t_uintstat m_gvtInterval;
+	n_tools::t_uintstat m_gvtCancelbacks;
+	n_tools::t_uintstat m_migrations;
 public:
 	void printStats(std::ostream& out = std::cout) const
 	{
 		out << m_gvtStarted
-			<< m_gvtSecondRound
 			<< m_gvtFound
-			<< m_gvtFailed;
+			<< m_gvtShorter
+			<< m_gvtLonger
+			<< m_gvtInterval
+			<< m_gvtCancelbacks
+			<< m_migrations;
                 
 		for(const auto& i:m_cores){
 			i->printStats(out);
@@ -280,14 +473,6 @@ public:
 //#endif
 };
 
-void beginGVT(Controller&, std::atomic<bool>& rungvt);
-
-/**
- * Find GVT using Mattern's algorithm.
- * @param rungvt : thread interrupt flag.
- */
-void runGVT(Controller&, std::atomic<bool>& rungvt);
-
 /**
  * Worker function. Runs a Core and communicates with other threads and GVT thread.
  * @param myid unique identifier, for logging it is best this is equal to coreid
@@ -17,7 +17,10 @@ using n_tools::SharedAtomic;
 namespace n_control {
 
 ControllerConfig::ControllerConfig()
-	: m_name("MySimulation"), m_simType(SimType::CLASSIC), m_coreAmount(1), m_saveInterval(5), m_tracerset(nullptr),m_turns(100000000)
+	: m_name("MySimulation"), m_simType(SimType::CLASSIC), m_coreAmount(1), m_saveInterval(5), m_tracerset(nullptr),m_turns(100000000), m_workerThreads(0), m_networkType(n_network::NetworkType::LOCKED), m_checkpointInterval(1), m_lazyCancellation(false), m_optimismWindow(0), m_adaptiveWindow(false), m_switchPolicy(nullptr),
+	  m_waitSpins(64), m_waitPauses(1024), m_waitPark(1000),
+	  m_balancePolicy(nullptr), m_balanceRounds(8), m_profile(nullptr),
+	  m_transitionThreads(0), m_transitionMinimum(128), m_slabReserve(0), m_historyBudget(0)
 {
 }
 
@@ -38,6 +41,8 @@ std::shared_ptr<Controller> ControllerConfig::createController()
 	else if(!isParallel(m_simType))
 		m_coreAmount = 1;
 
+	n_pools::setSlabReserve(m_slabReserve);
+
 	std::vector<t_coreptr> coreMap;
 
 	// If no custom allocator is given, use simple allocator
@@ -49,27 +54,58 @@ std::shared_ptr<Controller> ControllerConfig::createController()
 	// Create all cores
 	switch (m_simType) {
 	case SimType::CLASSIC:
-		coreMap.push_back(createObject<Core>());
+	{
+		auto core = createObject<Core>();
+		core->setProfile(m_profile);
+		if(m_transitionThreads > 1)
+			core->setForkJoinPool(createObject<n_tools::ForkJoinPool>(m_transitionThreads, m_transitionMinimum));
+		coreMap.push_back(core);
 		break;
+	}
 	case SimType::DYNAMIC:
 		coreMap.push_back(createObject<DynamicCore>());
 		break;
 	case SimType::OPTIMISTIC:
 	{
-		t_networkptr network = createObject<Network>(m_coreAmount);
+		t_networkptr network = n_network::createNetwork(m_networkType, m_coreAmount);
+		for (size_t i = 0; i < m_coreAmount; ++i) {
+			auto core = createObject<Optimisticcore>(network, i, m_coreAmount);
+			core->setCheckpointInterval(m_checkpointInterval);
+			core->setLazyCancellation(m_lazyCancellation);
+			core->setOptimismWindow(m_optimismWindow, m_adaptiveWindow);
+			coreMap.push_back(core);
+		}
+		break;
+	}
+	case SimType::HYBRID:
+	{
+		t_networkptr network = n_network::createNetwork(m_networkType, m_coreAmount);
+		t_lvtvector lvt = createObject<SharedAtomic<t_timestamp::t_time>>(m_coreAmount, 0u);
+		t_switchpolicyptr policy = m_switchPolicy? m_switchPolicy : createObject<ThresholdSwitchPolicy>();
 		for (size_t i = 0; i < m_coreAmount; ++i) {
-			coreMap.push_back(createObject<Optimisticcore>(network, i, m_coreAmount));
+			auto core = createObject<Hybridcore>(network, i, m_coreAmount, lvt, policy);
+			core->setCheckpointInterval(m_checkpointInterval);
+			core->setLazyCancellation(m_lazyCancellation);
+			core->setOptimismWindow(m_optimismWindow, m_adaptiveWindow);
+			coreMap.push_back(core);
 		}
 		break;
 	}
 	case SimType::CONSERVATIVE:
 	{
-		t_networkptr network = createObject<Network>(m_coreAmount);
+		t_networkptr network = n_network::createNetwork(m_networkType, m_coreAmount);
 		t_eotvector eotvector = createObject<SharedAtomic<t_timestamp::t_time>>(m_coreAmount, 0u);
                 t_timevector timevector = createObject<SharedAtomic<t_timestamp::t_time>>(m_coreAmount+1, std::numeric_limits<t_timestamp::t_time>::max());
                 timevector->set(timevector->size()-1, 0u);
+		const bool multiplexed = m_workerThreads != 0 && m_workerThreads < m_coreAmount;
+		n_tools::t_waitstrategyptr wait = createObject<n_tools::WaitStrategy>(m_waitSpins,
+		        multiplexed? n_tools::WaitStrategy::FOREVER : m_waitPauses, m_waitPark);
 		for (size_t i = 0; i < m_coreAmount; ++i) {
-			coreMap.push_back(createObject<Conservativecore>(network, i, m_coreAmount, eotvector, timevector));
+			auto core = createObject<Conservativecore>(network, i, m_coreAmount, eotvector, timevector);
+			core->setWaitStrategy(wait);
+			if(m_transitionThreads > 1)
+				core->setForkJoinPool(createObject<n_tools::ForkJoinPool>(m_transitionThreads, m_transitionMinimum));
+			coreMap.push_back(core);
 		}
 		break;
 	}
@@ -78,6 +114,12 @@ std::shared_ptr<Controller> ControllerConfig::createController()
 	auto ctrl = createObject<Controller>(m_name, coreMap, m_allocator, tracers, m_saveInterval, m_turns);
 
 	ctrl->setSimType(m_simType);
+	if(isParallel(m_simType))
+		ctrl->setWorkerThreads(m_workerThreads);
+	if(m_simType == SimType::OPTIMISTIC && m_balancePolicy)
+		ctrl->setBalancePolicy(m_balancePolicy, m_balanceRounds);
+	if(m_simType == SimType::OPTIMISTIC)
+		ctrl->setHistoryBudget(m_historyBudget);
 
 	return ctrl;
 }
@@ -20,6 +20,7 @@
 #include "model/optimisticcore.h"
 #include "model/dynamiccore.h"
 #include "model/conservativecore.h"
+#include "model/hybridcore.h"
 #include <unordered_set>
 #include <thread>
 #include <atomic>
@@ -86,6 +87,110 @@ struct ControllerConfig
          */
         std::size_t     m_turns;
 
+        /**
+         * The nr of OS threads used to run the cores of a parallel simulation.
+         * By default: @c 0, one thread per core.
+         * @attention: If less than m_coreAmount, the cores are run by a work stealing executor,
+         * allowing a model to be split in more partitions than there are hardware threads.
+         */
+        std::size_t     m_workerThreads;
+
+        /**
+         * The Network implementation used for parallel simulations.
+         * By default: @c NetworkType::LOCKED
+         * @see n_network::NetworkType, n_network::SPSCNetwork
+         */
+        n_network::NetworkType m_networkType;
+
+        /**
+         * The nr of transitions between state copies of a model in optimistic simulation,
+         * for the models that did not set their own interval.
+         * By default: @c 1, the state is copied before each transition.
+         * @c 0 (AtomicModel_impl::CHECKPOINT_ADAPTIVE) lets each model tune its interval to how often it is reverted.
+         * @see n_model::AtomicModel_impl::setCheckpointInterval
+         */
+        std::size_t m_checkpointInterval;
+
+        /**
+         * Use lazy cancellation in optimistic simulation.
+         * By default: @c false, a revert sends antimessages for all messages it undoes.
+         * @see n_model::Optimisticcore::setLazyCancellation
+         */
+        bool m_lazyCancellation;
+
+        /**
+         * Bound on how far an optimistic core can run ahead of GVT.
+         * By default: @c 0, unbounded.
+         * @see n_model::Optimisticcore::setOptimismWindow
+         */
+        n_network::t_timestamp::t_time m_optimismWindow;
+
+        /**
+         * Let each optimistic core adapt its window to how often it reverts.
+         * By default: @c false. Has no effect with an unbounded window.
+         */
+        bool m_adaptiveWindow;
+
+        /**
+         * Decides when the cores of a hybrid simulation switch protocol, shared by all cores.
+         * By default: @c nullptr, a n_model::ThresholdSwitchPolicy is used.
+         * @see n_model::Hybridcore
+         */
+        n_model::t_switchpolicyptr m_switchPolicy;
+
+        /**
+         * Backoff of stalled conservative cores : the nr of rounds that spin, the nr of rounds after that which pause,
+         * and the maximum time (us) a later round sleeps before it checks again.
+         * A core that publishes a new eot or null time wakes the sleeping cores.
+         * By default: @c 64, @c 1024, @c 1000.
+         * With fewer worker threads than cores, stalled cores never sleep, a sleeping worker can't run the other cores.
+         * @see n_tools::WaitStrategy
+         */
+        std::size_t m_waitSpins;
+        std::size_t m_waitPauses;
+        std::size_t m_waitPark;
+
+        /**
+         * Moves models between the cores of an optimistic simulation, every m_balanceRounds GVT advances.
+         * By default: @c nullptr, models stay on the core they are allocated to, and @c 8.
+         * @see Controller::setBalancePolicy
+         */
+        t_balancepolicyptr m_balancePolicy;
+        std::size_t m_balanceRounds;
+
+        /**
+         * Filled with the transitions and messages of each model during a classic simulation.
+         * By default: @c nullptr, nothing is recorded. Ignored by the other simulation types.
+         * @see Profiler
+         */
+        n_model::t_profileptr m_profile;
+
+        /**
+         * Nr of threads a classic simulation uses for the output and transitions of a single step,
+         * and the nr of models a step needs before it uses them.
+         * A conservative simulation gives each core this many threads, for its transitions only.
+         * By default: @c 0, the step runs on the simulation thread, and @c 128.
+         * Ignored by the other simulation types, their models keep old states.
+         * @see n_model::Core::setForkJoinPool
+         */
+        std::size_t m_transitionThreads;
+        std::size_t m_transitionMinimum;
+
+        /**
+         * Nr of 2MB slabs each simulation thread maps for its messages and states when it first allocates one.
+         * By default: @c 0, slabs are mapped as needed.
+         * @see n_pools::SizeClassHeap
+         */
+        std::size_t m_slabReserve;
+
+        /**
+         * Nr of messages and states the cores of an optimistic simulation may keep for reverts, summed over all cores.
+         * Over budget, the core furthest ahead of GVT rolls back halfway to GVT (cancelback) and a GVT round starts.
+         * By default: @c 0, unbounded. Ignored by the other simulation types.
+         * @see n_model::Optimisticcore::cancelback
+         */
+        std::size_t m_historyBudget;
+
 	ControllerConfig();
 	virtual ~ControllerConfig();
 
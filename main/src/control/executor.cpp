@@ -0,0 +1,127 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2015 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include "control/executor.h"
+#include "tools/globallog.h"
+#include <cassert>
+
+namespace n_control {
+
+WorkStealingExecutor::WorkStealingExecutor(std::size_t workers, std::size_t tasks, std::size_t quantum)
+	: m_workercount(workers), m_taskcount(tasks), m_quantum(quantum), m_rounds(tasks, 0),
+	  m_retired(workers), m_remaining(tasks), m_steals(0), m_arrived(0), m_exited(0)
+{
+	assert(workers > 0 && "Executor needs at least one worker.");
+	assert(quantum > 0 && "Executor quantum can't be zero.");
+	for (std::size_t i = 0; i < workers; ++i)
+		m_queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+	for (std::size_t i = 0; i < tasks; ++i)
+		m_queues[i % workers]->m_tasks.push_back(i);
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+	join();
+}
+
+void WorkStealingExecutor::start(const t_stepfunctor& step, const t_exitfunctor& atexit)
+{
+	assert(m_threads.empty() && "Executor started twice.");
+	m_step = step;
+	m_exit = atexit;
+	for (std::size_t i = 0; i < m_workercount; ++i) {
+		m_threads.push_back(std::thread(&WorkStealingExecutor::work, this, i));
+		LOG_INFO("EXECUTOR: Started worker # ", i);
+	}
+}
+
+void WorkStealingExecutor::join()
+{
+	for (auto& t : m_threads) {
+		if (t.joinable())
+			t.join();
+	}
+}
+
+bool WorkStealingExecutor::popLocal(std::size_t wid, std::size_t& task)
+{
+	WorkQueue& q = *m_queues[wid];
+	std::lock_guard<std::mutex> lock(q.m_lock);
+	if (q.m_tasks.empty())
+		return false;
+	task = q.m_tasks.front();
+	q.m_tasks.pop_front();
+	return true;
+}
+
+void WorkStealingExecutor::pushLocal(std::size_t wid, std::size_t task)
+{
+	WorkQueue& q = *m_queues[wid];
+	std::lock_guard<std::mutex> lock(q.m_lock);
+	q.m_tasks.push_back(task);
+}
+
+bool WorkStealingExecutor::steal(std::size_t wid, std::size_t& task)
+{
+	for (std::size_t i = 1; i < m_workercount; ++i) {
+		WorkQueue& q = *m_queues[(wid + i) % m_workercount];
+		std::unique_lock<std::mutex> lock(q.m_lock, std::try_to_lock);
+		if (!lock.owns_lock() || q.m_tasks.empty())
+			continue;
+		task = q.m_tasks.back();
+		q.m_tasks.pop_back();
+		++m_steals;
+		return true;
+	}
+	return false;
+}
+
+void WorkStealingExecutor::arriveAndWait(std::size_t& counter)
+{
+	std::unique_lock<std::mutex> lock(m_exitlock);
+	if (++counter == m_workercount) {
+		lock.unlock();
+		m_exitcv.notify_all();
+	} else {
+		m_exitcv.wait(lock, [this, &counter]{return counter == m_workercount;});
+	}
+}
+
+void WorkStealingExecutor::work(std::size_t wid)
+{
+	std::size_t task = 0;
+	while (m_remaining.load() > 0) {
+		if (!popLocal(wid, task) && !steal(wid, task)) {
+			// All remaining tasks are being run by other workers.
+			std::this_thread::yield();
+			continue;
+		}
+		bool live = true;
+		for (std::size_t q = 0; q < m_quantum && live; ++q) {
+			live = m_step(task, m_rounds[task]);
+			++m_rounds[task];
+		}
+		if (live) {
+			pushLocal(wid, task);
+		} else {
+			LOG_DEBUG("EXECUTOR: Worker ", wid, " retiring task ", task, " after ", m_rounds[task], " rounds.");
+			m_retired[wid].push_back(task);
+			--m_remaining;
+		}
+	}
+	arriveAndWait(m_arrived);
+	for (std::size_t id : m_retired[wid])
+		m_exit(id);
+	// Another worker can still be releasing memory that was allocated in our thread local pools.
+	arriveAndWait(m_exited);
+	LOG_DEBUG("EXECUTOR: Worker ", wid, " exiting, steals so far : ", m_steals.load());
+}
+
+} /* namespace n_control */
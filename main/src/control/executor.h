@@ -0,0 +1,149 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2015 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_CONTROL_EXECUTOR_H_
+#define SRC_CONTROL_EXECUTOR_H_
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+namespace n_control {
+
+/**
+ * @brief Runs a set of logical processes (Cores) on a (smaller) set of worker threads.
+ *
+ * Each worker owns a queue of task ids. A worker pops a task from the front of its own queue,
+ * runs it for a quantum of steps and, if the task is not finished, pushes it at the back again.
+ * A worker that has nothing left in its queue steals a task from the back of another worker's queue.
+ * A task that is being run is in no queue, so it is never run by two workers at the same time,
+ * but consecutive steps of a task can be run on different threads.
+ *
+ * @attention Memory allocated in a thread local pool by one worker can be released by another worker.
+ * This is safe for the multi core pools (boost/stl), which do not release memory before all workers have exited.
+ * The executor guarantees that all exit functors are run before any of its workers exits.
+ */
+class WorkStealingExecutor
+{
+public:
+	/**
+	 * Run a single step of a task.
+	 * @param id : the task id.
+	 * @param round : the nr of steps this task has already made.
+	 * @return false if the task is finished and should not be scheduled again.
+	 */
+	typedef std::function<bool(std::size_t id, std::size_t round)> t_stepfunctor;
+
+	/**
+	 * Called once for each task, after all tasks are finished, on one of the worker threads.
+	 */
+	typedef std::function<void(std::size_t id)> t_exitfunctor;
+
+private:
+	struct WorkQueue
+	{
+		std::mutex m_lock;
+		std::deque<std::size_t> m_tasks;
+	};
+
+	std::size_t m_workercount;
+	std::size_t m_taskcount;
+	std::size_t m_quantum;
+
+	std::vector<std::unique_ptr<WorkQueue>> m_queues;
+	/**
+	 * Per task step counter. Only written by the worker that currently holds the task,
+	 * the queue locks order the handoff between workers.
+	 */
+	std::vector<std::size_t> m_rounds;
+	/**
+	 * Per worker list of tasks it has retired, the same worker runs their exit functor.
+	 */
+	std::vector<std::vector<std::size_t>> m_retired;
+
+	std::atomic<std::size_t> m_remaining;
+	std::atomic<std::size_t> m_steals;
+
+	/**
+	 * Exit barriers, workers wait until all tasks are finished before running the exit functors,
+	 * and until all exit functors have run before leaving.
+	 */
+	std::mutex m_exitlock;
+	std::condition_variable m_exitcv;
+	std::size_t m_arrived;
+	std::size_t m_exited;
+
+	std::vector<std::thread> m_threads;
+
+	t_stepfunctor m_step;
+	t_exitfunctor m_exit;
+
+	bool popLocal(std::size_t wid, std::size_t& task);
+
+	bool steal(std::size_t wid, std::size_t& task);
+
+	void pushLocal(std::size_t wid, std::size_t task);
+
+	void arriveAndWait(std::size_t& counter);
+
+	void work(std::size_t wid);
+
+public:
+	/**
+	 * @param workers : nr of OS threads to use, at least 1.
+	 * @param tasks : nr of logical processes, task ids are [0, tasks).
+	 * @param quantum : nr of consecutive steps a worker runs a task before putting it back.
+	 * @pre workers > 0 && quantum > 0
+	 */
+	WorkStealingExecutor(std::size_t workers, std::size_t tasks, std::size_t quantum = 1);
+
+	WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+	WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+	~WorkStealingExecutor();
+
+	/**
+	 * Spawn the workers. Tasks are initially distributed round robin.
+	 * @pre start() has not been called before.
+	 */
+	void start(const t_stepfunctor& step, const t_exitfunctor& atexit);
+
+	/**
+	 * Wait until all tasks are finished and all workers have exited.
+	 */
+	void join();
+
+	std::size_t workers() const
+	{
+		return m_workercount;
+	}
+
+	std::size_t tasks() const
+	{
+		return m_taskcount;
+	}
+
+	/**
+	 * @return the nr of tasks a worker took from another worker's queue.
+	 */
+	std::size_t steals() const
+	{
+		return m_steals.load();
+	}
+};
+
+} /* namespace n_control */
+
+#endif /* SRC_CONTROL_EXECUTOR_H_ */
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include "control/fileallocator.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace n_control {
+
+FileAllocator::FileAllocator(const std::string& path)
+	: m_fileCores(0), m_hasSimType(false), m_fileSimType(SimType::CLASSIC), m_i(0)
+{
+	std::ifstream in(path);
+	if(!in.is_open())
+		throw std::logic_error("File not open : " + path);
+	read(in);
+}
+
+FileAllocator::FileAllocator(std::istream& in)
+	: m_fileCores(0), m_hasSimType(false), m_fileSimType(SimType::CLASSIC), m_i(0)
+{
+	read(in);
+}
+
+FileAllocator::~FileAllocator()
+{
+}
+
+void FileAllocator::read(std::istream& in)
+{
+	std::string line;
+	std::size_t maxCore = 0;
+	std::size_t nr = 0;
+	while(std::getline(in, line)){
+		++nr;
+		if(line.empty() || line[0] == '#')
+			continue;
+		std::istringstream fields(line);
+		if(line[0] == '@'){
+			std::string key;
+			std::string value;
+			fields >> key >> value;
+			if(key == "@simtype"){
+				m_fileSimType = parseSimType(value);
+				m_hasSimType = true;
+				continue;
+			}
+			if(key == "@cores"){
+				std::istringstream cores(value);
+				if(cores >> m_fileCores && m_fileCores > 0)
+					continue;
+			}
+			throw std::logic_error("Malformed core map line " + std::to_string(nr) + " : " + line);
+		}
+		std::size_t core = 0;
+		std::string name;
+		if(!(fields >> core) || !(fields >> std::ws) || !std::getline(fields, name) || name.empty())
+			throw std::logic_error("Malformed core map line " + std::to_string(nr) + " : " + line);
+		m_cores[name] = core;
+		maxCore = std::max(maxCore, core);
+	}
+	if(m_fileCores == 0 && !m_cores.empty())
+		m_fileCores = maxCore + 1;
+	setCoreAmount(m_fileCores ? m_fileCores : 1);
+	if(m_hasSimType)
+		setSimType(m_fileSimType);
+}
+
+SimType FileAllocator::parseSimType(const std::string& name)
+{
+	for(SimType s : {SimType::CLASSIC, SimType::OPTIMISTIC, SimType::CONSERVATIVE, SimType::DYNAMIC, SimType::HYBRID})
+		if(name == simTypeName(s))
+			return s;
+	throw std::logic_error("Unknown simulation type : " + name);
+}
+
+size_t FileAllocator::allocate(const n_model::t_atomicmodelptr& model)
+{
+	std::size_t corenr;
+	const auto it = m_cores.find(model->getName());
+	if(it != m_cores.end()){
+		corenr = it->second % coreAmount();
+	}else{
+		LOG_WARNING("FileAllocator : ", model->getName(), " is not in the core map, placed round robin.");
+		corenr = m_i;
+		m_i = (m_i + 1) % coreAmount();
+	}
+	assignCore(model, corenr);
+	return corenr;
+}
+
+void FileAllocator::allocateAll(const std::vector<n_model::t_atomicmodelptr>& models)
+{
+	LOG_INFO("FileAllocator processing ", models.size(), " atomics over ", coreAmount(), " cores");
+	for(const auto& model : models){
+		allocate(model);
+		LOG_DEBUG("FileAllocator assigned ", model->getName(), " to ", model->getCorenumber());
+	}
+}
+
+} /* namespace n_control */
@@ -0,0 +1,91 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_CONTROL_FILEALLOCATOR_H_
+#define SRC_CONTROL_FILEALLOCATOR_H_
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include "control/allocator.h"
+
+namespace n_control {
+
+/**
+ * @brief Allocator that places each model on the core a core map file names.
+ *
+ * The file is written by Profiler::writeCoreMap : lines starting with '#' are comments,
+ * "@simtype <name>" and "@cores <n>" give the recommended setup, any other line is "<core> <model name>".
+ * The core amount is taken from the file, setCoreAmount overrides it, a core outside the range wraps.
+ * Models that are not in the file are placed round robin.
+ */
+class FileAllocator: public Allocator
+{
+private:
+	std::unordered_map<std::string, std::size_t> m_cores;
+	std::size_t m_fileCores;
+	bool m_hasSimType;
+	SimType m_fileSimType;
+	std::size_t m_i;
+
+	void read(std::istream& in);
+
+public:
+	/**
+	 * @throw std::logic_error if the file can't be opened or has a malformed line.
+	 */
+	FileAllocator(const std::string& path);
+
+	/**
+	 * @throw std::logic_error if the stream has a malformed line.
+	 */
+	FileAllocator(std::istream& in);
+
+	virtual ~FileAllocator();
+
+	size_t allocate(const n_model::t_atomicmodelptr& model) override;
+
+	void allocateAll(const std::vector<n_model::t_atomicmodelptr>& models) override;
+
+	/**
+	 * @return the core amount the file recommends, 0 if it has none.
+	 */
+	std::size_t getFileCores() const
+	{
+		return m_fileCores;
+	}
+
+	/**
+	 * @return true if the file recommends a simulation type.
+	 */
+	bool hasFileSimType() const
+	{
+		return m_hasSimType;
+	}
+
+	/**
+	 * @return the simulation type the file recommends.
+	 * @pre hasFileSimType()
+	 */
+	SimType getFileSimType() const
+	{
+		return m_fileSimType;
+	}
+
+	/**
+	 * @return the simulation type named name.
+	 * @throw std::logic_error if name is not one of the names of simTypeName.
+	 */
+	static SimType parseSimType(const std::string& name);
+};
+
+} /* namespace n_control */
+
+#endif /* SRC_CONTROL_FILEALLOCATOR_H_ */
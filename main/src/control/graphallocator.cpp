@@ -0,0 +1,362 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include "control/graphallocator.h"
+#include "model/port.h"
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <deque>
+#include <random>
+#include <limits>
+#include <cmath>
+
+namespace n_control {
+
+namespace {
+
+constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+/// Coarsening stops when a graph has at most this many vertices per part.
+constexpr std::size_t COARSE_PER_PART = 16;
+
+/// Nr of refinement passes over all vertices at each level.
+constexpr std::size_t REFINE_PASSES = 8;
+
+/**
+ * Contract a maximal matching that prefers heavy edges.
+ * Vertices are only matched if they have the same fixed part and their joint weight is at most maxweight.
+ * @param map : set to the coarse vertex of each vertex.
+ */
+AllocGraph coarsen(const AllocGraph& g, std::size_t maxweight, std::mt19937& rng, std::vector<std::size_t>& map)
+{
+	const std::size_t n = g.size();
+	std::vector<std::size_t> match(n, NONE);
+	std::vector<std::size_t> order(n);
+	std::iota(order.begin(), order.end(), 0);
+	std::shuffle(order.begin(), order.end(), rng);
+	for(std::size_t v : order){
+		if(match[v] != NONE)
+			continue;
+		std::size_t best = v;
+		std::size_t bestweight = 0;
+		for(const auto& e : g.m_edges[v]){
+			const std::size_t u = e.first;
+			if(match[u] != NONE || g.m_fixed[u] != g.m_fixed[v] || g.m_weights[u] + g.m_weights[v] > maxweight)
+				continue;
+			if(e.second > bestweight){
+				best = u;
+				bestweight = e.second;
+			}
+		}
+		match[v] = best;
+		match[best] = v;
+	}
+
+	AllocGraph coarse;
+	map.assign(n, NONE);
+	for(std::size_t v = 0; v < n; ++v){
+		if(map[v] != NONE)
+			continue;
+		map[v] = map[match[v]] = coarse.size();
+		coarse.m_weights.push_back(g.m_weights[v] + (match[v] == v ? 0 : g.m_weights[match[v]]));
+		coarse.m_fixed.push_back(g.m_fixed[v]);
+	}
+
+	// Merge the edges of each matched pair, pos holds the index of a neighbour in the current edge list.
+	coarse.m_edges.resize(coarse.size());
+	std::vector<std::size_t> pos(coarse.size(), NONE);
+	for(std::size_t v = 0; v < n; ++v){
+		if(match[v] < v)
+			continue;
+		const std::size_t c = map[v];
+		auto& edges = coarse.m_edges[c];
+		for(std::size_t fine : {v, match[v]}){
+			for(const auto& e : g.m_edges[fine]){
+				const std::size_t cu = map[e.first];
+				if(cu == c)
+					continue;
+				if(pos[cu] == NONE){
+					pos[cu] = edges.size();
+					edges.push_back(AllocGraph::t_edge(cu, e.second));
+				}else{
+					edges[pos[cu]].second += e.second;
+				}
+			}
+			if(match[v] == v)
+				break;
+		}
+		for(const auto& e : edges)
+			pos[e.first] = NONE;
+	}
+	return coarse;
+}
+
+/**
+ * Initial partition : grow one region per part from a seed, adding the free vertex most connected to the region,
+ * until the region has its share of the weight. The last part takes the rest.
+ */
+std::vector<std::size_t> growRegions(const AllocGraph& g, std::size_t k)
+{
+	const std::size_t n = g.size();
+	std::vector<std::size_t> parts(n, NONE);
+	std::vector<std::size_t> loads(k, 0);
+	for(std::size_t v = 0; v < n; ++v){
+		if(g.m_fixed[v] >= 0){
+			parts[v] = g.m_fixed[v];
+			loads[parts[v]] += g.m_weights[v];
+		}
+	}
+	const std::size_t target = (g.totalWeight() + k - 1) / k;
+	std::vector<std::size_t> conn(n, 0);
+	std::size_t seed = 0;
+	for(std::size_t p = 0; p + 1 < k; ++p){
+		std::priority_queue<std::pair<std::size_t, std::size_t>> frontier;
+		auto add = [&](std::size_t v){
+			for(const auto& e : g.m_edges[v]){
+				if(parts[e.first] != NONE)
+					continue;
+				conn[e.first] += e.second;
+				frontier.push(std::make_pair(conn[e.first], e.first));
+			}
+		};
+		for(std::size_t v = 0; v < n; ++v){
+			if(parts[v] == p)
+				add(v);
+		}
+		while(loads[p] < target){
+			std::size_t v = NONE;
+			while(!frontier.empty()){
+				const auto top = frontier.top();
+				frontier.pop();
+				if(parts[top.second] == NONE && conn[top.second] == top.first){
+					v = top.second;
+					break;
+				}
+			}
+			if(v == NONE){
+				while(seed < n && parts[seed] != NONE)
+					++seed;
+				if(seed == n)
+					break;
+				v = seed;
+			}
+			parts[v] = p;
+			loads[p] += g.m_weights[v];
+			add(v);
+		}
+		std::fill(conn.begin(), conn.end(), 0);
+	}
+	for(auto& part : parts){
+		if(part == NONE)
+			part = k - 1;
+	}
+	return parts;
+}
+
+/**
+ * Greedy k-way refinement : move each free vertex to the part it has the most edge weight to, if that does not
+ * push the part over maxload. Moves that don't change the cut are made if they improve the balance.
+ * A vertex in a part over maxload is moved regardless of the cut.
+ */
+void refine(const AllocGraph& g, std::vector<std::size_t>& parts, std::size_t k, std::size_t maxload)
+{
+	std::vector<std::size_t> loads(k, 0);
+	for(std::size_t v = 0; v < g.size(); ++v)
+		loads[parts[v]] += g.m_weights[v];
+
+	std::vector<std::size_t> conn(k, 0);
+	std::vector<std::size_t> touched;
+	for(std::size_t pass = 0; pass < REFINE_PASSES; ++pass){
+		std::size_t moved = 0;
+		for(std::size_t v = 0; v < g.size(); ++v){
+			if(g.m_fixed[v] >= 0)
+				continue;
+			const std::size_t from = parts[v];
+			const std::size_t w = g.m_weights[v];
+			touched.clear();
+			for(const auto& e : g.m_edges[v]){
+				const std::size_t q = parts[e.first];
+				if(conn[q] == 0)
+					touched.push_back(q);
+				conn[q] += e.second;
+			}
+			const std::size_t lightest = std::min_element(loads.begin(), loads.end()) - loads.begin();
+			if(conn[lightest] == 0)
+				touched.push_back(lightest);
+
+			const long long internal = conn[from];
+			std::size_t best = NONE;
+			long long bestgain = 0;
+			for(std::size_t q : touched){
+				if(q == from || loads[q] + w > maxload)
+					continue;
+				const long long gain = (long long)conn[q] - internal;
+				if(best == NONE || gain > bestgain || (gain == bestgain && loads[q] < loads[best])){
+					best = q;
+					bestgain = gain;
+				}
+			}
+			for(std::size_t q : touched)
+				conn[q] = 0;
+			conn[from] = 0;
+
+			if(best == NONE)
+				continue;
+			if(bestgain > 0 || (bestgain == 0 && loads[best] + w < loads[from]) || loads[from] > maxload){
+				parts[v] = best;
+				loads[from] -= w;
+				loads[best] += w;
+				++moved;
+			}
+		}
+		if(moved == 0)
+			break;
+	}
+}
+
+} /* namespace */
+
+std::size_t AllocGraph::totalWeight() const
+{
+	return std::accumulate(m_weights.begin(), m_weights.end(), std::size_t(0));
+}
+
+std::size_t AllocGraph::cut(const std::vector<std::size_t>& parts) const
+{
+	std::size_t total = 0;
+	for(std::size_t v = 0; v < size(); ++v){
+		for(const auto& e : m_edges[v]){
+			if(parts[v] != parts[e.first])
+				total += e.second;
+		}
+	}
+	return total / 2;
+}
+
+std::vector<std::size_t> GraphAllocator::partition(const AllocGraph& graph, std::size_t parts, double imbalance)
+{
+	assert(parts > 0 && "Can't partition in zero parts.");
+	if(parts == 1 || graph.size() == 0)
+		return std::vector<std::size_t>(graph.size(), 0);
+
+	const std::size_t total = graph.totalWeight();
+	const std::size_t heaviest = *std::max_element(graph.m_weights.begin(), graph.m_weights.end());
+	const std::size_t average = (total + parts - 1) / parts;
+	const std::size_t maxload = std::max<std::size_t>(std::ceil(imbalance * total / parts), average + heaviest);
+	// Coarse vertices much heavier than this can't be balanced.
+	const std::size_t maxweight = std::max(heaviest, (3 * total) / (2 * COARSE_PER_PART * parts));
+
+	// Fixed seed, the same model gives the same allocation.
+	std::mt19937 rng(42);
+	std::deque<AllocGraph> levels;
+	std::deque<std::vector<std::size_t>> maps;
+	const AllocGraph* current = &graph;
+	while(current->size() > COARSE_PER_PART * parts){
+		std::vector<std::size_t> map;
+		levels.push_back(coarsen(*current, maxweight, rng, map));
+		maps.push_back(std::move(map));
+		const std::size_t before = current->size();
+		current = &levels.back();
+		// Stop if matching no longer pays, e.g. a star or a graph without edges.
+		if(current->size() * 10 > before * 9)
+			break;
+	}
+
+	std::vector<std::size_t> result = growRegions(*current, parts);
+	refine(*current, result, parts, maxload);
+	while(!levels.empty()){
+		const std::vector<std::size_t>& map = maps.back();
+		std::vector<std::size_t> finer(map.size());
+		for(std::size_t v = 0; v < map.size(); ++v)
+			finer[v] = result[map[v]];
+		result.swap(finer);
+		levels.pop_back();
+		maps.pop_back();
+		refine(levels.empty() ? graph : levels.back(), result, parts, maxload);
+	}
+	return result;
+}
+
+GraphAllocator::GraphAllocator(std::size_t cores, bool allowOverride, const t_weightfunc& weight, double imbalance)
+	: m_allowUserOverride(allowOverride), m_weight(weight), m_imbalance(imbalance), m_cut(0), m_i(0)
+{
+	setCoreAmount(cores);
+}
+
+GraphAllocator::~GraphAllocator()
+{
+}
+
+size_t GraphAllocator::allocate(const n_model::t_atomicmodelptr& model)
+{
+	int corenr = model->getCorenumber();
+	if(!m_allowUserOverride || corenr == -1){
+		corenr = m_i;
+		m_i = (m_i + 1) % coreAmount();
+	}else{
+		corenr %= coreAmount();
+	}
+	assignCore(model, corenr);
+	return corenr;
+}
+
+AllocGraph GraphAllocator::buildGraph(const std::vector<n_model::t_atomicmodelptr>& models) const
+{
+	const std::size_t n = models.size();
+	std::unordered_map<const n_model::Model*, std::size_t> index;
+	index.reserve(n);
+	for(std::size_t i = 0; i < n; ++i)
+		index[models[i].get()] = i;
+
+	AllocGraph graph;
+	graph.m_weights.resize(n);
+	graph.m_fixed.resize(n);
+	graph.m_edges.resize(n);
+	std::vector<std::unordered_map<std::size_t, std::size_t>> adjacent(n);
+	for(std::size_t i = 0; i < n; ++i){
+		const n_model::t_atomicmodelptr& model = models[i];
+		graph.m_weights[i] = m_weight ? std::max<std::size_t>(m_weight(model), 1) : 1;
+		const int corenr = model->getCorenumber();
+		graph.m_fixed[i] = (m_allowUserOverride && corenr != -1) ? int(corenr % coreAmount()) : -1;
+		for(const n_model::t_portptr& port : model->getOPorts()){
+			const n_model::Port& out = *port;
+			const auto& connections = out.isUsingDirectConnect() ? out.getCoupledOuts() : out.getOuts();
+			for(const n_model::t_outconnect& connection : connections){
+				const auto found = index.find(connection.first->getHost());
+				if(found == index.end() || found->second == i)
+					continue;
+				++adjacent[i][found->second];
+				++adjacent[found->second][i];
+			}
+		}
+	}
+	for(std::size_t i = 0; i < n; ++i){
+		graph.m_edges[i].assign(adjacent[i].begin(), adjacent[i].end());
+		std::sort(graph.m_edges[i].begin(), graph.m_edges[i].end());
+	}
+	return graph;
+}
+
+void GraphAllocator::allocateAll(const std::vector<n_model::t_atomicmodelptr>& models)
+{
+	LOG_INFO("GraphAllocator processing ", models.size(), " atomics over ", coreAmount(), " cores");
+	const AllocGraph graph = buildGraph(models);
+	const std::vector<std::size_t> parts = partition(graph, coreAmount(), m_imbalance);
+	for(std::size_t i = 0; i < models.size(); ++i){
+		assignCore(models[i], parts[i]);
+		LOG_DEBUG("GraphAllocator assigned ", models[i]->getName(), " to ", parts[i]);
+	}
+	m_cut = graph.cut(parts);
+	LOG_INFO("GraphAllocator : ", m_cut, " connections between cores.");
+}
+
+} /* namespace n_control */
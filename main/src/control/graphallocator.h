@@ -0,0 +1,118 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_CONTROL_GRAPHALLOCATOR_H_
+#define SRC_CONTROL_GRAPHALLOCATOR_H_
+
+#include <functional>
+#include "control/allocator.h"
+
+namespace n_control {
+
+/**
+ * @brief Undirected graph with weighted vertices and edges.
+ */
+struct AllocGraph
+{
+	/// (neighbour, edge weight)
+	typedef std::pair<std::size_t, std::size_t> t_edge;
+
+	/// Weight of each vertex.
+	std::vector<std::size_t> m_weights;
+	/// Part a vertex has to be placed in, -1 if free.
+	std::vector<int> m_fixed;
+	/// Neighbours of each vertex, each neighbour once, no self loops.
+	std::vector<std::vector<t_edge>> m_edges;
+
+	std::size_t size() const
+	{
+		return m_weights.size();
+	}
+
+	/**
+	 * @return the sum of the vertex weights.
+	 */
+	std::size_t totalWeight() const;
+
+	/**
+	 * @return the sum of the weights of the edges between parts.
+	 */
+	std::size_t cut(const std::vector<std::size_t>& parts) const;
+};
+
+/**
+ * @brief Allocator that keeps connected models on the same core.
+ *
+ * The models and their port connections (after direct connect) form a graph, with an edge weight
+ * equal to the nr of connections between two models. This graph is split in one part per core
+ * by a multilevel k-way partitioner : the graph is coarsened by contracting heavy edges, the
+ * coarsest graph is split by growing one region per part, and the split is projected back and
+ * refined at each level by moving boundary models to the part they are most connected to.
+ * The result has few connections between cores, so few messages cross cores, while the total
+ * model weight of each core stays within the imbalance bound.
+ * @note Models without connections are spread to balance the load.
+ */
+class GraphAllocator: public Allocator
+{
+public:
+	/// @return the weight of a model, e.g. its expected share of the transitions.
+	typedef std::function<std::size_t(const n_model::t_atomicmodelptr&)> t_weightfunc;
+
+private:
+	bool m_allowUserOverride;
+	t_weightfunc m_weight;
+	double m_imbalance;
+	std::size_t m_cut;
+	std::size_t m_i;
+
+public:
+	/**
+	 * @param cores : nr of simulation cores.
+	 * @param allowOverride : if true, a model that set its core number stays on that core.
+	 * @param weight : weight of a model, nullptr gives all models weight 1.
+	 * @param imbalance : the heaviest core may have this factor more than the average weight.
+	 */
+	GraphAllocator(std::size_t cores, bool allowOverride = true, const t_weightfunc& weight = nullptr,
+	        double imbalance = 1.03);
+
+	virtual ~GraphAllocator();
+
+	/**
+	 * @brief A single model can't be partitioned, it is placed round robin.
+	 */
+	size_t allocate(const n_model::t_atomicmodelptr& model) override;
+
+	void allocateAll(const std::vector<n_model::t_atomicmodelptr>& models) override;
+
+	/**
+	 * @return the graph of the models and their connections, vertex i is models[i].
+	 */
+	AllocGraph buildGraph(const std::vector<n_model::t_atomicmodelptr>& models) const;
+
+	/**
+	 * @return the nr of connections between cores of the last allocation.
+	 */
+	std::size_t getCut() const
+	{
+		return m_cut;
+	}
+
+	/**
+	 * Split graph in parts with minimal cut.
+	 * @pre parts > 0, the fixed vertices are placed in parts < parts.
+	 * @return the part of each vertex.
+	 */
+	static std::vector<std::size_t>
+	partition(const AllocGraph& graph, std::size_t parts, double imbalance = 1.03);
+};
+
+} /* namespace n_control */
+
+#endif /* SRC_CONTROL_GRAPHALLOCATOR_H_ */
@@ -0,0 +1,175 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include "control/profiler.h"
+#include "tools/objectfactory.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace n_control {
+
+namespace {
+
+void printHistogram(const std::vector<std::size_t>& histogram, std::ostream& out)
+{
+	for(std::size_t b = 0; b < histogram.size(); ++b){
+		if(histogram[b] == 0)
+			continue;
+		if(b == 0)
+			out << "\t0\t";
+		else if(b == 1)
+			out << "\t(0, 2)\t";
+		else
+			out << "\t[" << (std::size_t(1) << (b - 1)) << ", " << (std::size_t(1) << b) << ")\t";
+		out << histogram[b] << '\n';
+	}
+}
+
+} /* namespace */
+
+Profiler::Profiler(std::size_t maxCores, double remoteCost)
+	: m_profile(n_tools::createObject<n_model::Profile>()), m_maxCores(std::max<std::size_t>(maxCores, 1)),
+	  m_remoteCost(remoteCost)
+{
+}
+
+AllocGraph Profiler::buildGraph() const
+{
+	const auto& models = m_profile->getModels();
+	const std::size_t n = models.size();
+	AllocGraph graph;
+	graph.m_weights.resize(n);
+	graph.m_fixed.assign(n, -1);
+	graph.m_edges.resize(n);
+	std::vector<std::unordered_map<std::size_t, std::size_t>> adjacent(n);
+	for(std::size_t i = 0; i < n; ++i)
+		graph.m_weights[i] = models[i].m_transitions;
+	for(const auto& link : m_profile->getLinks()){
+		const std::size_t src = link.first.m_srcModel;
+		const std::size_t dst = link.first.m_dstModel;
+		if(src == dst)
+			continue;
+		adjacent[src][dst] += link.second;
+		adjacent[dst][src] += link.second;
+	}
+	for(std::size_t i = 0; i < n; ++i){
+		graph.m_edges[i].assign(adjacent[i].begin(), adjacent[i].end());
+		std::sort(graph.m_edges[i].begin(), graph.m_edges[i].end());
+	}
+	return graph;
+}
+
+double Profiler::estimate(const AllocGraph& graph, const std::vector<std::size_t>& parts, std::size_t cores) const
+{
+	std::vector<std::size_t> loads(cores, 0);
+	for(std::size_t v = 0; v < graph.size(); ++v)
+		loads[parts[v]] += graph.m_weights[v];
+	const std::size_t heaviest = *std::max_element(loads.begin(), loads.end());
+	// A message between cores costs its sender and its receiver.
+	return double(heaviest) + m_remoteCost * 2.0 * double(graph.cut(parts)) / double(cores);
+}
+
+SimType Profiler::chooseSimType(const AllocGraph& graph, const std::vector<std::size_t>& parts) const
+{
+	const auto& models = m_profile->getModels();
+	std::size_t transitions = 0;
+	std::size_t zero = 0;
+	std::size_t finiteLookahead = 0;
+	double lookahead = 0.0;
+	std::size_t finiteAdvance = 0;
+	double advance = 0.0;
+	for(std::size_t v = 0; v < graph.size(); ++v){
+		const bool boundary = std::any_of(graph.m_edges[v].begin(), graph.m_edges[v].end(),
+		        [&](const AllocGraph::t_edge& e){return parts[e.first] != parts[v];});
+		if(!boundary)
+			continue;
+		const n_model::Profile::ModelProfile& model = models[v];
+		transitions += model.m_transitions;
+		zero += model.m_zeroLookahead;
+		finiteLookahead += model.m_transitions - model.m_infiniteLookahead;
+		lookahead += model.m_lookahead;
+		finiteAdvance += model.m_finite;
+		advance += model.m_timeAdvance;
+	}
+	if(transitions == 0)
+		return SimType::CONSERVATIVE;
+	if(double(zero) > PROFILE_MAX_ZERO_LOOKAHEAD * double(transitions))
+		return SimType::OPTIMISTIC;
+	if(finiteLookahead == 0 || finiteAdvance == 0)
+		return SimType::CONSERVATIVE;
+	const double meanLookahead = lookahead / double(finiteLookahead);
+	const double meanAdvance = advance / double(finiteAdvance);
+	return meanLookahead >= PROFILE_LOOKAHEAD_RATIO * meanAdvance ? SimType::CONSERVATIVE : SimType::OPTIMISTIC;
+}
+
+Profiler::Recommendation Profiler::recommend() const
+{
+	Recommendation rec;
+	const AllocGraph graph = buildGraph();
+	rec.m_coreMap.assign(graph.size(), 0);
+	const std::size_t total = graph.totalWeight();
+	const std::size_t maxCores = std::min(m_maxCores, graph.size());
+	if(total == 0 || maxCores < 2)
+		return rec;
+
+	std::vector<std::vector<std::size_t>> candidates(maxCores + 1);
+	std::vector<double> speedups(maxCores + 1, 1.0);
+	double best = 1.0;
+	for(std::size_t cores = 2; cores <= maxCores; ++cores){
+		candidates[cores] = GraphAllocator::partition(graph, cores);
+		speedups[cores] = double(total) / estimate(graph, candidates[cores], cores);
+		best = std::max(best, speedups[cores]);
+		LOG_INFO("Profiler : ", cores, " cores, estimated speedup ", speedups[cores]);
+	}
+	if(best < PROFILE_MIN_SPEEDUP)
+		return rec;
+	std::size_t cores = 2;
+	while(speedups[cores] < PROFILE_CORE_TOLERANCE * best)
+		++cores;
+	rec.m_cores = cores;
+	rec.m_coreMap = candidates[cores];
+	rec.m_speedup = speedups[cores];
+	rec.m_cut = graph.cut(rec.m_coreMap);
+	rec.m_simType = chooseSimType(graph, rec.m_coreMap);
+	return rec;
+}
+
+void Profiler::printReport(const Recommendation& rec, std::ostream& out) const
+{
+	const auto& models = m_profile->getModels();
+	std::size_t messages = 0;
+	for(const auto& link : m_profile->getLinks())
+		messages += link.second;
+	out << "Profile of " << models.size() << " models : " << m_profile->getTransitions() << " transitions, "
+	        << messages << " messages over " << m_profile->getLinks().size() << " port links.\n";
+	out << "Time advance (transitions per range) :\n";
+	printHistogram(m_profile->getTimeAdvances(), out);
+	out << "Lookahead (transitions per range) :\n";
+	printHistogram(m_profile->getLookaheads(), out);
+	out << "Model\ttransitions\tsent\tcore\n";
+	for(std::size_t i = 0; i < models.size(); ++i){
+		out << models[i].m_name << '\t' << models[i].m_transitions << '\t' << models[i].m_sent << '\t'
+		        << rec.m_coreMap[i] << '\n';
+	}
+	out << "Recommended : " << simTypeName(rec.m_simType) << " on " << rec.m_cores << " cores, "
+	        << rec.m_cut << " messages between cores, estimated speedup " << rec.m_speedup << ".\n";
+}
+
+void Profiler::writeCoreMap(const Recommendation& rec, std::ostream& out) const
+{
+	const auto& models = m_profile->getModels();
+	out << "# Core map measured by a pilot run, estimated speedup " << rec.m_speedup << ".\n";
+	out << "@simtype " << simTypeName(rec.m_simType) << '\n';
+	out << "@cores " << rec.m_cores << '\n';
+	for(std::size_t i = 0; i < models.size(); ++i)
+		out << rec.m_coreMap[i] << ' ' << models[i].m_name << '\n';
+}
+
+} /* namespace n_control */
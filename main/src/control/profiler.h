@@ -0,0 +1,121 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_CONTROL_PROFILER_H_
+#define SRC_CONTROL_PROFILER_H_
+
+#include <iostream>
+#include "model/profile.h"
+#include "control/graphallocator.h"
+#include "control/simtype.h"
+
+namespace n_control {
+
+/**
+ * A parallel setup must be estimated this much faster than classic to be recommended.
+ */
+constexpr double PROFILE_MIN_SPEEDUP = 1.25;
+
+/**
+ * The fewest cores within this fraction of the best estimated speedup are recommended.
+ */
+constexpr double PROFILE_CORE_TOLERANCE = 0.9;
+
+/**
+ * Conservative is only recommended if at most this fraction of the transitions of models that
+ * send to other cores left a zero lookahead.
+ */
+constexpr double PROFILE_MAX_ZERO_LOOKAHEAD = 0.01;
+
+/**
+ * Conservative is only recommended if the mean lookahead of models that send to other cores is at least
+ * this fraction of their mean time advance, else the cores wait on each other too often.
+ */
+constexpr double PROFILE_LOOKAHEAD_RATIO = 0.5;
+
+/**
+ * @brief Recommends a simulation type, core count and allocation from a pilot run.
+ *
+ * Pass getProfile() to ControllerConfig::m_profile, run a short classic simulation, then call recommend.
+ * The transitions of a model are its load and the messages between two models the cost of splitting them :
+ * for each core count the models are partitioned as by GraphAllocator, and the estimated time of a core
+ * is the load of the heaviest core plus its share of the messages between cores.
+ * Conservative is chosen over optimistic if the models that send to other cores have a useful lookahead.
+ * writeCoreMap saves the result for a FileAllocator.
+ */
+class Profiler
+{
+public:
+	struct Recommendation
+	{
+		SimType m_simType;
+		std::size_t m_cores;
+		/// Core of each model, in the order of the profile.
+		std::vector<std::size_t> m_coreMap;
+		/// Estimated speedup over classic.
+		double m_speedup;
+		/// Nr of messages between cores with this map.
+		std::size_t m_cut;
+
+		Recommendation()
+			: m_simType(SimType::CLASSIC), m_cores(1), m_speedup(1.0), m_cut(0)
+		{
+		}
+	};
+
+private:
+	n_model::t_profileptr m_profile;
+	std::size_t m_maxCores;
+	double m_remoteCost;
+
+	/**
+	 * @return the estimated time of the slowest core, in transitions.
+	 */
+	double estimate(const AllocGraph& graph, const std::vector<std::size_t>& parts, std::size_t cores) const;
+
+	SimType chooseSimType(const AllocGraph& graph, const std::vector<std::size_t>& parts) const;
+
+public:
+	/**
+	 * @param maxCores : the most cores to recommend, e.g. the nr of hardware threads.
+	 * @param remoteCost : cost of a message between cores, relative to a transition.
+	 */
+	Profiler(std::size_t maxCores, double remoteCost = 1.0);
+
+	/**
+	 * @return the profile to fill with the pilot run.
+	 */
+	const n_model::t_profileptr& getProfile() const
+	{
+		return m_profile;
+	}
+
+	/**
+	 * @return the measured graph : vertex i is model i of the profile, weighted with its transitions,
+	 * edges are weighted with the nr of messages between their models.
+	 */
+	AllocGraph buildGraph() const;
+
+	Recommendation recommend() const;
+
+	/**
+	 * Print the measurements and the recommendation.
+	 */
+	void printReport(const Recommendation& rec, std::ostream& out = std::cout) const;
+
+	/**
+	 * Write the recommendation in the format FileAllocator reads.
+	 */
+	void writeCoreMap(const Recommendation& rec, std::ostream& out) const;
+};
+
+} /* namespace n_control */
+
+#endif /* SRC_CONTROL_PROFILER_H_ */
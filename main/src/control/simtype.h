@@ -21,17 +21,36 @@ enum SimType{
 	CLASSIC = 1,		///non-parallel simulation.
 	OPTIMISTIC = 2,		///optimistic parallel simulation
 	CONSERVATIVE = 4,	///conservative parallel simulation
-	DYNAMIC = 8		///dynamic structured non-parallel simulation
+	DYNAMIC = 8,		///dynamic structured non-parallel simulation
+	HYBRID = 16		///parallel simulation, each core switches between conservative and optimistic
 };
 
 
 /**
  * @brief Tests if the simulation type is parallel.
  * @param s A SimType enum value.
- * Parallel simulation types are SimType::OPTIMISTIC and SimType::CONSERVATIVE.
+ * Parallel simulation types are SimType::OPTIMISTIC, SimType::CONSERVATIVE and SimType::HYBRID.
  */
 inline bool isParallel(SimType s){
-	return (s & (OPTIMISTIC | CONSERVATIVE));
+	return (s & (OPTIMISTIC | CONSERVATIVE | HYBRID));
+}
+
+/**
+ * @return the name of s as the benchmarks take it on the command line.
+ */
+inline const char* simTypeName(SimType s){
+	switch(s){
+	case OPTIMISTIC:
+		return "opdevs";
+	case CONSERVATIVE:
+		return "cpdevs";
+	case DYNAMIC:
+		return "dynamic";
+	case HYBRID:
+		return "hpdevs";
+	default:
+		return "classic";
+	}
 }
 
 } /* namespace n_control */
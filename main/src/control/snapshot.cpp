@@ -0,0 +1,98 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include "control/snapshot.h"
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace n_control {
+
+using n_network::t_timestamp;
+
+namespace {
+
+constexpr uint32_t snapshot_magic = 0x50414e53;	// "SNAP"
+constexpr uint32_t snapshot_version = 1;
+
+template<typename T>
+void put(std::ostream& out, const T& value)
+{
+	if(!ToBinary<T>::exec(out, value))
+		throw std::logic_error("Can't write snapshot.");
+}
+
+template<typename T>
+T get(std::istream& in)
+{
+	T value;
+	if(!FromBinary<T>::exec(in, value))
+		throw std::logic_error("Snapshot truncated.");
+	return value;
+}
+
+} /* namespace */
+
+void writeSnapshot(std::ostream& out, const std::vector<n_model::t_atomicmodelptr>& models, t_timestamp time)
+{
+	put<uint32_t>(out, snapshot_magic);
+	put<uint32_t>(out, snapshot_version);
+	put<t_timestamp::t_time>(out, time.getTime());
+	put<uint64_t>(out, models.size());
+	std::ostringstream state;
+	for(const auto& model : models){
+		state.str("");
+		if(!model->getState()->toBinary(state))
+			throw std::logic_error("Can't write the state of " + model->getName() + " to a snapshot.");
+		put<std::string>(out, model->getName());
+		put<t_timestamp::t_time>(out, model->getTimeLast().getTime());
+		put<t_timestamp::t_time>(out, model->getTimeNext().getTime());
+		put<std::string>(out, state.str());
+	}
+	LOG_INFO("SNAPSHOT: wrote ", models.size(), " models at time ", time);
+}
+
+t_timestamp readSnapshot(std::istream& in, const std::vector<n_model::t_atomicmodelptr>& models)
+{
+	if(get<uint32_t>(in) != snapshot_magic)
+		throw std::logic_error("Not a snapshot.");
+	const uint32_t version = get<uint32_t>(in);
+	if(version != snapshot_version)
+		throw std::logic_error("Unsupported snapshot version " + std::to_string(version));
+	const t_timestamp time(get<t_timestamp::t_time>(in), 0);
+	const uint64_t count = get<uint64_t>(in);
+	if(count != models.size())
+		throw std::logic_error("Snapshot holds " + std::to_string(count) + " models, the simulation "
+			+ std::to_string(models.size()));
+
+	std::unordered_map<std::string, n_model::t_atomicmodelptr> byName;
+	for(const auto& model : models)
+		byName[model->getName()] = model;
+	if(byName.size() != models.size())
+		throw std::logic_error("Model names are not unique, can't match them to a snapshot.");
+	for(uint64_t i = 0; i < count; ++i){
+		const std::string name = get<std::string>(in);
+		const auto it = byName.find(name);
+		if(it == byName.end())
+			throw std::logic_error("Snapshot holds unknown (or twice the same) model " + name);
+		const t_timestamp timeLast(get<t_timestamp::t_time>(in), 0);
+		const t_timestamp timeNext(get<t_timestamp::t_time>(in), 0);
+		std::istringstream state(get<std::string>(in));
+		const n_model::t_atomicmodelptr& model = it->second;
+		if(!model->getState()->fromBinary(state) || state.peek() != std::char_traits<char>::eof())
+			throw std::logic_error("Can't read the state of " + name + " from the snapshot.");
+		model->restoreTime(timeLast, timeNext);
+		byName.erase(it);
+	}
+	LOG_INFO("SNAPSHOT: restored ", count, " models at time ", time);
+	return time;
+}
+
+} /* namespace n_control */
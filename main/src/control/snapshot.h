@@ -0,0 +1,43 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_CONTROL_SNAPSHOT_H_
+#define SRC_CONTROL_SNAPSHOT_H_
+
+#include <iostream>
+#include <vector>
+#include "model/atomicmodel.h"
+
+namespace n_control {
+
+/**
+ * @brief Writes a binary snapshot of models, in the order given.
+ *
+ * The snapshot starts with a magic number, the format version and the time it was taken.
+ * Then for each model : its name, the time of its last and next transition, and its state as written by
+ * State::toBinary, prefixed with the size. All numbers are written in native byte order.
+ * @param time : the time the simulation stopped.
+ * @throw std::logic_error if a state can't be written (see ToBinary) or the stream fails.
+ */
+void writeSnapshot(std::ostream& out, const std::vector<n_model::t_atomicmodelptr>& models, n_network::t_timestamp time);
+
+/**
+ * @brief Restores the states and times of models from a snapshot.
+ * Models are matched by name, so the allocation to cores may differ from the simulation that wrote it.
+ * @return the time the snapshot was taken.
+ * @throw std::logic_error if the snapshot is malformed, or does not hold exactly the given models.
+ * Models read before the error are restored.
+ * @see n_model::AtomicModel_impl::restoreTime
+ */
+n_network::t_timestamp readSnapshot(std::istream& in, const std::vector<n_model::t_atomicmodelptr>& models);
+
+} /* namespace n_control */
+
+#endif /* SRC_CONTROL_SNAPSHOT_H_ */
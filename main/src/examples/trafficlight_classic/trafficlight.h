@@ -58,6 +58,20 @@ struct ToCell<n_examples::TrafficLightMode>
 		return "";
 	}
 };
+template<>
+struct ToBinary<n_examples::TrafficLightMode>
+{
+	static bool exec(std::ostream& out, const n_examples::TrafficLightMode& s){
+		return ToBinary<std::string>::exec(out, s.m_value);
+	}
+};
+template<>
+struct FromBinary<n_examples::TrafficLightMode>
+{
+	static bool exec(std::istream& in, n_examples::TrafficLightMode& s){
+		return FromBinary<std::string>::exec(in, s.m_value);
+	}
+};
 
 namespace n_examples {
 
@@ -64,6 +64,20 @@ struct ToCell<n_examples_coupled::PolicemanMode>
 		return "";
 	}
 };
+template<>
+struct ToBinary<n_examples_coupled::PolicemanMode>
+{
+	static bool exec(std::ostream& out, const n_examples_coupled::PolicemanMode& s){
+		return ToBinary<std::string>::exec(out, s.m_value);
+	}
+};
+template<>
+struct FromBinary<n_examples_coupled::PolicemanMode>
+{
+	static bool exec(std::istream& in, n_examples_coupled::PolicemanMode& s){
+		return FromBinary<std::string>::exec(in, s.m_value);
+	}
+};
 
 namespace n_examples_coupled {
 
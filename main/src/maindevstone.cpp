@@ -22,18 +22,19 @@ using namespace n_tools;
 
 /**
  * cmd args:
- * [-h] [-t ENDTIME] [-w WIDTH] [-d DEPTH] [-r] [-c COREAMT] [classic|cpdevs|opdevs|pdevs]
+ * [-h] [-t ENDTIME] [-w WIDTH] [-d DEPTH] [-r] [-c COREAMT] [-p THREADS] [classic|cpdevs|opdevs|pdevs]
  * 	-h: show help and exit
  * 	-t ENDTIME set the endtime of the simulation
  * 	-w WIDTH the with of the devstone model
  * 	-d DEPTH the depth of the devstone model
  * 	-c COREAMT amount of simulation cores, ignored in classic mode
+ * 	-p THREADS amount of threads for the transitions of a classic or conservative simulation
  * 	classic run single core simulation
  * 	cpdevs run conservative parallel simulation
  * 	opdevs|pdevs run optimistic parallel simulation
  * The last value entered for an option will overwrite any previous values for that option.
  */
-const char helpstr[] = " [-h] [-t ENDTIME] [-w WIDTH] [-d DEPTH] [-r] [-c COREAMT] [classic|cpdevs|opdevs|pdevs]\n"
+const char helpstr[] = " [-h] [-t ENDTIME] [-w WIDTH] [-d DEPTH] [-r] [-c COREAMT] [-p THREADS] [classic|cpdevs|opdevs|pdevs]\n"
 	"options:\n"
 	"  -h           show help and exit\n"
 	"  -t ENDTIME   set the endtime of the simulation\n"
@@ -41,6 +42,7 @@ const char helpstr[] = " [-h] [-t ENDTIME] [-w WIDTH] [-d DEPTH] [-r] [-c COREAM
 	"  -d DEPTH     the depth of the devstone model\n"
 	"  -r           use randomized processing time\n"
 	"  -c COREAMT   amount of simulation cores, ignored in classic mode. Must not be 0.\n"
+	"  -p THREADS   amount of threads for the transitions of each core, only used in classic and cpdevs mode.\n"
 	"  classic      Run single core simulation.\n"
 	"  cpdevs       Run conservative parallel simulation.\n"
 	"  opdevs|pdevs Run optimistic parallel simulation.\n"
@@ -57,6 +59,7 @@ int main(int argc, char** argv)
 	const char optHelp = 'h';
 	const char optRand = 'r';
 	const char optCores = 'c';
+	const char optThreads = 'p';
 	char** argvc = argv+1;
 
 #ifdef FPTIME
@@ -71,6 +74,7 @@ int main(int argc, char** argv)
 	bool hasError = false;
 	n_control::SimType simType = n_control::SimType::CLASSIC;
 	std::size_t coreAmt = 4;
+	std::size_t threads = 0;
 
 	for(int i = 1; i < argc; ++argvc, ++i){
 		char c = getOpt(*argvc);
@@ -103,6 +107,14 @@ int main(int argc, char** argv)
 				std::cout << "Missing argument for option -" << optCores << '\n';
 			}
 			break;
+		case optThreads:
+			++i;
+			if(i < argc){
+				threads = toData<std::size_t>(std::string(*(++argvc)));
+			} else {
+				std::cout << "Missing argument for option -" << optThreads << '\n';
+			}
+			break;
 		case optETime:
 			++i;
 			if(i < argc){
@@ -148,6 +160,7 @@ int main(int argc, char** argv)
 	conf.m_name = "DEVStone";
 	conf.m_simType = simType;
 	conf.m_coreAmount = coreAmt;
+	conf.m_transitionThreads = threads;
 	conf.m_saveInterval = 250;     
 	conf.m_allocator = n_tools::createObject<n_devstone::DevstoneAlloc>();
 
@@ -10,14 +10,18 @@
 
 #include <performance/phold/phold.h>
 #include "control/controllerconfig.h"
+#include "control/graphallocator.h"
+#include "control/fileallocator.h"
+#include "control/profiler.h"
 #include "tools/coutredirect.h"
 #include "tools/stringtools.h"
+#include <thread>
 
 using namespace n_tools;
 
 LOG_INIT("phold.log")
 
-const char helpstr[] = " [-h] [-t ENDTIME] [-n NODES] [-s SUBNODES] [-r REMOTES] [-p PRIORITY] [-i ITER] [-c COREAMT] [classic|cpdevs|opdevs|pdevs]\n"
+const char helpstr[] = " [-h] [-t ENDTIME] [-n NODES] [-s SUBNODES] [-r REMOTES] [-p PRIORITY] [-i ITER] [-c COREAMT] [-w WORKERS] [-k INTERVAL] [-l] [-o WINDOW] [-a] [-b BUDGET] [-g] [-P MAPFILE] [-m MAPFILE] [classic|cpdevs|opdevs|pdevs|hpdevs]\n"
 	"options:\n"
 	"  -h             show help and exit\n"
 	"  -t ENDTIME     set the endtime of the simulation\n"
@@ -27,9 +31,23 @@ const char helpstr[] = " [-h] [-t ENDTIME] [-n NODES] [-s SUBNODES] [-r REMOTES]
     "  -p PRIORITY    chance of a priority event. Must be within the range [0.0, 1.0]\n"
 	"  -i ITER        amount of useless work to simulate complex calculations\n"
 	"  -c COREAMT     amount of simulation cores, ignored in classic mode. This should be exactly equal to the n argument!!!\n"
+	"  -w WORKERS     amount of threads running the simulation cores, ignored in classic mode. Default 0, one thread per core.\n"
+	"                 Use more cores than workers to over decompose the model, idle workers will steal cores from busy ones.\n"
+	"  -k INTERVAL    amount of transitions between state copies in optimistic mode. Default 1, 0 lets each model adapt its interval.\n"
+	"  -l             use lazy cancellation in optimistic mode.\n"
+	"  -o WINDOW      bound how far an optimistic core can run ahead of GVT. Default 0, unbounded.\n"
+	"  -a             adapt the optimism window to the nr of reverts.\n"
+	"  -b BUDGET      bound the nr of messages and states the optimistic cores keep together. Over budget, the core\n"
+	"                 furthest ahead of GVT rolls back. Default 0, unbounded.\n"
+	"  -g             allocate the models by partitioning their connection graph, instead of one node per core.\n"
+	"  -P MAPFILE     profile a classic pilot run, print the recommended setup and write its core map to MAPFILE.\n"
+	"                 The recommendation uses at most COREAMT cores if -c is given, else the nr of hardware threads.\n"
+	"  -m MAPFILE     allocate the models as a core map written by -P. Its simulation type and core amount are used\n"
+	"                 unless they are given, the n argument need not match.\n"
 	"  classic        Run single core simulation.\n"
 	"  cpdevs         Run conservative parallel simulation.\n"
 	"  opdevs|pdevs   Run optimistic parallel simulation.\n"
+	"  hpdevs         Run parallel simulation, each core switches between conservative and optimistic.\n"
 	"note:\n"
 	"  If the same option is set multiple times, only the last value is taken.\n";
 int main(int argc, char** argv)
@@ -43,6 +61,15 @@ int main(int argc, char** argv)
     const char optRemote = 'r';
     const char optPriority = 'p';
 	const char optCores = 'c';
+	const char optWorkers = 'w';
+	const char optCheckpoint = 'k';
+	const char optLazy = 'l';
+	const char optWindow = 'o';
+	const char optAdaptiveWindow = 'a';
+	const char optBudget = 'b';
+	const char optGraphAlloc = 'g';
+	const char optProfile = 'P';
+	const char optCoreMap = 'm';
 	char** argvc = argv+1;
 
 #ifdef FPTIME
@@ -59,18 +86,36 @@ int main(int argc, char** argv)
 	bool hasError = false;
 	n_control::SimType simType = n_control::SimType::CLASSIC;
 	std::size_t coreAmt = 4;
+	std::size_t workerAmt = 0;
+	std::size_t checkpointInterval = 1;
+	bool lazyCancellation = false;
+	n_network::t_timestamp::t_time window = 0;
+	bool adaptiveWindow = false;
+	std::size_t budget = 0;
+	bool graphAlloc = false;
+	bool simTypeSet = false;
+	bool coreAmtSet = false;
+	std::string profileFile;
+	std::string coreMapFile;
 
 	for(int i = 1; i < argc; ++argvc, ++i){
 		char c = getOpt(*argvc);
 		if(!c){
 			if(!strcmp(*argvc, "classic")){
 				simType = n_control::SimType::CLASSIC;
+				simTypeSet = true;
 				continue;
 			} else if(!strcmp(*argvc, "cpdevs")){
 				simType = n_control::SimType::CONSERVATIVE;
+				simTypeSet = true;
 				continue;
 			} else if(!strcmp(*argvc, "opdevs") || !strcmp(*argvc, "pdevs")){
 				simType = n_control::SimType::OPTIMISTIC;
+				simTypeSet = true;
+				continue;
+			} else if(!strcmp(*argvc, "hpdevs")){
+				simType = n_control::SimType::HYBRID;
+				simTypeSet = true;
 				continue;
 			} else {
 				std::cout << "Unknown argument: " << *argvc << '\n';
@@ -83,6 +128,7 @@ int main(int argc, char** argv)
 			++i;
 			if(i < argc){
 				coreAmt = toData<std::size_t>(std::string(*(++argvc)));
+				coreAmtSet = true;
 				if(coreAmt == 0){
 					std::cout << "Invalid argument for option -" << optCores << '\n';
 					hasError = true;
@@ -91,6 +137,63 @@ int main(int argc, char** argv)
 				std::cout << "Missing argument for option -" << optCores << '\n';
 			}
 			break;
+		case optWorkers:
+			++i;
+			if(i < argc){
+				workerAmt = toData<std::size_t>(std::string(*(++argvc)));
+			} else {
+				std::cout << "Missing argument for option -" << optWorkers << '\n';
+			}
+			break;
+		case optCheckpoint:
+			++i;
+			if(i < argc){
+				checkpointInterval = toData<std::size_t>(std::string(*(++argvc)));
+			} else {
+				std::cout << "Missing argument for option -" << optCheckpoint << '\n';
+			}
+			break;
+		case optLazy:
+			lazyCancellation = true;
+			break;
+		case optGraphAlloc:
+			graphAlloc = true;
+			break;
+		case optProfile:
+			++i;
+			if(i < argc){
+				profileFile = *(++argvc);
+			} else {
+				std::cout << "Missing argument for option -" << optProfile << '\n';
+			}
+			break;
+		case optCoreMap:
+			++i;
+			if(i < argc){
+				coreMapFile = *(++argvc);
+			} else {
+				std::cout << "Missing argument for option -" << optCoreMap << '\n';
+			}
+			break;
+		case optWindow:
+			++i;
+			if(i < argc){
+				window = toData<n_network::t_timestamp::t_time>(std::string(*(++argvc)));
+			} else {
+				std::cout << "Missing argument for option -" << optWindow << '\n';
+			}
+			break;
+		case optAdaptiveWindow:
+			adaptiveWindow = true;
+			break;
+		case optBudget:
+			++i;
+			if(i < argc){
+				budget = toData<std::size_t>(std::string(*(++argvc)));
+			} else {
+				std::cout << "Missing argument for option -" << optBudget << '\n';
+			}
+			break;
 		case optETime:
 			++i;
 			if(i < argc){
@@ -156,7 +259,24 @@ int main(int argc, char** argv)
 		std::cout << "usage: \n\t" << argv[0] << helpstr;
 		return -1;
 	}
-        if(nodes != coreAmt && simType!=n_control::SimType::CLASSIC){
+	std::shared_ptr<n_control::FileAllocator> coreMap;
+	if(!coreMapFile.empty()){
+		coreMap = n_tools::createObject<n_control::FileAllocator>(coreMapFile);
+		if(!simTypeSet && coreMap->hasFileSimType())
+			simType = coreMap->getFileSimType();
+		if(coreAmtSet)
+			coreMap->setCoreAmount(coreAmt);
+		else
+			coreAmt = coreMap->coreAmount();
+	}
+	std::unique_ptr<n_control::Profiler> profiler;
+	if(!profileFile.empty()){
+		// The profile is recorded by a single core.
+		simType = n_control::SimType::CLASSIC;
+		const std::size_t maxCores = coreAmtSet ? coreAmt : std::thread::hardware_concurrency();
+		profiler.reset(new n_control::Profiler(maxCores));
+	}
+        if(!coreMap && nodes != coreAmt && simType!=n_control::SimType::CLASSIC){
                 std::cerr << nodes << std::endl;
                 std::cerr << coreAmt << std::endl;
                 throw std::logic_error("N should match C");
@@ -165,8 +285,21 @@ int main(int argc, char** argv)
 	conf.m_name = "PHOLD";
 	conf.m_simType = simType;
 	conf.m_coreAmount = coreAmt;
+	conf.m_workerThreads = workerAmt;
+	conf.m_checkpointInterval = checkpointInterval;
+	conf.m_lazyCancellation = lazyCancellation;
+	conf.m_optimismWindow = window;
+	conf.m_adaptiveWindow = adaptiveWindow;
+	conf.m_historyBudget = budget;
 	conf.m_saveInterval = 5;
-	conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
+	if(profiler)
+		conf.m_profile = profiler->getProfile();
+	if(coreMap)
+		conf.m_allocator = coreMap;
+	else if(graphAlloc)
+		conf.m_allocator = n_tools::createObject<n_control::GraphAllocator>(coreAmt);
+	else
+		conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
 
 	auto ctrl = conf.createController();
 	t_timestamp endTime(eTime, 0);
@@ -182,6 +315,14 @@ int main(int argc, char** argv)
 
 		ctrl->simulate();
 	}
+	if(profiler){
+		const n_control::Profiler::Recommendation rec = profiler->recommend();
+		profiler->printReport(rec);
+		std::ofstream mapstream(profileFile);
+		if(!mapstream.is_open())
+			throw std::logic_error("File not open : " + profileFile);
+		profiler->writeCoreMap(rec, mapstream);
+	}
 #ifdef USE_VIZ
         ctrl->visualize();
 #endif        
@@ -9,17 +9,23 @@
  */
 #include "tools/globallog.h"
 #include "model/atomicmodel.h"
+#include <cmath>
+#include <algorithm>
 
 namespace n_model {
 
 AtomicModel_impl::AtomicModel_impl(std::string name, std::size_t)
-	: Model(name), m_corenumber(-1), m_keepOldStates(false), m_state(nullptr), m_priority(nextPriority()),m_transition_type_next(NONE)
+	: Model(name), m_corenumber(-1), m_keepOldStates(false), m_state(nullptr), m_reversible(false),
+	  m_checkpointSetting(CHECKPOINT_DEFAULT), m_checkpointInterval(1), m_coastForward(false), m_sinceCheckpoint(0),
+	  m_windowTransitions(0), m_windowReverts(0), m_staticLookahead(0u, 0u), m_events(0), m_restored(false), m_priority(nextPriority()),m_transition_type_next(NONE)
 {
         LOG_DEBUG("\tAMODEL ctor :: name=", name, " m_prior= ", m_priority , " corenr=", m_corenumber);
 }
 
 AtomicModel_impl::AtomicModel_impl(std::string name, int corenumber, std::size_t priority)
-	: Model(name), m_corenumber(corenumber), m_keepOldStates(false), m_state(nullptr), m_priority(nextPriority()),m_transition_type_next(NONE)
+	: Model(name), m_corenumber(corenumber), m_keepOldStates(false), m_state(nullptr), m_reversible(false),
+	  m_checkpointSetting(CHECKPOINT_DEFAULT), m_checkpointInterval(1), m_coastForward(false), m_sinceCheckpoint(0),
+	  m_windowTransitions(0), m_windowReverts(0), m_staticLookahead(0u, 0u), m_events(0), m_restored(false), m_priority(nextPriority()),m_transition_type_next(NONE)
 {
         if(m_priority == std::numeric_limits<std::size_t>::max())
                 m_priority = nextPriority();
@@ -53,6 +59,24 @@ void AtomicModel_impl::extTransition(const std::vector<n_network::t_msgptr>&)
 	assert(false);
 }
 
+void AtomicModel_impl::reverseIntTransition()
+{
+	LOG_ERROR("ATOMICMODEL: Not implemented: 'void n_model::AtomicModel::reverseIntTransition()'");
+	throw std::logic_error("Reversible model " + getName() + " does not implement reverseIntTransition.");
+}
+
+void AtomicModel_impl::reverseExtTransition(std::size_t)
+{
+	LOG_ERROR("ATOMICMODEL: Not implemented: 'void n_model::AtomicModel::reverseExtTransition(std::size_t messages)'");
+	throw std::logic_error("Reversible model " + getName() + " does not implement reverseExtTransition.");
+}
+
+void AtomicModel_impl::reverseConfTransition(std::size_t messages)
+{
+	this->reverseExtTransition(messages);
+	this->reverseIntTransition();
+}
+
 void AtomicModel_impl::doExtTransition(const std::vector<n_network::t_msgptr>& message)
 {
 	// Remove all old messages in the input-ports of this model, so the tracer won't find them again
@@ -64,7 +88,7 @@ void AtomicModel_impl::doExtTransition(const std::vector<n_network::t_msgptr>& m
 #endif        
 
 	//copy the current state, if necessary
-	copyState();
+	saveState(EXT, &message);
 
 	// Do the actual external transition
 	this->extTransition(message);
@@ -78,7 +102,7 @@ void AtomicModel_impl::doIntTransition()
 #endif
 
 	//copy the current state, if necessary
-	copyState();
+	saveState(INT);
 
 	intTransition();
 }
@@ -95,7 +119,7 @@ void AtomicModel_impl::doConfTransition(const std::vector<n_network::t_msgptr>&
 	deliverMessages(message);
 
 	//copy the current state, if necessary
-	copyState();
+	saveState(CONF, &message);
 
 	this->confTransition(message);
 }
@@ -117,6 +141,14 @@ void AtomicModel_impl::setGVT(t_timestamp gvt)
                 LOG_ERROR("Model has set m_keepOldStates to false, can't call setGVT!");
                 return;
         }
+        if (m_reversible) {
+                setGVTReversible(gvt);
+                return;
+        }
+        if (m_coastForward) {
+                setGVTCheckpoint(gvt);
+                return;
+        }
         assert(!m_oldStates.empty() && "AtomicModel_impl::setGVT no memory!");
         // Model has no memory of past
         if (m_oldStates.empty()) {
@@ -168,6 +200,14 @@ t_timestamp AtomicModel_impl::revert(t_timestamp time)
                 throw std::logic_error("We're almost a markov chain, we really don't care what our past is.");
 		return t_timestamp::infinity();
 	}
+	if (m_reversible) {
+		revertReversible(time);
+		return this->m_timeNext;
+	}
+	if (m_coastForward) {
+		revertCheckpoint(time);
+		return this->m_timeNext;
+	}
 	auto r_itStates = m_oldStates.rbegin();
 	int index = m_oldStates.size() - 1;
 
@@ -222,6 +262,16 @@ void AtomicModel_impl::setTime(t_timestamp time)
 //	laststate->m_timeNext = this->m_timeNext;
 }
 
+void AtomicModel_impl::restoreTime(t_timestamp timeLast, t_timestamp timeNext)
+{
+	this->m_timeLast = t_timestamp(timeLast.getTime(), m_priority);
+	this->m_timeNext = isInfinity(timeNext)? t_timestamp::infinity() : this->m_timeLast + t_timestamp(timeNext.getTime() - timeLast.getTime(), 0);
+	m_state->m_timeLast = this->m_timeLast;
+	m_state->m_timeNext = this->m_timeNext;
+	m_restored = true;
+	LOG_DEBUG("restoring time of ", getName(), " to ", m_timeLast, " next ", m_timeNext);
+}
+
 t_timestamp AtomicModel_impl::getTimeElapsed() const
 {
 	return m_elapsed;
@@ -307,4 +357,223 @@ void AtomicModel_impl::copyState()
 	m_state = copy;
 }
 
+void AtomicModel_impl::saveState(t_transtype type, const std::vector<n_network::t_msgptr>* message)
+{
+	++m_events;
+	if(!m_reversible && !m_coastForward){
+		copyState();
+		return;
+	}
+	if(!m_keepOldStates)
+		return;
+	TransitionRecord record;
+	record.m_timeLast = m_timeLast;
+	record.m_timeNext = m_timeNext;
+	record.m_elapsed = m_elapsed;
+	record.m_messages = message? message->size(): 0;
+	record.m_values = 0;
+	record.m_type = type;
+	record.m_checkpoint = false;
+	if(m_coastForward){
+		// The originals can be destroyed before this transition is replayed.
+		if(message){
+			for(const n_network::t_msgptr& msg : *message)
+				m_logMessages.push_back(msg->copyMessage());
+		}
+		if(m_sinceCheckpoint >= m_checkpointInterval){
+			copyState();
+			record.m_checkpoint = true;
+			m_sinceCheckpoint = 0;
+		}
+		++m_sinceCheckpoint;
+		++m_windowTransitions;
+	}
+	m_transitions.push_back(record);
+}
+
+void AtomicModel_impl::revertReversible(const t_timestamp& time)
+{
+	// m_timeLast is the time of the last transition that is not undone yet.
+	while (!m_transitions.empty() && m_timeLast >= time) {
+		const TransitionRecord record = m_transitions.back();
+		m_transitions.pop_back();
+		const std::size_t values = m_undoValues.size() - record.m_values;
+		m_elapsed = record.m_elapsed;
+		LOG_DEBUG("AMODEL:: ", getName(), " reversing transition ", int(record.m_type), " at ", m_timeLast, " with ", record.m_messages, " messages");
+		switch (record.m_type) {
+		case INT:
+			this->reverseIntTransition();
+			break;
+		case EXT:
+			this->reverseExtTransition(record.m_messages);
+			break;
+		default:
+			this->reverseConfTransition(record.m_messages);
+			break;
+		}
+		assert(m_undoValues.size() >= values && "Reverse handler popped more values than its transition pushed.");
+		m_undoValues.resize(values);
+		m_timeLast = record.m_timeLast;
+		m_timeNext = record.m_timeNext;
+		m_state->m_timeLast = m_timeLast;
+		m_state->m_timeNext = m_timeNext;
+	}
+	LOG_DEBUG("AMODEL:: reverse computation for totime ", time, " returning ", this->m_timeNext, " timelast = ", this->m_timeLast);
+}
+
+void AtomicModel_impl::setGVTReversible(const t_timestamp& gvt)
+{
+	// The time of record i is the time last of record i+1, or of the model for the last record.
+	std::size_t records = 0;
+	std::size_t values = 0;
+	for (std::size_t i = 0; i < m_transitions.size(); ++i) {
+		const t_timestamp& transitiontime = (i + 1 < m_transitions.size())? m_transitions[i + 1].m_timeLast: m_timeLast;
+		if (transitiontime >= gvt)
+			break;
+		++records;
+		values += m_transitions[i].m_values;
+	}
+	m_transitions.erase(m_transitions.begin(), m_transitions.begin() + records);
+	m_undoValues.erase(m_undoValues.begin(), m_undoValues.begin() + values);
+}
+
+void AtomicModel_impl::revertCheckpoint(const t_timestamp& time)
+{
+	// Find the first logged transition at or after time.
+	std::size_t first = m_transitions.size();
+	while (first > 0 && transitionTime(first - 1) >= time)
+		--first;
+	if (first == m_transitions.size())
+		return;
+	++m_windowReverts;
+
+	// Drop the states copied by the undone transitions, and the copies of their messages.
+	std::size_t undoneMessages = 0;
+	for (std::size_t i = first; i < m_transitions.size(); ++i) {
+		undoneMessages += m_transitions[i].m_messages;
+		if (m_transitions[i].m_checkpoint) {
+			m_oldStates.back()->releaseMe();
+			m_oldStates.pop_back();
+		}
+	}
+	assert(!m_oldStates.empty() && "AtomicModel_impl::revertCheckpoint dropped all states.");
+	m_state = m_oldStates.back();
+
+	// The last state is clean if the first undone transition was made on a new copy,
+	// else restore the checkpoint before it and replay the transitions up to time.
+	std::size_t checkpoint = first;
+	if (!m_transitions[first].m_checkpoint) {
+		std::size_t replayMessages = 0;
+		while (!m_transitions[checkpoint - 1].m_checkpoint) {
+			--checkpoint;
+			replayMessages += m_transitions[checkpoint].m_messages;
+		}
+		--checkpoint;
+		replayMessages += m_transitions[checkpoint].m_messages;
+		assert(m_oldStates.size() > 1 && "AtomicModel_impl::revertCheckpoint has no checkpoint to restore.");
+
+		m_state->releaseMe();
+		m_oldStates.pop_back();
+		m_state = m_oldStates.back()->copyPooledState();
+		m_oldStates.push_back(m_state);
+
+		LOG_DEBUG("AMODEL:: ", getName(), " coasting forward ", first - checkpoint, " transitions to ", time);
+		// Replayed transitions are not traced and their output is not sent again.
+		const bool revertflag = n_tlocal::isRevertSet();
+		n_tlocal::setRevert(true);
+		std::size_t msgindex = m_logMessages.size() - undoneMessages - replayMessages;
+		std::vector<n_network::t_msgptr> message;
+		for (std::size_t i = checkpoint; i < first; ++i) {
+			const TransitionRecord& record = m_transitions[i];
+			m_timeLast = record.m_timeLast;
+			m_timeNext = record.m_timeNext;
+			m_elapsed = record.m_elapsed;
+			message.assign(m_logMessages.begin() + msgindex, m_logMessages.begin() + msgindex + record.m_messages);
+			msgindex += record.m_messages;
+			switch (record.m_type) {
+			case INT:
+				this->intTransition();
+				break;
+			case EXT:
+				this->extTransition(message);
+				break;
+			default:
+				this->confTransition(message);
+				break;
+			}
+		}
+		n_tlocal::setRevert(revertflag);
+	} else {
+		while (checkpoint > 0 && !m_transitions[checkpoint - 1].m_checkpoint)
+			--checkpoint;
+		if (checkpoint > 0)
+			--checkpoint;
+	}
+
+	m_timeLast = m_transitions[first].m_timeLast;
+	m_timeNext = m_transitions[first].m_timeNext;
+	m_state->m_timeLast = m_timeLast;
+	m_state->m_timeNext = m_timeNext;
+	// Continue the restored segment, if there is none the next transition takes a checkpoint.
+	m_sinceCheckpoint = (first == 0)? std::numeric_limits<std::size_t>::max(): first - checkpoint;
+
+	for (std::size_t i = m_logMessages.size() - undoneMessages; i < m_logMessages.size(); ++i)
+		m_logMessages[i]->releaseMe();
+	m_logMessages.resize(m_logMessages.size() - undoneMessages);
+	m_transitions.resize(first);
+	LOG_DEBUG("AMODEL:: checkpoint revert for totime ", time, " returning ", this->m_timeNext, " timelast = ", this->m_timeLast);
+}
+
+void AtomicModel_impl::setGVTCheckpoint(const t_timestamp& gvt)
+{
+	if (m_checkpointSetting == CHECKPOINT_ADAPTIVE)
+		adaptCheckpointInterval();
+
+	// A revert to a time >= gvt keeps at least the transitions before gvt,
+	// so it needs the checkpoint of the last of those, and everything after it.
+	std::size_t before = 0;
+	while (before < m_transitions.size() && transitionTime(before) < gvt)
+		++before;
+	if (before == 0)
+		return;
+	std::size_t checkpoint = before - 1;
+	while (!m_transitions[checkpoint].m_checkpoint)
+		--checkpoint;
+
+	std::size_t states = 0;
+	std::size_t messages = 0;
+	for (std::size_t i = 0; i < checkpoint; ++i) {
+		messages += m_transitions[i].m_messages;
+		if (m_transitions[i].m_checkpoint)
+			++states;
+	}
+	// The state copied at checkpoint is preceded by the (frozen) state it was copied from, keep that one.
+	for (std::size_t i = 0; i < states; ++i)
+		m_oldStates[i]->releaseMe();
+	m_oldStates.erase(m_oldStates.begin(), m_oldStates.begin() + states);
+	for (std::size_t i = 0; i < messages; ++i)
+		m_logMessages[i]->releaseMe();
+	m_logMessages.erase(m_logMessages.begin(), m_logMessages.begin() + messages);
+	m_transitions.erase(m_transitions.begin(), m_transitions.begin() + checkpoint);
+}
+
+void AtomicModel_impl::adaptCheckpointInterval()
+{
+	constexpr std::size_t window = 64;
+	if (m_windowTransitions < window)
+		return;
+	if (m_windowReverts == 0) {
+		m_checkpointInterval = std::min(m_checkpointInterval * 2, std::size_t(CHECKPOINT_MAX));
+	} else {
+		// With copying and replaying a transition equally expensive, the interval that minimizes
+		// the overhead is about sqrt(2 * transitions per revert).
+		const double interval = std::sqrt(2.0 * m_windowTransitions / m_windowReverts);
+		m_checkpointInterval = std::max<std::size_t>(1, std::min(std::size_t(std::lround(interval)), std::size_t(CHECKPOINT_MAX)));
+	}
+	LOG_DEBUG("AMODEL:: ", getName(), " checkpoint interval set to ", m_checkpointInterval, " after ",
+		m_windowReverts, " reverts in ", m_windowTransitions, " transitions");
+	m_windowTransitions = 0;
+	m_windowReverts = 0;
+}
+
 }
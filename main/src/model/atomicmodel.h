@@ -19,6 +19,9 @@
 #include <deque>
 #include "tools/globallog.h"
 #include <set>
+#include <cstring>
+#include <type_traits>
+#include <limits>
 
 namespace n_model {
 
@@ -62,6 +65,55 @@ private:
 	t_stateptr m_state;
 	std::deque<t_stateptr> m_oldStates;
 
+	/**
+	 * @brief If true, the model undoes transitions with its reverse handlers instead of restoring copied states.
+	 * @see setReversible
+	 */
+	bool m_reversible;
+
+	/**
+	 * Log entry for a single transition, holding the times from before the transition.
+	 * Reversible models store the values the transition saved in m_undoValues, in order.
+	 * Checkpointing models store copies of the received messages in m_logMessages, in order.
+	 */
+	struct TransitionRecord
+	{
+		t_timestamp m_timeLast;
+		t_timestamp m_timeNext;
+		t_timestamp m_elapsed;
+		uint32_t m_messages;
+		uint32_t m_values;
+		t_transtype m_type;
+		/// True if the state was copied before this transition.
+		bool m_checkpoint;
+	};
+
+	std::deque<TransitionRecord> m_transitions;
+	std::deque<std::size_t> m_undoValues;
+
+	/**
+	 * @brief Nr of transitions between state copies in optimistic simulation.
+	 * Either a fixed interval, CHECKPOINT_ADAPTIVE or CHECKPOINT_DEFAULT.
+	 * @see setCheckpointInterval
+	 */
+	std::size_t m_checkpointSetting;
+	/// The interval in use, only differs from m_checkpointSetting if that is not fixed.
+	std::size_t m_checkpointInterval;
+	/// True if the model coasts forward from sparse checkpoints instead of copying its state before each transition.
+	bool m_coastForward;
+	/// Nr of transitions since the last checkpoint.
+	std::size_t m_sinceCheckpoint;
+	/// Nr of transitions and reverts since the interval was last adapted.
+	std::size_t m_windowTransitions;
+	std::size_t m_windowReverts;
+	std::deque<n_network::t_msgptr> m_logMessages;
+	/// Lookahead declared with setStaticLookahead, zero if the model did not declare one.
+	t_timestamp m_staticLookahead;
+	/// Nr of transitions (including undone ones) since the last resetEvents.
+	std::size_t m_events;
+	/// True if the times were restored from a snapshot, until a core takes them over.
+	bool m_restored;
+
 protected:
 	// lower number -> higher priority
 	std::size_t m_priority;
@@ -77,6 +129,47 @@ private:
 	 */
 	void copyState();
 
+	/**
+	 * @brief Saves what is needed to undo the next transition, if necessary.
+	 * Reversible models log an undo record, checkpointing models log the transition and
+	 * copy their state every m_checkpointInterval transitions, others copy their state.
+	 * @param message : the messages the transition receives, if any.
+	 */
+	void saveState(t_transtype type, const std::vector<n_network::t_msgptr>* message = nullptr);
+
+	/**
+	 * @brief Undoes all transitions at or after time with the reverse handlers.
+	 */
+	void revertReversible(const t_timestamp& time);
+
+	/**
+	 * @brief Forgets the undo records of transitions before gvt.
+	 */
+	void setGVTReversible(const t_timestamp& gvt);
+
+	/**
+	 * @brief Restores the last checkpoint before time and replays the logged transitions up to time.
+	 */
+	void revertCheckpoint(const t_timestamp& time);
+
+	/**
+	 * @brief Forgets all checkpoints and logged transitions not needed for a revert to a time >= gvt.
+	 */
+	void setGVTCheckpoint(const t_timestamp& gvt);
+
+	/**
+	 * @brief Sets a new checkpoint interval from the fraction of transitions that were reverted.
+	 */
+	void adaptCheckpointInterval();
+
+	/**
+	 * @return the time of the logged transition at index.
+	 */
+	const t_timestamp& transitionTime(std::size_t index) const
+	{
+		return (index + 1 < m_transitions.size())? m_transitions[index + 1].m_timeLast: m_timeLast;
+	}
+
 	/**
 	 * @brief delivers all the messages to the correct port
 	 */
@@ -87,6 +180,60 @@ protected:
 	t_timestamp m_elapsed;
 	t_timestamp m_lastRead;
 
+	/**
+	 * @brief Opt in to reverse computation, call this in the constructor of your model.
+	 * A reversible model implements reverseIntTransition, reverseExtTransition and (if confTransition
+	 * is overridden) reverseConfTransition. In optimistic simulation its state is no longer copied
+	 * before each transition, instead a revert runs the reverse handlers of the undone transitions,
+	 * the last transition first.
+	 * @note Any information a transition destroys (e.g. a popped value) must be saved with pushUndo.
+	 */
+	void setReversible(bool b)
+	{ m_reversible = b; }
+
+	/**
+	 * @brief Declare a lookahead that never changes, call this in the constructor of your model.
+	 * The conservative core then uses this value and no longer calls lookAhead().
+	 * @pre la is not zero.
+	 */
+	void setStaticLookahead(t_timestamp la)
+	{
+		assert(!isZero(la) && "A static lookahead can't be zero.");
+		m_staticLookahead = la;
+	}
+
+	/**
+	 * @brief Saves a value for the reverse handler of the current transition.
+	 * Only to be called from a transition function. No-op if the model is not reversible or old states aren't kept (non optimistic simulation).
+	 * @tparam T : trivially copyable, at most the size of a std::size_t.
+	 */
+	template<typename T>
+	void pushUndo(const T& value)
+	{
+		static_assert(sizeof(T) <= sizeof(std::size_t) && std::is_trivially_copyable<T>::value,
+			"pushUndo only stores values that fit in a word.");
+		if(!m_keepOldStates || !m_reversible)
+			return;
+		std::size_t word = 0;
+		std::memcpy(&word, &value, sizeof(T));
+		m_undoValues.push_back(word);
+		++m_transitions.back().m_values;
+	}
+
+	/**
+	 * @brief Returns the last value saved with pushUndo by the transition being reversed.
+	 * Only to be called from a reverse handler, values are popped in reverse order of pushUndo.
+	 */
+	template<typename T>
+	T popUndo()
+	{
+		assert(!m_undoValues.empty() && "popUndo without matching pushUndo.");
+		T value;
+		std::memcpy(&value, &m_undoValues.back(), sizeof(T));
+		m_undoValues.pop_back();
+		return value;
+	}
+
 public:
 
 	static constexpr t_transtype NONE=0;
@@ -95,6 +242,13 @@ public:
 	static constexpr t_transtype CONF=INT|EXT;   // EXT | INT
 	static_assert(NONE != EXT && EXT != INT && INT != CONF && EXT != CONF && NONE != CONF, "");
 
+	/// Checkpoint interval that lets the model tune its interval to how often it is reverted.
+	static constexpr std::size_t CHECKPOINT_ADAPTIVE = 0;
+	/// Checkpoint interval that leaves the choice to the simulation core.
+	static constexpr std::size_t CHECKPOINT_DEFAULT = std::numeric_limits<std::size_t>::max();
+	/// Upper bound for an adaptive checkpoint interval.
+	static constexpr std::size_t CHECKPOINT_MAX = 64;
+
 	AtomicModel_impl() = delete;
 
 	/**
@@ -261,6 +415,57 @@ public:
 	 */
 	virtual void confTransition(const std::vector<n_network::t_msgptr> & message);
 
+	/**
+	 * Undo an internal transition, restoring the state from before intTransition.
+	 * The time and elapsed time of the model are those of the transition being undone.
+	 * @warning This function MUST be implemented by a reversible model.
+	 * @see setReversible
+	 */
+	virtual void reverseIntTransition();
+
+	/**
+	 * Undo an external transition.
+	 * @param messages The nr of messages the transition received.
+	 * @attention The messages themselves can be destroyed by the time of the revert,
+	 * save anything from their content the reverse handler needs with pushUndo.
+	 * @warning This function MUST be implemented by a reversible model.
+	 * @see setReversible
+	 */
+	virtual void reverseExtTransition(std::size_t messages);
+
+	/**
+	 * Undo a confluent transition.
+	 * The default implementation undoes the default confTransition : first reverseExtTransition, then reverseIntTransition.
+	 * @param messages The nr of messages the transition received.
+	 */
+	virtual void reverseConfTransition(std::size_t messages);
+
+	/**
+	 * @return true if the model uses reverse computation instead of state copies.
+	 */
+	bool isReversible() const
+	{ return m_reversible; }
+
+	/**
+	 * @brief Sets the nr of transitions between state copies in optimistic simulation.
+	 * In between copies the model logs its transitions. A revert restores the last copy before the revert time
+	 * and coasts forward by replaying the logged transitions, trading revert time for less copying.
+	 * @param interval : a fixed interval (1 copies the state before each transition), CHECKPOINT_ADAPTIVE
+	 * or CHECKPOINT_DEFAULT (the default) to use the interval of the simulation core.
+	 * @attention A replayed transition must only depend on the state, the elapsed time and the messages it receives,
+	 * members outside the state are not restored.
+	 * @note Ignored by reversible models.
+	 * @pre Called before the simulation starts.
+	 */
+	void setCheckpointInterval(std::size_t interval)
+	{ m_checkpointSetting = interval; }
+
+	/**
+	 * @return The checkpoint interval currently in use.
+	 */
+	std::size_t getCheckpointInterval() const
+	{ return m_checkpointInterval; }
+
 	/**
 	 * Transitions the model confluently with given messages, this function will call the user-implemented confTransition
 	 * function and will also store all messages properly for the tracer to find them
@@ -296,6 +501,15 @@ public:
 		return t_timestamp(0);
 	}
 
+	/**
+	 * @return the static lookahead if the model declared one, else lookAhead().
+	 * @see setStaticLookahead
+	 */
+	t_timestamp getLookahead() const
+	{
+		return isZero(m_staticLookahead)? lookAhead() : m_staticLookahead;
+	}
+
 	/**
 	 * Get the current output
 	 *
@@ -327,6 +541,21 @@ public:
 	 */
 	void setGVT(t_timestamp gvt);
 
+	/**
+	 * @return The nr of saved states and logged transitions kept for a possible revert.
+	 */
+	std::size_t getHistorySize() const
+	{ return m_oldStates.size() + m_transitions.size(); }
+
+	/**
+	 * @return The nr of transitions, including the ones undone by a revert, since the last resetEvents.
+	 */
+	std::size_t getEvents() const
+	{ return m_events; }
+
+	void resetEvents()
+	{ m_events = 0; }
+
 	/**
 	 * Reverts the model the given time
 	 *
@@ -351,6 +580,23 @@ public:
 	void setTime(t_timestamp time);
 
 
+	/**
+	 * @brief Keep the times of a snapshot instead of starting at the time of the core.
+	 * The causality of the times is that of this model, not that of the model that saved them.
+	 * @see n_control::Controller::loadSnapshot
+	 */
+	void restoreTime(t_timestamp timeLast, t_timestamp timeNext);
+
+	/**
+	 * @return true once after restoreTime, the core initializing the model then keeps the restored times.
+	 */
+	bool takeRestoredTime()
+	{
+		const bool restored = m_restored;
+		m_restored = false;
+		return restored;
+	}
+
 	/**
 	 * Gets the corenumber this model wants to be on
 	 *
@@ -397,20 +643,35 @@ public:
 #endif
     }
 
-	void prepareSimulation()
+	/**
+	 * @param checkpointInterval : the checkpoint interval to use if the model did not set one.
+	 * @see setCheckpointInterval
+	 */
+	void prepareSimulation(std::size_t checkpointInterval = 1)
 	{
-	        if(m_keepOldStates){
+	        if(m_keepOldStates && !m_reversible){
 	                assert(m_oldStates.empty() && "There are still some straggler states left.");
 	                t_stateptr newState = m_state->copyPooledState();
 	                m_oldStates.push_back(newState);
 	                delete m_state;
 	                m_state = newState;
+	                const std::size_t interval = (m_checkpointSetting == CHECKPOINT_DEFAULT)? checkpointInterval: m_checkpointSetting;
+	                m_coastForward = (interval != 1);
+	                m_checkpointInterval = (interval == CHECKPOINT_ADAPTIVE)? 1: interval;
+	                m_sinceCheckpoint = std::numeric_limits<std::size_t>::max();        // The first transition takes a checkpoint.
+	                m_windowTransitions = 0;
+	                m_windowReverts = 0;
 	        }
 	}
 
 	void exitSimulation()
 	{
-            if(m_keepOldStates){
+            m_transitions.clear();
+            for(n_network::t_msgptr msg : m_logMessages)
+                    msg->releaseMe();
+            m_logMessages.clear();
+            m_undoValues.clear();
+            if(m_keepOldStates && !m_reversible){
                     assert(m_oldStates.size() && "State vector is empty after simulation is done.");
                     t_stateptr newState = m_state->copyState();
                     for(t_stateptr st: m_oldStates){
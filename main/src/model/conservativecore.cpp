@@ -20,7 +20,8 @@ namespace n_model {
 Conservativecore::Conservativecore(const t_networkptr& n, std::size_t coreid, std::size_t totalCores,
 	const t_eotvector& vc, const t_timevector& tc)
 	: Core(coreid, totalCores),
-	m_network(n),m_eit(0u), m_distributed_eot(vc),m_distributed_time(tc),m_min_lookahead(0u,0u),m_last_sent_msgtime(t_timestamp::infinity())
+	m_network(n),m_eit(0u), m_distributed_eot(vc),m_distributed_time(tc),m_min_lookahead(0u,0u),m_last_sent_msgtime(t_timestamp::infinity()),
+	m_wait(nullptr), m_stalledInRow(0)
 {
         if(totalCores==m_distributed_time->size())
                 throw std::logic_error("NLTIME not aligned properly. !!");
@@ -35,6 +36,8 @@ void Conservativecore::getMessages()
                 LOG_INFO("CCORE :: ", this->getCoreID(), " received ", messages.size(), " messages. ");
                 if(isLive())
                         this->sortIncoming(messages);
+                else
+                        releaseMessages(messages);
         }
 }
 
@@ -112,6 +115,8 @@ void Conservativecore::updateEOT()
 
 void Conservativecore::setEot(t_timestamp ntime){       // Fact that def is here matters not for inlining, TU where this is called is always this class only.
                 m_distributed_eot->set(this->getCoreID(), ntime.getTime());
+                if(m_wait)
+                        m_wait->notify();
 }
 
 
@@ -177,8 +182,6 @@ void Conservativecore::syncTime(){
 	}
         
         this->updateDGVT();
-        if(m_sent_messages.size()>GC_COLLECT_THRESHOLD)
-                gcCollect();
 }
 
 void Conservativecore::setTime(const t_timestamp& newtime){
@@ -217,6 +220,17 @@ void Conservativecore::queuePendingMessage(t_msgptr msg){
 }
 
 void Conservativecore::init(){
+	/// A core that continues a simulation starts over from the initial synchronization values.
+	m_eit = 0u;
+	m_min_lookahead = t_timestamp(0u, 0u);
+	m_last_sent_msgtime = t_timestamp::infinity();
+	m_stalledInRow = 0;
+	m_influencees.clear();
+	m_distributed_eot->set(this->getCoreID(), 0u);
+	m_distributed_time->set(this->getCoreID(), std::numeric_limits<t_timestamp::t_time>::max());
+	if(!this->getCoreID())
+		setDGVT(0u);
+
 	/// Get first time, offset all models if required
 	Core::init();
 
@@ -224,6 +238,12 @@ void Conservativecore::init(){
 	buildInfluenceeMap();
 
 	/// Get first lookahead.
+        m_lookaheads.clear();
+        m_lookaheads.hintSize(m_indexed_models.size());
+        m_la_stale.clear();
+        m_la_isstale.assign(m_indexed_models.size(), false);
+        for(const auto& model : m_indexed_models)
+                updateLookahead(model.get());
         this->calculateMinLookahead();
 }
 
@@ -254,6 +274,10 @@ bool Conservativecore::timeStalled(){
 
 void Conservativecore::signalTransition()
 {
+        for(auto model : m_imminents)
+                markLookahead(model);
+        for(auto model : m_externs)
+                markLookahead(model);
         calculateMinLookahead();
 }
 
@@ -262,17 +286,23 @@ void Conservativecore::runSmallStep(){
         if(timeStalled() ){             // EIT==TIME
                 LOG_DEBUG("CCORE :: ", this->getCoreID(), " EIT==TIME ");
                 m_stats.logStat(STAT_TYPE::STALLEDROUNDS);
+                // Read before the shared values, a change after this wakes us.
+                const std::size_t seen = m_wait? m_wait->getVersion() : 0;
                 this->runSmallStepStalled();
                 if(checkNullRelease()){                 // If all influencing cores nulltime >= our nulltime, don't waste another round and immediately continue.                
+                        m_stalledInRow = 0;
                         Core::runSmallStep();   
                 }else{                                  // At least one influencing core < our nulltime, wait, but update EOT/EIT to signal others.
                         updateEOT();            
                         updateEIT();
-                        // Don't yield, this is nearly always slower.
+                        // The first rounds spin, this is nearly always faster. Then back off.
+                        if(m_wait && timeStalled())
+                                m_wait->wait(++m_stalledInRow, seen);
                 }
         }                               // EIT > TIME
         else{ 
                 LOG_DEBUG("CCORE :: ", this->getCoreID(), " EIT < TIME ");
+                m_stalledInRow = 0;
                 Core::runSmallStep();   
         }
 }
@@ -307,7 +337,6 @@ void Conservativecore::sortMail(const std::vector<t_msgptr>& messages)
 		if (not this->isMessageLocal(message)) {
                         m_stats.logStat(MSGSENT);
 			m_externalMessages[message->getDestinationCore()].push_back(message);
-                        m_sent_messages.push_back(message);
 			// At output collection, timestamp is set (the rest is of no interest to us here).
 			this->m_last_sent_msgtime = message->getTimeStamp();
 			LOG_DEBUG("\tCCORE :: ", this->getCoreID(), " queued message ", message->toString());
@@ -324,14 +353,8 @@ void Conservativecore::clearProcessedMessages(std::vector<t_msgptr>& msgs)
                 throw std::logic_error("Msgs empty after processing ?");
 #endif
         /// Msgs is a vector of processed msgs, stored in m_local_indexed_mail.
-        for(t_msgptr ptr : msgs){
-                if(ptr->getSourceCore()==this->getCoreID() && ptr->getDestinationCore()==this->getCoreID()){ 
-                        LOG_DEBUG("CORE:: ", this->getCoreID(), " deleting ", ptr);
-                        m_stats.logStat(DELMSG);
-                        ptr->releaseMe();
-                }
-        }
-        
+        /// Remote messages go back to the sender's pool on its next allocation.
+        releaseMessages(msgs);
         msgs.clear();
 }
 
@@ -388,26 +411,44 @@ Conservativecore::calculateMinLookahead(){
          */
         if(this->m_min_lookahead.getTime() <= getTime().getTime() 
                 && !isInfinity(this->m_min_lookahead)){
-                m_min_lookahead = t_timestamp::infinity();
-                for(const auto& model : m_indexed_models){
-                        const t_timestamp la = model->lookAhead();
-                        //LOG_DEBUG("Core :: ", this->getCoreID()," Model :: ", model->getName(), " gave LA = ", la);
-#ifdef SAFETY_CHECKS
-                        if(isZero(la))
-                                throw std::logic_error("Lookahead can't be zero");
-#endif                        
-                        if(isInfinity(la))
-                                continue;
-                        
-                        const t_timestamp last = model->getTimeLast();
-                        m_min_lookahead = std::min(m_min_lookahead, (last+la));
+                for(std::size_t id : m_la_stale){
+                        m_la_isstale[id] = false;
+                        updateLookahead(m_indexed_models[id].get());
                 }
+                m_la_stale.clear();
+                m_min_lookahead = m_lookaheads.empty()? t_timestamp::infinity() : m_lookaheads.top().getTime();
                 LOG_DEBUG("CCORE:: ", this->getCoreID(), " time: ", getTime(), " Lookahead updated to ", m_min_lookahead);
         }else{
                 LOG_DEBUG("CCORE:: ", this->getCoreID(), " time: ", getTime(), " Lookahead < time , skipping calculation. : ", m_min_lookahead);
         }
 }
 
+void
+Conservativecore::markLookahead(const AtomicModel_impl* model)
+{
+        const std::size_t id = model->getLocalID();
+        if(!m_la_isstale[id]){
+                m_la_isstale[id] = true;
+                m_la_stale.push_back(id);
+        }
+}
+
+void
+Conservativecore::updateLookahead(const AtomicModel_impl* model)
+{
+        const t_timestamp la = model->getLookahead();
+        //LOG_DEBUG("Core :: ", this->getCoreID()," Model :: ", model->getName(), " gave LA = ", la);
+#ifdef SAFETY_CHECKS
+        if(isZero(la))
+                throw std::logic_error("Lookahead can't be zero");
+#endif
+        const LaEntry entry(model->getLocalID(), model->getTimeLast()+la);
+        if(isInfinity(la))
+                m_lookaheads.erase(entry);
+        else
+                m_lookaheads.update(entry);
+}
+
 void
 Conservativecore::getPendingMail()
 {
@@ -450,62 +491,27 @@ Conservativecore::updateDGVT()
         }
 }
 
-void 
-Conservativecore::gcCollect()
+void
+Conservativecore::releaseMessages(const std::vector<t_msgptr>& msgs)
 {
-        /** GVT is point in time that all cores have passed. 
-         *  So messages with timestamp <= gvt are safe to delete.
-         */
-        if(m_sent_messages.empty())
-                return;
-        t_timestamp::t_time dgvt = getDGVT();
-        if(std::numeric_limits<t_timestamp::t_time>::max()==dgvt){
-                LOG_DEBUG("CCORE:: ", this->getCoreID(), " time: ", getTime(), " DGVT  ==  inf, skipping gccollect. ");
-                return;
-        }else
-        {
-                std::deque<t_msgptr>::iterator iter = m_sent_messages.begin();
-                for(; iter != m_sent_messages.end(); ++iter){
-                        t_msgptr mptr = *iter;// debugging
-                        if(mptr->getTimeStamp().getTime()>= dgvt){
-                                break;
-                        }
-                        else{
-                                LOG_DEBUG("CORE:: ", this->getCoreID(), " deleting ", mptr);
-                                m_stats.logStat(DELMSG);
-                                mptr->releaseMe();
-                        }
-                }
-                // Erase [begin, found)
-                if(std::distance(m_sent_messages.begin(), iter)){
-                        LOG_DEBUG("CCORE:: ", this->getCoreID(), " time: ", getTime(), " gccollect erasing ::  ", std::distance(m_sent_messages.begin(),iter));
-                        m_sent_messages.erase(m_sent_messages.begin(), iter);
-                }
+        for(t_msgptr ptr : msgs){
+                LOG_DEBUG("CORE:: ", this->getCoreID(), " deleting ", ptr);
+                m_stats.logStat(DELMSG);
+                ptr->releaseMe();
         }
 }
 
-
-
 void
 Conservativecore::shutDown()
 {
         Core::shutDown(); // old tracing msgs.
-        // @pre : for_each ptr : destination has processed the message. 
-        for(t_msgptr ptr : m_sent_messages)
-        {
-                LOG_DEBUG("CCORE:: ", this->getCoreID(), " clearState:: deleting ", ptr);
-                m_stats.logStat(DELMSG);
-                // In future, move this into a ifdef safety checks.
-                size_t destid = ptr->getDestinationCore();
-                t_timestamp::t_time recv_time = m_distributed_time->get(destid);        
-                if(recv_time <= ptr->getTimeStamp().getTime() && recv_time!=this->getTerminationTime().getTime()){
-                        LOG_ERROR("Pointer : " , ptr, " with receiver id ", destid, " nulltime = ", recv_time, " msgtime = ", ptr->getTimeStamp());
-                        LOG_FLUSH;
-                }else{
-                        ptr->releaseMe();
-                }
-        }
-        m_sent_messages.clear(); // Should this function ever be called twice, make sure we don't actually delete things twice.
+        // @pre : all cores have stopped sending, so what is left for us is past the termination time.
+        std::vector<t_msgptr> left;
+        while(!m_received_messages->empty())
+                left.push_back(m_received_messages->pop().getMessage());
+        releaseMessages(left);
+        if(this->m_network->havePendingMessages(this->getCoreID()))
+                releaseMessages(this->m_network->getMessages(this->getCoreID()));
 }
 
 } /* namespace n_model */
@@ -10,7 +10,10 @@
 #include <unordered_map>
 #include "model/core.h"
 #include "tools/sharedvector.h"
+#include "tools/waitstrategy.h"
 #include "model/laentry.h"
+#include "scheduler/vectorscheduler.h"
+#include <boost/heap/pairing_heap.hpp>
 
 #ifndef SRC_MODEL_CONSERVATIVECORE_H_
 #define SRC_MODEL_CONSERVATIVECORE_H_
@@ -18,17 +21,17 @@
 namespace n_model {
 
 
-/**
- * If a simulator collects more than <value> sent messages, try to garbage collect them.
- */
-static constexpr size_t GC_COLLECT_THRESHOLD=1024ull;
-
 /**
  * Stores the maximum of EOT values per kernel.
  */
 typedef std::shared_ptr<n_tools::SharedAtomic<t_timestamp::t_time>> t_eotvector;
 typedef std::shared_ptr<n_tools::SharedAtomic<t_timestamp::t_time>> t_timevector;
 
+/**
+ * Indexed min heap of (model local id, time of last transition + lookahead).
+ */
+typedef n_scheduler::VectorScheduler<boost::heap::pairing_heap<LaEntry>, LaEntry> t_lascheduler;
+
 /**
  * @brief Conservative formalism implementation of parallel simulation.
  *
@@ -90,6 +93,17 @@ private:
 	 * Minimum lookahead for all transitioned models in a simulation step.
 	 */
 	t_timestamp		m_min_lookahead;
+
+	/**
+	 * Absolute lookahead of each model with a finite lookahead, updated for the models that transitioned.
+	 */
+	t_lascheduler		m_lookaheads;
+
+	/**
+	 * Local ids of the models that transitioned since m_lookaheads was last updated, each id once.
+	 */
+	std::vector<std::size_t>	m_la_stale;
+	std::vector<bool>		m_la_isstale;
         
         /**
          * Timestamp of the last message we've sent to any other core.
@@ -98,9 +112,14 @@ private:
         t_timestamp             m_last_sent_msgtime;
         
         /**
-         * GCCollected store. Messages are destroyed at gvt.
+         * Backoff for stalled rounds, shared with the other cores. nullptr : stalled rounds spin.
+         */
+        n_tools::t_waitstrategyptr m_wait;
+
+        /**
+         * Nr of consecutive stalled rounds that could not release.
          */
-        std::deque<t_msgptr>   m_sent_messages;
+        std::size_t m_stalledInRow;
         
         
         
@@ -155,7 +174,12 @@ private:
          */
         t_timestamp::t_time getNullTime()const{return m_distributed_time->get(this->getCoreID());}
         
-        void setNullTime(t_timestamp::t_time nlt){m_distributed_time->set(this->getCoreID(), nlt);}
+        void setNullTime(t_timestamp::t_time nlt)
+        {
+                m_distributed_time->set(this->getCoreID(), nlt);
+                if(m_wait)
+                        m_wait->notify();
+        }
         
         /**
          * @attention : synchronized (write/read)
@@ -168,20 +192,25 @@ private:
         t_timestamp getEot()const{return m_distributed_eot->get(this->getCoreID());} // read/read
         
         /**
-         * Only clear locally generated messages. Remotely received we ignore. (sender destroys).
+         * Release all processed messages, remotely received ones included (the pools accept frees from any thread).
          * @param msgs
          */
         virtual void clearProcessedMessages(std::vector<t_msgptr>& msgs)override;
 
         /**
-         * Collect all messages with timestamp < gvt.
+         * Release msgs, local or remote.
          */
         void
-        gcCollect();
+        releaseMessages(const std::vector<t_msgptr>& msgs);
         
 protected:
         virtual void queuePendingMessage(t_msgptr msg)override;
 
+        /**
+         * Output can go to other cores, so it's always collected by this thread.
+         */
+        virtual bool canCollectOutputParallel() const override{return false;}
+
 
         std::vector<std::vector<t_msgptr>> m_externalMessages;
         
@@ -203,6 +232,16 @@ public:
 		const t_eotvector& vc, const t_timevector& tc);
 	virtual ~Conservativecore();
 
+        /**
+         * Wait with strategy w in stalled rounds that can't advance, instead of spinning.
+         * The same strategy has to be set on all cores, they wake each other when they publish a new eot or null time.
+         * @pre Called before the simulation starts.
+         */
+        void setWaitStrategy(const n_tools::t_waitstrategyptr& w)
+        {
+                m_wait = w;
+        }
+
 	/**
 	 * In theory, in a distributed setting we need access to getMessages() to get an EOT value.
 	 * For us, this is NOT required (shared memory).
@@ -276,10 +315,25 @@ public:
 	bool
 	existTransientMessage()override;
         
+        /**
+         * Mark the lookahead of the model stale, it is queried the next time the minimum is calculated.
+         */
+        void
+        markLookahead(const AtomicModel_impl* model);
+
+        /**
+         * Record the absolute lookahead (time last + lookahead) of a model in m_lookaheads.
+         * Models with infinite lookahead are left out.
+         * @throw std::logic_error if the model returns a zero lookahead value.
+         */
+        void
+        updateLookahead(const AtomicModel_impl* model);
+
         /**
          * If time >= min_lookahead, calculate the next minimal value.
-         * @attention We need to query all models (regardless if they have made a transition this turn), to avoid skipping
-         * minimal values. See the inline docs for a counterexample.
+         * @attention We need the value of all models (regardless if they have made a transition this turn), to avoid skipping
+         * minimal values. See the inline docs for a counterexample. Only the models that transitioned have a new value,
+         * signalTransition marks these, so only they are queried and updated in m_lookaheads, the minimum is its top.
          * LA is needed by eot calculation, and best done before time advances.
          * @pre lookahead() returns a non zero value (@see t_timestamp::isZero())
          * @post the lookahead value of this core is updated to a new floating minimum (in absolute time)
@@ -309,10 +363,9 @@ public:
 
         
         /**
-         * @pre : simulation is done, calling thread id == current thread id
-         * @pre : all simthreads have either terminated, or at null message time > any sent message to them.
-         * @post : all sent messages not purged by gccollect are destroyed, as are all messages kept for tracing.
-         * @throws : std::logic_error if we can prove a message is still in use.
+         * @pre : simulation is done, all cores have stopped sending.
+         * @pre : the threads owning the pools of the senders have not exited.
+         * @post : all received but unprocessed messages are destroyed, as are all messages kept for tracing.
          * @attention : call this once only.
          */
         virtual
@@ -56,8 +56,8 @@ n_model::Core::Core(std::size_t id, std::size_t totalCores)
                 m_terminated(false),
                 m_terminated_functor(false), m_cores(totalCores), m_msgStartCount(id*(std::numeric_limits<std::size_t>::max()/totalCores)),
                 m_msgEndCount((id+1)*(std::numeric_limits<std::size_t>::max()/totalCores)-1), m_msgCurrentCount(m_msgStartCount),
-                m_token(n_tools::createRawObject<n_network::Message>(uuid(0,0), uuid(0,0), m_time, 0, 0)),m_zombie_rounds(0),
-		m_received_messages(n_scheduler::SchedulerFactory<MessageEntry>::makeScheduler(n_scheduler::Storage::FIBONACCI, false, n_scheduler::KeyStorage::NONE)),
+                m_token(n_tools::createRawObject<n_network::Message>(uuid(0,0), uuid(0,0), m_time, 0, 0)),m_parallelOutput(false),m_zombie_rounds(0), m_history(0),
+		m_received_messages(std::make_shared<t_msgscheduler::element_type>()),
 		m_stats(m_coreid)
                 
 {
@@ -108,12 +108,16 @@ void n_model::Core::init()
 		return;
 	}
         this->initializeModels();
+        if(m_profile)
+                m_profile->setModels(m_indexed_models);
 
         m_heap.reserve(m_indexed_models.size());
         
 	for (auto& model : this->m_indexed_models) {
-		const t_timestamp modelTime(this->getTime().getTime() - model->getTimeElapsed().getTime(),0);
-		model->setTime(modelTime);	// DO NOT use priority, model does this already
+		if (!model->takeRestoredTime()) {
+			const t_timestamp modelTime(this->getTime().getTime() - model->getTimeElapsed().getTime(),0);
+			model->setTime(modelTime);	// DO NOT use priority, model does this already
+		}
 		m_heap.push_back(model.get());
                 if(m_tracers){
                         m_tracers->tracesInit(model, t_timestamp(0, model->getPriority()));
@@ -148,6 +152,10 @@ void n_model::Core::initializeModels()
 void n_model::Core::collectOutput(std::vector<t_raw_atomic>& imminents)
 {
 	LOG_DEBUG("\tCORE :: ", this->getCoreID(), " Collecting output for ", imminents.size(), " imminents ");
+        if(canCollectOutputParallel() && useForkJoin(imminents.size())){
+                collectOutputParallel(imminents);
+                return;
+        }
         m_mailfrom.clear();
 	for (auto model : imminents) {
 		model->doOutput(m_mailfrom);
@@ -158,6 +166,8 @@ void n_model::Core::collectOutput(std::vector<t_raw_atomic>& imminents)
                         validateUUID(uuid(msg->getSourceCore(),msg->getSourceModel()));
 		}
 #endif
+                if(m_profile)
+                        m_profile->countMessages(m_mailfrom);
                 
 		this->sortMail(m_mailfrom);	// <-- Locked here on msglock. Don't pop_back, single clear = O(1)
                 m_mailfrom.clear();
@@ -204,18 +214,17 @@ void n_model::Core::transition()
 	t_timestamp noncausaltime(this->getTime().getTime(), 0);
 
 	const std::size_t k = m_imminents.size() + m_externs.size();
-#ifndef PDEVS 	
         m_heap.signalUpdateSize(k);
 	LOG_DEBUG("\tCORE :: ", this->getCoreID(), "calculating whether we should reschedule one by one: k=", k, " N=", m_indexed_models.size(), " oneByOne=", m_heap.doSingleUpdate());
-#endif
+
+        if(m_parallelOutput || useForkJoin(k)){
+                transitionParallel(noncausaltime);
+                if(k)
+                        signalTransition();
+                return;
+        }
      
-#ifdef PDEVS        
-#pragma omp parallel for num_threads( PDEVS_THREADS )
-        for (std::vector<t_raw_atomic>::iterator it = m_imminents.begin(); it < m_imminents.end(); ++it){
-                auto imminent = *it;
-#else
 	for (t_raw_atomic imminent : m_imminents) {
-#endif
                 const size_t modelid = imminent->getLocalID();
                 LOG_DEBUG("\tCORE :: ", this->getCoreID(), " imminent nextType() = ", int(imminent->nextType()));
 		if (!hasMail(modelid)) {
@@ -225,6 +234,8 @@ void n_model::Core::transition()
                         imminent->setTimeElapsed(imminent->getTimeNext() - imminent->getTimeLast());
 			imminent->doIntTransition();
 			imminent->setTime(noncausaltime);
+			if(m_profile)
+				m_profile->countTransition(*imminent);
 			this->traceInt(getModel(modelid));
 		} else {
                         LOG_DEBUG("\tCORE :: ", this->getCoreID(), " performing confluent transition for model ", imminent->getName());
@@ -234,27 +245,21 @@ void n_model::Core::transition()
                         std::vector<t_msgptr>& mail = getMail(modelid);
 			imminent->doConfTransition(mail);
 			imminent->setTime(noncausaltime);
+			if(m_profile)
+				m_profile->countTransition(*imminent);
 			this->traceConf(getModel(modelid));
 			clearProcessedMessages(mail);
                         assert(!hasMail(modelid) && "After confluent transition, model may no longer have pending mail.");
 		}
                 imminent->clearSentMessages();
                 LOG_DEBUG("\tCORE :: ", this->getCoreID(), " fixing scheduler heap.");
-#ifndef PDEVS                
 		if(m_heap.doSingleUpdate())
 			m_heap.update(modelid);
-#endif
                 LOG_DEBUG("\tCORE :: ", this->getCoreID(), " result.");
 	}
                 
         LOG_DEBUG("\tCORE :: ", this->getCoreID(), " Transitioning with ", m_externs.size(), " externs");
-#ifdef PDEVS
-#pragma omp parallel for num_threads(4)
-        for (std::vector<t_raw_atomic>::iterator it = m_externs.begin(); it < m_externs.end(); ++it){
-                auto external = *it;
-#else
         for(auto external : m_externs){
-#endif
                 LOG_DEBUG("\tCORE :: ", this->getCoreID(), " performing external transition for model ", external->getName());
                 const size_t id = external->getLocalID();
                 auto& mail = getMail(id);
@@ -264,14 +269,14 @@ void n_model::Core::transition()
                 assert(external->nextType() == AtomicModel_impl::EXT);
                 external->markNone();
 		external->setTime(noncausaltime);
+		if(m_profile)
+			m_profile->countTransition(*external);
 		this->traceExt(getModel(id));
 
                 clearProcessedMessages(mail);
                 LOG_DEBUG("\tCORE :: ", this->getCoreID(), " fixing scheduler heap.");
-#ifndef PDEVS
 		if(m_heap.doSingleUpdate())
 			m_heap.update(id);
-#endif
                 LOG_DEBUG("\tCORE :: ", this->getCoreID(), " result.");                
 		assert(!hasMail(id) && "After external transition, model may no longer have pending mail.");
 	}
@@ -280,6 +285,168 @@ void n_model::Core::transition()
                 signalTransition();
 }
 
+void n_model::Core::transitionParallel(const t_timestamp& noncausaltime)
+{
+        LOG_DEBUG("\tCORE :: ", this->getCoreID(), " Transitioning ", m_imminents.size(), " imminents and ", m_externs.size(), " externs on ", m_forkjoin->threads(), " threads");
+        // A transition only touches its own model and mail, the scheduler, tracers and message release are left to this thread.
+        m_forkjoin->parallelFor(m_imminents.size(), [&](std::size_t begin, std::size_t end, std::size_t)->void{
+                for(std::size_t i = begin; i < end; ++i){
+                        t_raw_atomic imminent = m_imminents[i];
+                        const size_t modelid = imminent->getLocalID();
+                        assert(imminent->nextType() == (hasMail(modelid)? AtomicModel_impl::CONF : AtomicModel_impl::INT));
+                        imminent->markNone();
+                        imminent->setTimeElapsed(imminent->getTimeNext() - imminent->getTimeLast());
+                        if(!hasMail(modelid))
+                                imminent->doIntTransition();
+                        else
+                                imminent->doConfTransition(getMail(modelid));
+                        imminent->setTime(noncausaltime);
+                }
+        });
+        m_forkjoin->parallelFor(m_externs.size(), [&](std::size_t begin, std::size_t end, std::size_t)->void{
+                for(std::size_t i = begin; i < end; ++i){
+                        t_raw_atomic external = m_externs[i];
+                        external->setTimeElapsed(noncausaltime.getTime() - external->getTimeLast().getTime());
+                        external->doExtTransition(getMail(external->getLocalID()));
+                        assert(external->nextType() == AtomicModel_impl::EXT);
+                        external->markNone();
+                        external->setTime(noncausaltime);
+                }
+        });
+
+        for (t_raw_atomic imminent : m_imminents) {
+                const size_t modelid = imminent->getLocalID();
+                if(!hasMail(modelid)){
+                        this->traceInt(getModel(modelid));
+                } else {
+                        this->traceConf(getModel(modelid));
+                        releaseMail(getMail(modelid));
+                }
+                if(!m_parallelOutput)
+                        imminent->clearSentMessages();
+		if(m_heap.doSingleUpdate())
+			m_heap.update(modelid);
+        }
+        for (t_raw_atomic external : m_externs) {
+                const size_t id = external->getLocalID();
+                this->traceExt(getModel(id));
+                releaseMail(getMail(id));
+		if(m_heap.doSingleUpdate())
+			m_heap.update(id);
+        }
+        if(m_parallelOutput)
+                releaseParallelOutput();
+}
+
+void n_model::Core::releaseMail(std::vector<t_msgptr>& msgs)
+{
+        if(!m_parallelOutput){
+                clearProcessedMessages(msgs);
+                return;
+        }
+        for(std::size_t i = 0; i < msgs.size(); ++i)
+                m_stats.logStat(DELMSG);
+        msgs.clear();
+}
+
+void n_model::Core::collectOutputParallel(std::vector<t_raw_atomic>& imminents)
+{
+        const std::size_t slots = m_forkjoin->threads();
+        m_slotmail.resize(slots);
+        m_slotranges.resize(slots);
+        m_slotexterns.resize(slots);
+        m_forkjoin->parallelFor(imminents.size(), [&](std::size_t begin, std::size_t end, std::size_t slot)->void{
+                std::vector<t_msgptr>& mail = m_slotmail[slot];
+                const std::size_t from = mail.size();
+                for(std::size_t i = begin; i < end; ++i)
+                        imminents[i]->doOutput(mail);
+#ifdef SAFETY_CHECKS
+                for(std::size_t i = from; i < mail.size(); ++i)
+                        validateUUID(uuid(mail[i]->getSourceCore(), mail[i]->getSourceModel()));
+#endif
+                m_slotranges[slot].push_back(OutputRange{begin, end, slot, from, mail.size()});
+        });
+        m_outputranges.clear();
+        for(auto& ranges : m_slotranges){
+                m_outputranges.insert(m_outputranges.end(), ranges.begin(), ranges.end());
+                ranges.clear();
+        }
+        std::sort(m_outputranges.begin(), m_outputranges.end(),
+                [](const OutputRange& l, const OutputRange& r)->bool{return l.m_begin < r.m_begin;});
+        m_parallelOutput = true;
+        sortMailParallel();
+}
+
+void n_model::Core::sortMailParallel()
+{
+        const std::size_t slots = m_forkjoin->threads();
+        // The causality of the i'th message is the counter sortMail would have given it, without the wraparound overflowing.
+        const std::size_t span = m_msgEndCount - m_msgStartCount + 1;
+        const std::size_t first = m_msgCurrentCount - m_msgStartCount;
+        auto causality = [=](std::size_t index)->std::size_t{
+                const std::size_t r = index % span;
+                return m_msgStartCount + (r >= span - first ? r - (span - first) : first + r);
+        };
+        std::size_t total = 0;
+        for(const OutputRange& range : m_outputranges)
+                total += range.m_to - range.m_from;
+
+        m_forkjoin->forEachSlot([&](std::size_t slot)->void{
+                std::vector<std::pair<std::size_t, t_raw_atomic>>& externs = m_slotexterns[slot];
+                std::size_t index = 0;
+                for(const OutputRange& range : m_outputranges){
+                        const std::vector<t_msgptr>& mail = m_slotmail[range.m_slot];
+                        for(std::size_t i = range.m_from; i < range.m_to; ++i, ++index){
+                                const t_msgptr msg = mail[i];
+                                const size_t id = msg->getDestinationModel();
+                                if(id % slots != slot)
+                                        continue;
+                                msg->setCausality(causality(index));
+                                t_raw_atomic model = this->getModel(id).get();
+                                if(!hasMail(id)){
+                                        if(model->nextType()==AtomicModel_impl::NONE)
+                                                externs.push_back(std::make_pair(index, model));
+                                        model->markExternal();
+                                }
+                                getMail(id).push_back(msg);
+                        }
+                }
+        });
+        if(total)
+                m_msgCurrentCount = causality(total);
+
+        // Models become external in the order of their first message, as with serial sorting.
+        const std::size_t before = m_externs.size();
+        std::vector<std::pair<std::size_t, t_raw_atomic>> merged;
+        for(auto& externs : m_slotexterns){
+                merged.insert(merged.end(), externs.begin(), externs.end());
+                externs.clear();
+        }
+        std::sort(merged.begin(), merged.end(),
+                [](const std::pair<std::size_t, t_raw_atomic>& l, const std::pair<std::size_t, t_raw_atomic>& r)->bool{return l.first < r.first;});
+        m_externs.reserve(before + merged.size());
+        for(const auto& entry : merged)
+                m_externs.push_back(entry.second);
+        LOG_DEBUG("\tCORE :: ", this->getCoreID(), " sorted ", total, " messages on ", slots, " threads, ", merged.size(), " new externs");
+}
+
+void n_model::Core::releaseParallelOutput()
+{
+        m_forkjoin->forEachSlot([&](std::size_t slot)->void{
+                for(const OutputRange& range : m_outputranges){
+                        if(range.m_slot != slot)
+                                continue;
+                        for(std::size_t i = range.m_begin; i < range.m_end; ++i)
+                                m_imminents[i]->clearSentMessages();
+                }
+                for(t_msgptr msg : m_slotmail[slot])
+                        msg->releaseMe();
+                m_slotmail[slot].clear();
+        });
+        m_outputranges.clear();
+        m_parallelOutput = false;
+}
+
 void n_model::Core::sortMail(const std::vector<t_msgptr>& messages)
 {
         for (const auto& message : messages) {
@@ -316,13 +483,9 @@ n_model::Core::getImminent(std::vector<t_raw_atomic>& imms)
 void n_model::Core::rescheduleImminent()
 {
 	LOG_DEBUG("\tCORE :: ", this->getCoreID(), " Rescheduling ", m_imminents.size() + m_externs.size(), " models for next run.");
-#ifndef PDEVS
 	if(!m_heap.doSingleUpdate()){
-#endif
 		m_heap.updateAll();
-#ifndef PDEVS
 	}
-#endif
 	printSchedulerState();
 }
 
@@ -535,6 +698,18 @@ void n_model::Core::setTracers(n_tracers::t_tracersetptr ptr)
 	m_tracers = ptr;
 }
 
+void n_model::Core::setProfile(const t_profileptr& profile)
+{
+	assert(this->isLive() == false && "Can't start profiling a live core.");
+	m_profile = profile;
+}
+
+void n_model::Core::setForkJoinPool(const n_tools::t_forkjoinptr& pool)
+{
+	assert(this->isLive() == false && "Can't change the fork join pool of a live core.");
+	m_forkjoin = pool;
+}
+
 void n_model::Core::signalTracersFlush() const
 {
 	t_timestamp marktime(this->m_time.getTime(), std::numeric_limits<t_timestamp::t_causal>::max());
@@ -9,13 +9,16 @@
  */
 #include "model/modelentry.h"
 #include "model/terminationfunction.h"		// include atomicmodel
-#include "network/controlmessage.h"
+#include "model/sharedgvt.h"
+#include "model/profile.h"
 #include "network/messageentry.h"
 #include "network/network.h"
 #include "scheduler/modelscheduler.h"
+#include "scheduler/ladderscheduler.h"
 #include "scheduler/schedulerfactory.h"
 #include "tools/gviz.h"
 #include "tools/statistic.h"
+#include "tools/forkjoin.h"
 #include "tracers/tracers.h"
 #include <set>
 #include <condition_variable>
@@ -31,13 +34,16 @@ using n_network::t_msgptr;
 using n_network::t_timestamp;
 
 
-enum STAT_TYPE{MSGSENT,MSGRCVD,AMSGSENT,AMSGRCVD,TURNS,REVERTS,STALLEDROUNDS, DELMSG};
+enum STAT_TYPE{MSGSENT,MSGRCVD,AMSGSENT,AMSGRCVD,TURNS,REVERTS,STALLEDROUNDS, DELMSG, AMSGAVOIDED, THROTTLEDROUNDS, MODESWITCHES};
 
 /**
  * Typedefs used by core.
  */
 typedef n_scheduler::t_defaultModelScheduler t_scheduler;
-typedef std::shared_ptr<n_scheduler::Scheduler<MessageEntry>> t_msgscheduler;
+/**
+ * The concrete (final) type is used so calls on the pending message queue are not virtual.
+ */
+typedef std::shared_ptr<n_scheduler::LadderScheduler<MessageEntry, n_network::MessageEntryTime>> t_msgscheduler;
 
 struct statistics_collector{
         n_tools::t_uintstat     m_amsg_sent;
@@ -48,6 +54,10 @@ struct statistics_collector{
         n_tools::t_uintstat     m_msgs_sent;
         n_tools::t_uintstat     m_msgs_rcvd;
         n_tools::t_uintstat     m_deleted_msgs;
+        n_tools::t_uintstat     m_amsg_avoided;
+        n_tools::t_uintstat     m_turns_throttled;
+        n_tools::t_uintstat     m_throttled_time;
+        n_tools::t_uintstat     m_mode_switches;
         static std::string getName(std::size_t id, std::string name){
         	return std::string("_core") + n_tools::toString(id) + "/" + name;
         }
@@ -59,7 +69,11 @@ struct statistics_collector{
         	m_reverts(getName(id, "reverts"), ""),
         	m_msgs_sent(getName(id, "send"), "messages"),
         	m_msgs_rcvd(getName(id, "received"), "messages"),
-                m_deleted_msgs(getName(id, "deleted"),"messages")
+                m_deleted_msgs(getName(id, "deleted"),"messages"),
+                m_amsg_avoided(getName(id, "anti_avoided"), "messages"),
+                m_turns_throttled(getName(id, "throttled"), "turns"),
+                m_throttled_time(getName(id, "throttled_time"), "us"),
+                m_mode_switches(getName(id, "mode_switches"), "")
         {;}
         void printStats(std::ostream& out = std::cout) const noexcept
         {
@@ -71,7 +85,11 @@ struct statistics_collector{
 				<< m_msgs_sent
 				<< m_msgs_rcvd
 				<< m_reverts
-                                << m_deleted_msgs;
+                                << m_deleted_msgs
+                                << m_amsg_avoided
+                                << m_turns_throttled
+                                << m_throttled_time
+                                << m_mode_switches;
                 }catch(...){
                         LOG_ERROR("Exception caught in printStats()");
                 }
@@ -111,6 +129,18 @@ struct statistics_collector{
                         ++m_deleted_msgs;
                         break;
                 }
+                case AMSGAVOIDED:{
+                        ++m_amsg_avoided;
+                        break;
+                }
+                case THROTTLEDROUNDS:{
+                        ++m_turns_throttled;
+                        break;
+                }
+                case MODESWITCHES:{
+                        ++m_mode_switches;
+                        break;
+                }
                 default:
                         LOG_ERROR("No such logstat type");
                         break;
@@ -171,6 +201,16 @@ protected:
 	 */
 	n_tracers::t_tracersetptr m_tracers;
 
+	/**
+	 * Measurements of a pilot run, nullptr if the core is not profiled.
+	 */
+	t_profileptr m_profile;
+
+	/**
+	 * Runs output collection and transitions of a single step on more threads, nullptr if the step runs serially.
+	 */
+	n_tools::t_forkjoinptr m_forkjoin;
+
 	/**
 	 * Marks if this core has triggered a terminated functor. This distinction is required
 	 * for timewarp, and for the controller to redistribute the current time at wich the
@@ -225,6 +265,39 @@ protected:
          */
         std::vector<n_network::t_msgptr> m_mailfrom;
 
+        /**
+         * Imminents [m_begin, m_end) whose output is in m_slotmail[m_slot][m_from, m_to).
+         */
+        struct OutputRange
+        {
+                std::size_t m_begin;
+                std::size_t m_end;
+                std::size_t m_slot;
+                std::size_t m_from;
+                std::size_t m_to;
+        };
+
+        /**
+         * Per fork join slot, the messages the slot created in this step. The same slot releases them.
+         */
+        std::vector<std::vector<t_msgptr>> m_slotmail;
+        std::vector<std::vector<OutputRange>> m_slotranges;
+
+        /**
+         * Per fork join slot, the models that became external while sorting, with the index of their first message.
+         */
+        std::vector<std::vector<std::pair<std::size_t, t_raw_atomic>>> m_slotexterns;
+
+        /**
+         * All ranges of this step, in imminent order.
+         */
+        std::vector<OutputRange> m_outputranges;
+
+        /**
+         * True if the output of this step was collected in parallel, and is still held in m_slotmail.
+         */
+        bool m_parallelOutput;
+
         /**
          * Consecutive simulation rounds where the core had no next event
          * In optimistic used as a tiebreaker to avoid excessive reverts, large values trigger
@@ -232,6 +305,12 @@ protected:
          */
         std::size_t m_zombie_rounds;
 
+        /**
+         * Nr of messages and states the core keeps for a possible revert.
+         * Published by the simulating thread, read by the GVT thread.
+         */
+        std::atomic<std::size_t> m_history;
+
         /**
          * Return current mail for the model.
          */
@@ -271,6 +350,58 @@ protected:
         void
         clearProcessedMessages(std::vector<t_msgptr>& msgs);
         
+        /**
+         * @return true if a loop over n models of this step should run on the fork join pool.
+         */
+        bool
+        useForkJoin(std::size_t n) const
+        {
+                return m_forkjoin && !m_profile && m_forkjoin->shouldSplit(n);
+        }
+
+        /**
+         * @return true if collectOutput may run on the fork join pool.
+         * Only a core that queues all output for its own models can, the others run their transitions there.
+         */
+        virtual bool
+        canCollectOutputParallel() const
+        {
+                return true;
+        }
+
+        /**
+         * collectOutput on the fork join pool, the messages stay in the slot that created them.
+         */
+        void
+        collectOutputParallel(std::vector<t_raw_atomic>& imminents);
+
+        /**
+         * sortMail for the output of collectOutputParallel. Each slot queues the messages for a fixed subset
+         * of the models, in the order serial sorting would, and with the same causality.
+         */
+        void
+        sortMailParallel();
+
+        /**
+         * The transitions of transition() on the fork join pool, followed by tracing and rescheduling on this thread.
+         */
+        void
+        transitionParallel(const t_timestamp& noncausaltime);
+
+        /**
+         * After a transition, drop the processed messages of a model.
+         * Messages of a parallel output step are only released by releaseParallelOutput.
+         */
+        void
+        releaseMail(std::vector<t_msgptr>& msgs);
+
+        /**
+         * Each slot releases the messages it created in collectOutputParallel, including the copies
+         * its imminents kept for the tracers.
+         */
+        void
+        releaseParallelOutput();
+
         /**
          * Sort the vector of models by priority, sets indices in models.
          */
@@ -395,6 +526,15 @@ public:
         const t_atomicmodelptr&
         getModel(size_t index)const;
 
+        /**
+         * @return the nr of models on this core, their local ids are [0, getModelCount()).
+         */
+        std::size_t
+        getModelCount()const
+        {
+                return m_indexed_models.size();
+        }
+
 	//deprecated, O(N)
 	bool
 	containsModel(const std::string& name)const;
@@ -629,6 +769,17 @@ public:
         void
         validateModels(){assert(false);}
 
+        /**
+         * Move model id, with its pending messages, to core target.
+         * @param gvt : the current GVT, at least the GVT of both cores.
+         * @return false if the model can't move now, nothing changed then.
+         * @attention : call only while neither core is running a step.
+         * @note Only optimistic cores can move models, the default refuses.
+         */
+        virtual
+        bool
+        migrateModel(std::size_t /*id*/, Core& /*target*/, t_timestamp::t_time /*gvt*/){return false;}
+
 	/**
 	 * @brief Sets the tracers that will be used from now on
 	 * @precondition isLive()==false
@@ -636,6 +787,29 @@ public:
 	void
 	setTracers(n_tracers::t_tracersetptr ptr);
 
+	/**
+	 * @brief Record the transitions and messages of the models in profile.
+	 * @precondition isLive()==false, the core is a single (classic) core.
+	 */
+	void
+	setProfile(const t_profileptr& profile);
+
+	/**
+	 * @brief Run the output, mail sorting and transitions of a step on pool, if the step has enough models.
+	 * Lets a core use more threads for models with many simultaneous events.
+	 * A core that sends messages to other cores only runs its transitions on pool, see canCollectOutputParallel.
+	 * @precondition isLive()==false, the models of this core don't keep old states.
+	 * @attention The models' output and transition functions are called concurrently for different models.
+	 */
+	void
+	setForkJoinPool(const n_tools::t_forkjoinptr& pool);
+
+	/**
+	 * @return the pool set with setForkJoinPool, nullptr if this core runs a step on its own thread.
+	 */
+	const n_tools::t_forkjoinptr&
+	getForkJoinPool() const{return m_forkjoin;}
+
 	/**
 	 * Signal tracers to flush output up to a given time.
 	 * For the single core implementation this is the local time.
@@ -687,14 +861,13 @@ public:
 
 
 	/**
-	 * Mattern's algorithm nrs 1.6/1.7
-	 * @attention : only sensible in multicore setting, single core will assert fail.
+	 * Set the GVT shared by all cores of an optimistic simulation, the core takes part in its rounds
+	 * from runSmallStep.
+	 * @attention : ignored by cores that don't need a GVT.
 	 */
 	virtual
 	void
-	receiveControl(const t_controlmsg& /*controlmessage*/, int /*first*/, std::atomic<bool>& /*rungvt*/){
-		assert(false);
-	}
+	setSharedGVT(const t_sharedgvtptr& /*gvt*/){;}
 
 	/**
 	 * Write current Core state to log.
@@ -721,6 +894,19 @@ public:
         
         void resetZombieRounds(){m_zombie_rounds=0;}
 
+	/**
+	 * @return the nr of messages and states this core keeps for a possible revert, as of its last simulation step.
+	 * @threadsafe
+	 */
+	std::size_t
+	getHistorySize() const{return m_history.load(std::memory_order_relaxed);}
+
+protected:
+	void
+	setHistorySize(std::size_t size){m_history.store(size, std::memory_order_relaxed);}
+
+public:
+
 	virtual
 	MessageColor
 	getColor();
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include "model/hybridcore.h"
+
+namespace n_model {
+
+Hybridcore::Hybridcore(const t_networkptr& n, std::size_t coreid, std::size_t cores, const t_lvtvector& lvt,
+        const t_switchpolicyptr& policy, SyncMode mode)
+	: Optimisticcore(n, coreid, cores), m_lvt(lvt), m_policy(policy), m_mode(mode), m_switches(0)
+{
+	if(m_lvt->size() != cores)
+		throw std::logic_error("Local time vector not aligned with the nr of cores.");
+	if(m_policy == nullptr)
+		m_policy = n_tools::createObject<ThresholdSwitchPolicy>();
+}
+
+Hybridcore::~Hybridcore()
+{
+}
+
+void Hybridcore::init()
+{
+	Optimisticcore::init();
+	publishTime();
+}
+
+void Hybridcore::runSmallStep()
+{
+	++m_counts.m_turns;
+	Optimisticcore::runSmallStep();
+	publishTime();
+}
+
+void Hybridcore::revert(const t_timestamp& totime)
+{
+	++m_counts.m_reverts;
+	Optimisticcore::revert(totime);
+}
+
+void Hybridcore::publishTime()
+{
+	// An idle core only becomes live by receiving a message, which can't be earlier than the sender's time.
+	const t_timestamp::t_time now = isLive()? getTime().getTime() : t_timestamp::MAXTIME;
+	m_lvt->set(getCoreID(), now);
+}
+
+t_timestamp::t_time Hybridcore::getEit() const
+{
+	t_timestamp::t_time eit = t_timestamp::MAXTIME;
+	for(std::size_t i = 0; i < m_lvt->size(); ++i){
+		if(i != getCoreID())
+			eit = std::min(eit, m_lvt->get(i));
+	}
+	return eit;
+}
+
+bool Hybridcore::throttle()
+{
+	if(m_mode == SyncMode::CONSERVATIVE && isLive()){
+		const t_timestamp::t_time eit = getEit();
+		// A core publishes its time after flushing its messages, so all messages below eit are on the network.
+		this->getMessages();
+		if(getTime().getTime() > eit){
+			LOG_DEBUG("HCORE :: ", getCoreID(), " time ", getTime(), " beyond eit ", eit, ", stalling.");
+			m_stats.logStat(STALLEDROUNDS);
+			++m_counts.m_stalls;
+			return true;
+		}
+	}
+	return Optimisticcore::throttle();
+}
+
+void Hybridcore::signalGVT()
+{
+	if(m_counts.m_turns == 0)
+		return;
+	const SyncMode next = m_policy->choose(m_mode, m_counts);
+	LOG_INFO("HCORE :: ", getCoreID(), " GVT ", getGVT(), " after ", m_counts.m_turns, " turns, ", m_counts.m_stalls,
+	        " stalled, ", m_counts.m_reverts, " reverts, mode ",
+	        (next == SyncMode::CONSERVATIVE)? "conservative" : "optimistic");
+	if(next != m_mode){
+		m_mode = next;
+		++m_switches;
+		m_stats.logStat(MODESWITCHES);
+	}
+	m_counts = SyncCounts();
+}
+
+} /* namespace n_model */
@@ -0,0 +1,137 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_MODEL_HYBRIDCORE_H_
+#define SRC_MODEL_HYBRIDCORE_H_
+
+#include "model/optimisticcore.h"
+#include "model/switchpolicy.h"
+#include "tools/sharedvector.h"
+
+namespace n_model {
+
+/**
+ * Local time of each core, published by that core.
+ */
+typedef std::shared_ptr<n_tools::SharedAtomic<t_timestamp::t_time>> t_lvtvector;
+
+/**
+ * @brief Core that switches between conservative and optimistic synchronization at GVT boundaries.
+ *
+ * The core keeps the full Time Warp machinery (state saving, antimessages, GVT), so its neighbours
+ * can run either protocol at any time. In conservative mode it only simulates up to the lowest time
+ * published by the other cores (its earliest input time), so it does not speculate.
+ * Messages from optimistic neighbours can still be stragglers, these revert the core as usual.
+ * The Conservativecore's lookahead and null messages are not used, they assume every neighbour is conservative.
+ * Each time a new GVT is found, the SwitchPolicy chooses the mode for the next interval from the nr of
+ * turns, stalled turns and reverts since the last GVT.
+ */
+class Hybridcore: public Optimisticcore
+{
+private:
+	/**
+	 * Published local times, shared by all cores.
+	 */
+	t_lvtvector		m_lvt;
+
+	t_switchpolicyptr	m_policy;
+
+	SyncMode		m_mode;
+
+	/**
+	 * Measured since the last GVT.
+	 */
+	SyncCounts		m_counts;
+
+	/**
+	 * Nr of times the mode changed.
+	 */
+	std::size_t		m_switches;
+
+	/**
+	 * Publish the time of the next event, or infinity if the core is idle.
+	 */
+	void
+	publishTime();
+
+	/**
+	 * @return the lowest time published by the other cores.
+	 */
+	t_timestamp::t_time
+	getEit() const;
+
+protected:
+	/**
+	 * In conservative mode, a core whose time is beyond its earliest input time stalls.
+	 * Otherwise the optimism window applies.
+	 */
+	bool
+	throttle() override;
+
+	/**
+	 * Let the policy choose the mode until the next GVT.
+	 */
+	void
+	signalGVT() override;
+
+public:
+	Hybridcore() = delete;
+
+	/**
+	 * @param lvt : local times of all cores, shared by all cores.
+	 * @param policy : decides the mode, shared by all cores.
+	 * @param mode : the mode until the first GVT.
+	 * @see Optimisticcore
+	 */
+	Hybridcore(const t_networkptr& n, std::size_t coreid, std::size_t cores, const t_lvtvector& lvt,
+	        const t_switchpolicyptr& policy, SyncMode mode = SyncMode::CONSERVATIVE);
+
+	virtual ~Hybridcore();
+
+	/**
+	 * Initializes the models, then publishes the first time.
+	 */
+	void
+	init() override;
+
+	/**
+	 * Run an optimistic step (or stall), then publish the new time.
+	 */
+	void
+	runSmallStep() override;
+
+	/**
+	 * Count the revert for the policy, then revert.
+	 */
+	void
+	revert(const t_timestamp& totime) override;
+
+	/**
+	 * @return the current synchronization mode.
+	 */
+	SyncMode
+	getMode() const
+	{
+		return m_mode;
+	}
+
+	/**
+	 * @return the nr of times the mode changed.
+	 */
+	std::size_t
+	getSwitches() const
+	{
+		return m_switches;
+	}
+};
+
+} /* namespace n_model */
+
+#endif /* SRC_MODEL_HYBRIDCORE_H_ */
@@ -9,6 +9,7 @@
  */
 
 #include <thread>
+#include <algorithm>
 #include "model/optimisticcore.h"
 #include "tools/objectfactory.h"
 #include "model/port.h"
@@ -41,7 +42,7 @@ void Optimisticcore::initThread()
         for (size_t index = 0; index < m_indexed_models.size(); ++index) {
                 const t_atomicmodelptr& model = m_indexed_models[index];
                 model->setKeepOldStates(true);
-                model->prepareSimulation();
+                model->prepareSimulation(m_checkpointInterval);
                 LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " preparing model ", model->getName(), " for simulation.");
         }
         n_tlocal::setRevert(false);
@@ -65,17 +66,27 @@ void Optimisticcore::shutDown()
                 ptr->releaseMe();
                 m_stats.logStat(DELMSG);
         }
+        for (auto& ptr : m_lazy_messages) {
+                LOG_DEBUG("MCORE:: ", this->getCoreID(), " deleting ", ptr, " in core shutdown.");
+                ptr->releaseMe();
+                m_stats.logStat(DELMSG);
+        }
         for (const auto& ptr : m_indexed_models) {
                 ptr->clearSentMessages();
                 ptr->exitSimulation();
         }
         m_sent_messages.clear();
         m_sent_antimessages.clear();
+        m_lazy_messages.clear();
+        this->endThrottle();
 }
 
 Optimisticcore::Optimisticcore(const t_networkptr& net, std::size_t coreid, size_t cores)
-        : Core(coreid, cores), m_network(net), m_color(MessageColor::WHITE), m_mcount_vector(cores), m_tred(
-                t_timestamp::infinity()), m_tmin(0u), m_removeGVTMessages(false)
+        : Core(coreid, cores), m_network(net), m_sharedgvt(nullptr), m_color(MessageColor::WHITE), m_epoch(0),
+                m_reportedEpoch(0), m_sentCount{0, 0}, m_receivedCount{0, 0}, m_tred(t_timestamp::MAXTIME), m_outbox(cores), m_removeGVTMessages(false), m_checkpointInterval(1),
+                m_lazyCancellation(false), m_avoidedCancellations(0), m_modelHistory(0), m_window(0), m_baseWindow(0),
+                m_adaptiveWindow(false), m_windowTurns(0), m_windowReverts(0), m_throttled(false), m_throttledTime(0), m_throttledRevert(false),
+                m_cancelbackGVT(t_timestamp::MAXTIME), m_cancelbacks(0), m_adoptedTime(t_timestamp::MAXTIME)
 {
 }
 
@@ -120,27 +131,91 @@ void Optimisticcore::sortMail(const std::vector<t_msgptr>& messages)
 void Optimisticcore::sendMessage(t_msgptr msg)
 {
         // We're locked on msglock. Don't change the ordering here.
-        if(n_tlocal::isRevertSet()){
+        if(n_tlocal::isRevertSet() && std::find(m_adopted.begin(), m_adopted.end(),
+                m_indexed_models[msg->getSourceModel()].get()) == m_adopted.end()){
                 LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " not sending message, allready sent in previous round @", msg, " tostring: ", msg->toString());
                 msg->releaseMe();
                 return;
         }
+        if(!m_lazy_messages.empty() && matchLazyMessage(msg))
+                return;
         m_stats.logStat(MSGSENT);
         this->countMessage(msg);
-        this->m_network->acceptMessage(msg);
+        m_outbox[msg->getDestinationCore()].push_back(msg);
         this->markMessageStored(msg);
         LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " sending message @", msg, " tostring: ", msg->toString());
 }
 
 void Optimisticcore::sendAntiMessage(const t_msgptr& msg)
 {
-        // An antimessage is still the same object, if you change the colour the 
-        // counting (gvt) will be corrupted.
+        // An antimessage is still the same object, the original can still be in transit with its own color.
+        // countMessage paints the antimessage color only.
         m_stats.logStat(AMSGSENT);
         msg->setAntiMessage(true);
+        this->countMessage(msg);
         LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " sending antimessage : ", msg->toString());
         m_sent_antimessages.push_back(msg);
-        this->m_network->acceptMessage(msg);
+        m_outbox[msg->getDestinationCore()].push_back(msg);
+}
+
+bool Optimisticcore::matchLazyMessage(const t_msgptr& msg)
+{
+        const t_timestamp::t_time msgtime = msg->getTimeStamp().getTime();
+        auto iter = std::lower_bound(m_lazy_messages.begin(), m_lazy_messages.end(), msgtime,
+                [](const t_msgptr& lazy, t_timestamp::t_time time){return lazy->getTimeStamp().getTime() < time;});
+        for(; iter != m_lazy_messages.end() && (*iter)->getTimeStamp().getTime() == msgtime; ++iter){
+                const t_msgptr& lazy = *iter;
+                if(lazy->getDestinationCore() == msg->getDestinationCore()
+                        && lazy->getDestinationModel() == msg->getDestinationModel()
+                        && lazy->getDestinationPort() == msg->getDestinationPort()
+                        && lazy->getSourceModel() == msg->getSourceModel()
+                        && lazy->getSourcePort() == msg->getSourcePort()
+                        && lazy->samePayload(msg)){
+                        // The receiver still has the original, which is valid again.
+                        LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " lazy cancellation, not resending ", msg->toString());
+                        m_sent_messages.push_back(lazy);
+                        m_lazy_messages.erase(iter);
+                        msg->releaseMe();
+                        m_stats.logStat(AMSGAVOIDED);
+                        ++m_avoidedCancellations;
+                        return true;
+                }
+        }
+        return false;
+}
+
+void Optimisticcore::cancelLazyMessages(const t_timestamp& time)
+{
+        while(!m_lazy_messages.empty() && m_lazy_messages.front()->getTimeStamp().getTime() < time.getTime()){
+                LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " lazy cancellation, message was not produced again ", m_lazy_messages.front()->toString());
+                this->sendAntiMessage(m_lazy_messages.front());
+                m_lazy_messages.pop_front();
+        }
+}
+
+void Optimisticcore::cancelIdleLazyMessages()
+{
+        if (!m_lazy_messages.empty() && (!this->isLive() || this->getZombieRounds() != 0))
+                cancelLazyMessages(t_timestamp::infinity());
+}
+
+void Optimisticcore::flushOutbox()
+{
+        // Counting (GVT) is done on queueing, published once all of them are in the network.
+        bool sent = false;
+        for (std::size_t i = 0; i < m_outbox.size(); ++i) {
+                std::vector<t_msgptr>& msgvec = m_outbox[i];
+                if (msgvec.size()) {
+                        LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " delivering ", msgvec.size(), " messages to core ", i);
+                        m_network->giveMessages(i, msgvec);
+                        msgvec.clear();
+                        sent = true;
+                }
+        }
+        if (sent && m_sharedgvt) {
+                m_sharedgvt->setSent(this->getCoreID(), MessageColor::WHITE, m_sentCount[MessageColor::WHITE]);
+                m_sharedgvt->setSent(this->getCoreID(), MessageColor::RED, m_sentCount[MessageColor::RED]);
+        }
 }
 
 void Optimisticcore::handleAntiMessage(const t_msgptr& msg)
@@ -149,6 +224,11 @@ void Optimisticcore::handleAntiMessage(const t_msgptr& msg)
         LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " handling antimessage ", msg->toString());
         // Storing the flag can speed up this process, but has to be done atomically because
         // we set KILL (which the sending thread reads).
+        // The original arrives first (network is fifo), possibly already marked as antimessage.
+        // Any later arrival is the antimessage, which was sent in its own color.
+        const bool original = !msg->flagIsSet(Status::PROCESSED) && !msg->flagIsSet(Status::HEAPED)
+                && !msg->flagIsSet(Status::DELETE);
+        this->registerReceivedMessage(original ? msg->getColor() : msg->getAntiColor());
         if (msg->flagIsSet(Status::PROCESSED)) {
                 // Processed, so it is in m_processed, we can't touch it. Revert will clean it.
                 LOG_DEBUG("MCORE:: ", this->getCoreID(), " message already processed, should be in processed queue ", msg);
@@ -182,32 +262,13 @@ void Optimisticcore::markMessageStored(const t_msgptr& msg)
 
 void Optimisticcore::countMessage(const t_msgptr& msg)
 {
-        /**
-         * ALGORITHM 1.4 (or Fujimoto page 121 send algorithm)
-         * @pre Msgcolor == this.color
-         */
-        std::lock_guard<std::mutex> colorlock(m_colorlock);
-        msg->paint(m_color);
-#ifdef SAFETY_CHECKS
-        // With the new lock in this function, only memory corruption or sender changing color of this message could
-        // trigger this check. Nonetheless, if it does we have a case of nasal demons, and want to know about it before they're seen.
-        if(msg->getColor()!=m_color) {
-                LOG_ERROR("Message color not equal to core color : ", msg->toString());
-                LOG_FLUSH;
-                throw std::logic_error("Msg color not equal to core color, race detected.");
-        }
-#endif
-        if (m_color == MessageColor::WHITE) {           
-                const size_t j = msg->getDestinationCore();
-                std::lock_guard<std::mutex> lock(this->m_vlock);
-                ++(this->m_mcount_vector.getVector()[j]);
-                LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " GVT :: incrementing count vector to : ", m_mcount_vector.getVector()[j]);
-        } else {
-                std::lock_guard<std::mutex> lock(this->m_tredlock);
-                LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " GVT :: tred pre ", m_tred);
-                m_tred = std::min(m_tred, msg->getTimeStamp());
-                LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " GVT :: tred post : ", m_tred);
-        }
+        // Only the simulating thread touches the counts, they are published in flushOutbox.
+        if (msg->isAntiMessage())
+                msg->paintAnti(m_color);
+        else
+                msg->paint(m_color);
+        ++m_sentCount[m_color];
+        m_tred = std::min(m_tred, msg->getTimeStamp().getTime());
 }
 
 void Optimisticcore::receiveMessage(t_msgptr msg)
@@ -220,7 +281,7 @@ void Optimisticcore::receiveMessage(t_msgptr msg)
                 this->handleAntiMessage(msg);
         } else {
                 this->queuePendingMessage(msg);
-                this->registerReceivedMessage(msg);
+                this->registerReceivedMessage(msg->getColor());
         }
 }
 
@@ -238,18 +299,6 @@ void Optimisticcore::queuePendingMessage(t_msgptr msg)
         }
 }
 
-void Optimisticcore::registerReceivedMessage(const t_msgptr& msg)
-{
-        // ALGORITHM 1.5 (or Fujimoto page 121 receive algorithm)
-        // msg is not an antimessage here.
-        if (msg->getColor() == MessageColor::WHITE) {
-                std::lock_guard<std::mutex> lock(this->m_vlock);
-                --this->m_mcount_vector.getVector()[this->getCoreID()];
-                LOG_DEBUG("\tMCORE :: ", this->getCoreID(), " GVT :: decrementing count vector to : ",
-                        m_mcount_vector.getVector()[this->getCoreID()]);
-        }
-}
-
 void Optimisticcore::gcCollect()
 {
         auto senditer = m_sent_messages.begin();
@@ -313,16 +362,22 @@ void Optimisticcore::gcCollect()
         LOG_DEBUG("MCORE:: ", this->getCoreID(), " calling setGVT on all models.");
 
         n_network::t_timestamp newgvt = getGVT();
-        for (const auto& model : this->m_indexed_models)
+        m_modelHistory = 0;
+        for (const auto& model : this->m_indexed_models){
                 model->setGVT(newgvt);
+                m_modelHistory += model->getHistorySize();
+        }
 }
 
 void Optimisticcore::runSmallStep()
 {
         this->lockSimulatorStep();
 
+        this->stepGVT();
+
         if (m_removeGVTMessages) {
                 gcCollect();
+                this->publishHistory();
         }
 
         m_stats.logStat(TURNS);
@@ -332,10 +387,31 @@ void Optimisticcore::runSmallStep()
         if (!this->isLive()) {
             LOG_DEBUG("\tCORE :: ", this->getCoreID(),
                     " skipping small Step, we're idle and got no messages.");
+            this->endThrottle();
+            this->cancelIdleLazyMessages();
+            this->flushOutbox();
+            this->publishHistory();
             this->unlockSimulatorStep();
             return;
         }
 
+        if (this->throttle()) {
+                LOG_DEBUG("\tCORE :: ", this->getCoreID(), " skipping small Step, time ", this->getTime(),
+                        " is beyond the optimism window ", m_window, " from GVT ", this->getGVT(), " or over the history budget");
+                this->flushOutbox();
+                // The output at the revert time is still not sent again.
+                m_throttledRevert = m_throttledRevert || n_tlocal::isRevertSet();
+                n_tlocal::setRevert(false);
+                this->unlockSimulatorStep();
+                std::this_thread::yield();
+                return;
+        }
+        if (m_throttledRevert) {
+                n_tlocal::setRevert(true);
+                m_throttledRevert = false;
+        }
+        this->adaptWindow();
+
         this->getImminent(m_imminents);
 
         this->collectOutput(m_imminents);
@@ -347,14 +423,20 @@ void Optimisticcore::runSmallStep()
         this->rescheduleImminent();
 
         this->syncTime();               
+        m_modelHistory += m_imminents.size() + m_externs.size();
         m_imminents.clear();
         m_externs.clear();
 
         this->checkTerminationFunction();
-        
+
+        this->cancelIdleLazyMessages();
+
+        this->flushOutbox();
+        this->setHistorySize(m_sent_messages.size() + m_processed_messages.size() + m_modelHistory);
         
         LOG_DEBUG("MCORE:: ", this->getCoreID(), " setting revert flag from ", n_tlocal::isRevertSet(), " to ", false);
         n_tlocal::setRevert(false);
+        m_adopted.clear();
         this->unlockSimulatorStep();
 }
 
@@ -365,10 +447,26 @@ void Optimisticcore::getMessages()
         if (!wasLive) {
                 LOG_INFO("MCORE :: ", this->getCoreID(), " switching to live before we check for messages");
         }
-        if (this->m_network->havePendingMessages(this->getCoreID())) {
-                std::vector<t_msgptr> messages = this->m_network->getMessages(this->getCoreID());
+        const bool network = this->m_network->havePendingMessages(this->getCoreID());
+        if (network || !m_inbox.empty() || m_adoptedTime != t_timestamp::MAXTIME) {
+                std::vector<t_msgptr> messages;
+                if (network)
+                        messages = this->m_network->getMessages(this->getCoreID());
+                if (!m_inbox.empty()) {
+                        // Taken from the network earlier, so they go first.
+                        messages.insert(messages.begin(), m_inbox.begin(), m_inbox.end());
+                        m_inbox.clear();
+                }
                 LOG_INFO("CCORE :: ", this->getCoreID(), " received ", messages.size(), " messages. ");
                 this->sortIncoming(messages);
+                // Messages (or models moved here) that don't revert the core to before the end don't wake it.
+                if (this->getTime() >= this->getTerminationTime())
+                        this->setLive(false);
+                // Published after the reverts these caused, a core may report once all are counted.
+                if (m_sharedgvt) {
+                        m_sharedgvt->setReceived(this->getCoreID(), MessageColor::WHITE, m_receivedCount[MessageColor::WHITE]);
+                        m_sharedgvt->setReceived(this->getCoreID(), MessageColor::RED, m_receivedCount[MessageColor::RED]);
+                }
         } else {
                 if (!wasLive) {
                         setLive(false);
@@ -380,7 +478,9 @@ void Optimisticcore::getMessages()
 
 void Optimisticcore::sortIncoming(const std::vector<t_msgptr>& messages)
 {
-        t_timestamp::t_time minmsgtime = t_timestamp::MAXTIME;
+        // A model moved here is behind the core if its next transition is.
+        t_timestamp::t_time minmsgtime = m_adoptedTime;
+        m_adoptedTime = t_timestamp::MAXTIME;
         for (auto i = messages.begin(); i != messages.end(); ++i) {
                 t_msgptr message = *i;
                 minmsgtime = std::min(minmsgtime, message->getTimeStamp().getTime());
@@ -395,145 +495,274 @@ void Optimisticcore::sortIncoming(const std::vector<t_msgptr>& messages)
         }
 }
 
-void Optimisticcore::waitUntilOK(const t_controlmsg& msg, std::atomic<bool>& rungvt)
+bool Optimisticcore::migrateModel(std::size_t id, Core& targetcore, t_timestamp::t_time gvt)
 {
-        // We don't have to get the count from the message each time,
-        // because the control message doesn't change, it stays in this core
-        // The V vector of this core can change because ordinary messages are
-        // still being received by another thread in this core, this is why
-        // we lock the V vector
-        const int msgcount = msg->getCountVector()[this->getCoreID()];
-        while (true) {
+        Optimisticcore& target = static_cast<Optimisticcore&>(targetcore);
+        const t_atomicmodelptr model = m_indexed_models[id];
 
-                if (rungvt == false) {
-                        LOG_INFO("MCORE :: ", this->getCoreID(),
-                                " rungvt set to false by a Core thread, stopping GVT.");
-                        return;
-                }
-                int v_value = 0;
-                {
-                        std::lock_guard<std::mutex> lock(m_vlock);
-                        v_value = this->m_mcount_vector.getVector()[this->getCoreID()];
-                }
-                if (v_value + msgcount <= 0) {
-                        LOG_DEBUG("MCORE :: ", this->getCoreID(), " rungvt : V + C <=0; v= ", v_value, " C=", msgcount);
-                        break;
+        // Messages still in the network can be addressed to the model, take them in first.
+        if (m_network->havePendingMessages(this->getCoreID())) {
+                std::vector<t_msgptr> messages = m_network->getMessages(this->getCoreID());
+                m_inbox.insert(m_inbox.end(), messages.begin(), messages.end());
+        }
+        std::vector<t_msgptr> pending;
+        while (!m_received_messages->empty())
+                pending.push_back(m_received_messages->pop().getMessage());
+
+        // Processed messages at or after GVT are pending again after a revert.
+        const auto fromTarget = [id, &target](const t_msgptr& msg)->bool{
+                return msg->getDestinationModel() == id && msg->getSourceCore() == target.getCoreID();
+        };
+        bool blocked = std::any_of(pending.begin(), pending.end(), fromTarget)
+                || std::any_of(m_inbox.begin(), m_inbox.end(), fromTarget);
+        for (auto iter = m_processed_messages.rbegin();
+                !blocked && iter != m_processed_messages.rend() && iter->m_msgtime >= gvt; ++iter)
+                blocked = fromTarget(iter->m_ptr);
+        for (const t_msgptr& msg : pending)
+                m_received_messages->push_back(MessageEntry(msg));
+        if (blocked) {
+                LOG_DEBUG("MCORE:: ", this->getCoreID(), " can't move ", model->getName(), " to ", target.getCoreID(),
+                        ", it has a message pending from there.");
+                return false;
+        }
+
+        if (model->getTimeLast().getTime() >= gvt) {
+                // Local messages are not kept, only a revert of the whole core can undo what the model did after GVT.
+                LOG_DEBUG("MCORE:: ", this->getCoreID(), " reverting to GVT ", gvt, " to move ", model->getName());
+                const bool revertflag = n_tlocal::isRevertSet();
+                n_tlocal::setRevert(false);
+                this->revert(t_timestamp(gvt, 0));
+                n_tlocal::setRevert(revertflag);
+                m_throttledRevert = false;
+                // The step at gvt sends its output again, without the revert flag : some of it was local before.
+                while (!m_sent_messages.empty() && m_sent_messages.back()->getTimeStamp().getTime() >= gvt) {
+                        if (m_lazyCancellation)
+                                m_lazy_messages.push_front(m_sent_messages.back());
+                        else
+                                this->sendAntiMessage(m_sent_messages.back());
+                        m_sent_messages.pop_back();
                 }
-                // We can't use a cvar here, if sim ends before we wake we hang the entire simulation.
-                {
-                        std::chrono::milliseconds ms { 1 };
-                        std::this_thread::sleep_for(ms);
+                this->flushOutbox();
+                // The revert leaves work without a message to wake the core, it can't stay a zombie.
+                this->resetZombieRounds();
+#ifdef SAFETY_CHECKS
+                if (model->getTimeLast().getTime() >= gvt)
+                        throw std::logic_error("Model not reverted before GVT.");
+#endif
+        }
+        pending.clear();
+        while (!m_received_messages->empty())
+                pending.push_back(m_received_messages->pop().getMessage());
+
+        LOG_DEBUG("MCORE:: ", this->getCoreID(), " moving ", model->getName(), " to ", target.getCoreID());
+        m_adopted.erase(std::remove(m_adopted.begin(), m_adopted.end(), model.get()), m_adopted.end());
+
+        // Annihilated messages stay, they are killed here when they leave the scheduler.
+        std::vector<t_msgptr> moving;
+        std::vector<t_msgptr> staying;
+        for (const t_msgptr& msg : pending) {
+                if (msg->getDestinationModel() == id && !msg->flagIsSet(Status::ERASE)) {
+                        // The target counts it again when it receives it.
+                        msg->setFlag(Status::HEAPED, false);
+                        --m_receivedCount[msg->getColor()];
+                        moving.push_back(msg);
+                } else {
+                        staying.push_back(msg);
                 }
         }
+        const auto split = std::stable_partition(m_inbox.begin(), m_inbox.end(),
+                [id](const t_msgptr& msg){return msg->getDestinationModel() != id;});
+        moving.insert(moving.end(), split, m_inbox.end());
+        m_inbox.erase(split, m_inbox.end());
+
+        // The last model takes the free id.
+        const std::size_t last = m_indexed_models.size() - 1;
+        if (id != last) {
+                m_indexed_models[id] = m_indexed_models[last];
+                m_indexed_models[id]->initUUID(this->getCoreID(), id);
+                const auto readdress = [this, id, last](const t_msgptr& msg){
+                        if (msg->getDestinationModel() == last)
+                                msg->setDestination(this->getCoreID(), id);
+                };
+                std::for_each(staying.begin(), staying.end(), readdress);
+                std::for_each(m_inbox.begin(), m_inbox.end(), readdress);
+                // Processed messages at or after GVT can be queued again by a revert, the older ones can be gone.
+                for (auto iter = m_processed_messages.rbegin();
+                        iter != m_processed_messages.rend() && iter->m_msgtime >= gvt; ++iter)
+                        readdress(iter->m_ptr);
+        }
+        m_indexed_models.pop_back();
+        m_indexed_local_mail.pop_back();
+        for (const t_msgptr& msg : staying)
+                m_received_messages->push_back(MessageEntry(msg));
+        this->rescheduleModels();
+        if (!m_inbox.empty())
+                this->setLive(true);
+        if (m_sharedgvt) {
+                m_sharedgvt->setReceived(this->getCoreID(), MessageColor::WHITE, m_receivedCount[MessageColor::WHITE]);
+                m_sharedgvt->setReceived(this->getCoreID(), MessageColor::RED, m_receivedCount[MessageColor::RED]);
+        }
+
+        target.adoptModel(model, moving);
+        return true;
+}
+
+void Optimisticcore::adoptModel(const t_atomicmodelptr& model, const std::vector<t_msgptr>& messages)
+{
+        const std::size_t id = m_indexed_models.size();
+        model->setCorenumber(this->getCoreID());
+        model->initUUID(this->getCoreID(), id);
+        m_indexed_models.push_back(model);
+        m_indexed_local_mail.emplace_back();
+        m_adopted.push_back(model.get());
+        this->rescheduleModels();
+        for (const t_msgptr& msg : messages)
+                msg->setDestination(this->getCoreID(), id);
+        // An antimessage may not arrive before its original, which can be in the scheduler of the old core.
+        m_inbox.insert(m_inbox.begin(), messages.begin(), messages.end());
+        m_adoptedTime = std::min(m_adoptedTime, model->getTimeNext().getTime());
+        // Only wake the core if there is work, getMessages puts it to sleep again if that work is past the end.
+        if (!m_inbox.empty() || m_adoptedTime != t_timestamp::MAXTIME)
+                this->setLive(true);
 }
 
-void Optimisticcore::receiveControl(const t_controlmsg& msg, int round, std::atomic<bool>& rungvt)
+void Optimisticcore::rescheduleModels()
 {
-        // ALGORITHM 1.7 (more or less) (or Fujimoto page 121)
-        // Also see snapshot_gvt.pdf
-        // Race check : id = const, read only.
-        if (rungvt == false) {
-                LOG_INFO("MCORE :: ", this->getCoreID(), " rungvt set to false by a thread, stopping GVT.");
-                return;
+        m_heap.clear();
+        for (const t_atomicmodelptr& model : m_indexed_models)
+                m_heap.push_back(model.get());
+        this->rescheduleAll();
+}
+
+bool Optimisticcore::throttle()
+{
+        const bool cancelled = this->cancelback();
+        const t_timestamp::t_time now = this->getTime().getTime();
+        const t_timestamp::t_time gvt = this->getGVT().getTime();
+        if (!cancelled && (m_window == 0 || now <= gvt || now - gvt <= m_window)) {
+                this->endThrottle();
+                return false;
         }
-        if (this->getCoreID() == 0 && round == 0) {
-                startGVTProcess(msg, round, rungvt);
-        } else if (this->getCoreID() == 0) {            // Round 1,2,3...
-                finalizeGVTRound(msg, round, rungvt);
-        } else {
-                receiveControlWorker(msg, round, rungvt);
-        }
-}
-
-void Optimisticcore::finalizeGVTRound(const t_controlmsg& msg, int round, std::atomic<bool>& rungvt)
-{
-        LOG_DEBUG("MCORE :: ", this->getCoreID(),
-                " GVT : process init received control message, waiting for pending messages.");
-        this->waitUntilOK(msg, rungvt);
-        LOG_DEBUG("MCORE :: ", this->getCoreID(), " GVT : All messages received, checking vectors. ");
-        if (msg->countIsZero()) {  /// Case found GVT
-                LOG_INFO("MCORE :: ", this->getCoreID(), " found GVT!");
-                t_timestamp GVT_approx = std::min(msg->getTmin(), msg->getTred());
-                LOG_DEBUG("MCORE :: ", this->getCoreID(), " GVT approximation = min( ", msg->getTmin(), ",",
-                        msg->getTred(), ")");
-                msg->setGvtFound(true);
-                msg->setGvt(GVT_approx);
-        } else {                /// C vector is != 0
-                if (round == 1) {
-                        LOG_DEBUG("MCORE :: ", this->getCoreID(),
-                                " process init received control message, starting 2nd round");
-                        msg->setTmin(this->getTMin());
-                        msg->setTred(std::min(msg->getTred(), this->getTred()));
-                        LOG_DEBUG("MCORE :: ", this->getCoreID(), " Starting 2nd round with tmin ", msg->getTmin(),
-                                " tred ", msg->getTred(), ")");
-                        t_count& count = msg->getCountVector();
-                        std::lock_guard<std::mutex> lock(this->m_vlock);
-                        for (size_t i = 0; i < count.size(); ++i) {
-                                count[i] += this->m_mcount_vector.getVector()[i];
-                                this->m_mcount_vector.getVector()[i] = 0;
-                        }
-                } else {
-                        LOG_DEBUG("MCORE :: ", this->getCoreID(),
-                                " 2nd round , P0 still has non-zero count vectors, quitting algorithm");
-                }
-                /// There is no cleanup to be done, startGVT initializes core/msg.
+        if (!m_throttled) {
+                m_throttled = true;
+                m_throttledSince = std::chrono::steady_clock::now();
         }
+        m_stats.logStat(THROTTLEDROUNDS);
+        if (m_sharedgvt)
+                m_sharedgvt->start();
+        return true;
 }
 
-void Optimisticcore::receiveControlWorker(const t_controlmsg& msg, int /*round*/, std::atomic<bool>& rungvt)
+bool Optimisticcore::cancelback()
 {
-        // ALGORITHM 1.6 (or Fujimoto page 121 control message receive algorithm)
-        if (this->getColor() == MessageColor::WHITE) {
-                this->setTred(t_timestamp::infinity());
-                this->setColor(MessageColor::RED);
+        if (!m_sharedgvt || m_sharedgvt->getHistoryBudget() == 0)
+                return false;
+        SharedGVT& shared = *m_sharedgvt;
+        const t_timestamp::t_time gvt = this->getGVT().getTime();
+        if (m_cancelbackGVT != t_timestamp::MAXTIME) {
+                if (gvt <= m_cancelbackGVT)
+                        return true;
+                m_cancelbackGVT = t_timestamp::MAXTIME;
         }
-        // We wait until we have received all messages
-        LOG_INFO("MCORE:: ", this->getCoreID(), " time: ", getTime(), " process received control message");
-        waitUntilOK(msg, rungvt);
+        const t_timestamp::t_time now = this->getTime().getTime();
+        this->publishHistory();
+        if (!shared.isOverBudget())
+                return false;
+        shared.start();
+        // Rolling back to gvt itself would hold the GVT, and with it the core, forever.
+        if (now == t_timestamp::MAXTIME || now <= gvt || now - gvt < 2 || !shared.isFurthest(this->getCoreID()))
+                return false;
+        const t_timestamp::t_time totime = gvt + (now - gvt) / 2;
+        LOG_INFO("MCORE:: ", this->getCoreID(), " history over budget, cancelback from ", now, " to ", totime);
+        // The flag of a revert earlier in this step is subsumed by this one.
+        n_tlocal::setRevert(false);
+        this->revert(t_timestamp(totime, 0));
+        m_cancelbackGVT = gvt;
+        ++m_cancelbacks;
+        shared.cancelledBack();
+        return true;
+}
 
-        // Equivalent to sending message, controlmessage is passed to next core.
-        t_timestamp msg_tmin = msg->getTmin();
-        t_timestamp msg_tred = msg->getTred();
-        msg->setTmin(std::min(msg_tmin, this->getTMin()));
-        msg->setTred(std::min(msg_tred, this->getTred()));
-        LOG_DEBUG("MCORE:: ", this->getCoreID(), " time: ", getTime(), " Updating tmin to ", msg->getTmin(), " tred = ",
-                msg->getTred());
-        t_count& Count = msg->getCountVector();
-        std::lock_guard<std::mutex> lock(this->m_vlock);
-        for (size_t i = 0; i < Count.size(); ++i) {
-                Count[i] += this->m_mcount_vector.getVector()[i];
-                this->m_mcount_vector.getVector()[i] = 0;
-        }
+void Optimisticcore::publishHistory()
+{
+        if (!m_sharedgvt || m_sharedgvt->getHistoryBudget() == 0)
+                return;
+        this->setHistorySize(m_sent_messages.size() + m_processed_messages.size() + m_modelHistory);
+        // An idle core can't cancel back, so it is never the furthest.
+        const t_timestamp::t_time now = this->isLive()? this->getTime().getTime() : t_timestamp::MAXTIME;
+        m_sharedgvt->publish(this->getCoreID(), now, this->getHistorySize());
+}
+
+void Optimisticcore::endThrottle()
+{
+        if (!m_throttled)
+                return;
+        m_throttled = false;
+        const std::size_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - m_throttledSince).count();
+        m_throttledTime += us;
+        m_stats.m_throttled_time += us;
+}
+
+void Optimisticcore::adaptWindow()
+{
+        if (!m_adaptiveWindow || m_window == 0)
+                return;
+        if (++m_windowTurns < WINDOW_ADAPT_TURNS)
+                return;
+        const t_timestamp::t_time lower = std::min(m_baseWindow,
+                std::max(m_baseWindow / WINDOW_RANGE, t_timestamp::t_time(1)));
+        const t_timestamp::t_time upper = m_baseWindow * WINDOW_RANGE;
+        if (m_windowReverts * 8 > m_windowTurns)
+                m_window = std::max(m_window / 2, lower);
+        else if (m_windowReverts * 64 < m_windowTurns)
+                m_window = std::min(m_window * 2, upper);
+        LOG_DEBUG("MCORE:: ", this->getCoreID(), " optimism window ", m_window, " after ", m_windowReverts,
+                " reverts in ", m_windowTurns, " turns");
+        m_windowTurns = 0;
+        m_windowReverts = 0;
+}
 
-        // Send message to next process in ring
-        return;
+void Optimisticcore::setSharedGVT(const t_sharedgvtptr& gvt)
+{
+        m_sharedgvt = gvt;
+        m_epoch = gvt->getEpoch();
+        m_reportedEpoch = m_epoch;
+        m_color = SharedGVT::colorOf(m_epoch);
 }
 
-void Optimisticcore::startGVTProcess(const t_controlmsg& msg, int /*round*/, std::atomic<bool>& rungvt)
+void Optimisticcore::stepGVT()
 {
-        if (rungvt == false) {
-                LOG_INFO("MCORE :: ", this->getCoreID(), " rungvt set to false by a thread, stopping GVT.");
+        if (!m_sharedgvt)
                 return;
+        SharedGVT& gvt = *m_sharedgvt;
+        const t_timestamp::t_time found = gvt.getGVT();
+        if (found > this->getGVT().getTime()) {
+                Core::setGVT(t_timestamp(found, 0));
+                m_removeGVTMessages = true;
+                this->signalGVT();
+        }
+        gvt.startIfDue();
+        const std::size_t epoch = gvt.getEpoch();
+        if (epoch != m_epoch) {
+                // All messages in the old color are flushed and published by the previous step.
+                LOG_DEBUG("MCORE:: ", this->getCoreID(), " GVT :: switching to epoch ", epoch);
+                m_epoch = epoch;
+                m_color = SharedGVT::colorOf(epoch);
+                m_tred = t_timestamp::MAXTIME;
+                gvt.switched();
+        }
+        if (m_reportedEpoch != m_epoch && gvt.canReport()) {
+                // All messages in the old color are received, and reverted to if needed.
+                // A model moved here can still revert the core in the next getMessages.
+                // An undone message can still be annulled at its own time.
+                const t_timestamp::t_time lazymin = m_lazy_messages.empty()? t_timestamp::MAXTIME: m_lazy_messages.front()->getTimeStamp().getTime();
+                const t_timestamp::t_time localmin = std::min({this->getTime().getTime(), m_tred, m_adoptedTime, lazymin});
+                LOG_DEBUG("MCORE:: ", this->getCoreID(), " GVT :: reporting ", localmin, " in epoch ", m_epoch);
+                m_reportedEpoch = m_epoch;
+                if (gvt.report(this->getCoreID(), localmin, this->getHistorySize()))
+                        n_tracers::traceUntil(t_timestamp(gvt.getGVT(), 0));
         }
-        LOG_INFO("MCORE:: ", this->getCoreID(), " time: ", getTime(),
-                " GVT received first control message, starting first round");
-        this->setColor(MessageColor::RED);
-        setTred(t_timestamp::infinity());
-        msg->setTmin(this->getTMin());
-        msg->setTred(t_timestamp::infinity());
-        LOG_INFO("MCORE :: ", this->getCoreID(), " Starting GVT Calculating with tred value of ", msg->getTred(),
-                " tmin = ", msg->getTmin());
-        t_count& count = msg->getCountVector();
-        // We want to make sure our count vector starts with 0
-        std::fill(count.begin(), count.end(), 0);
-        // Lock because we will change our V vector
-        std::lock_guard<std::mutex> lock(this->m_vlock);
-        for (size_t i = 0; i < count.size(); i++) {
-                count[i] += this->m_mcount_vector.getVector()[i];
-                this->m_mcount_vector.getVector()[i] = 0;
-        }
-        // Send message to next process in ring
-        return;
 }
 
 void Optimisticcore::setGVT(const t_timestamp& candidate)
@@ -552,10 +781,6 @@ void Optimisticcore::setGVT(const t_timestamp& candidate)
 
         Core::setGVT(newgvt);
         m_removeGVTMessages = true;
-        // Reset state (note V-vector is reset by Mattern code.
-        this->setColor(MessageColor::WHITE);
-        LOG_INFO("MCORE:: ", this->getCoreID(), " time: ", getTime(),
-                " painted core back to white, for next gvt calculation");
 
         this->unlockSimulatorStep();
 }
@@ -582,6 +807,8 @@ void n_model::Optimisticcore::revert(const t_timestamp& rtime)
                 throw std::logic_error("Revert flag set when entering revert !");
 #endif
         n_tlocal::setRevert(true);
+        m_stats.logStat(REVERTS);
+        ++m_windowReverts;
         const t_timestamp::t_time totime = rtime.getTime();
         const t_timestamp::t_time gtime = this->getGVT().getTime();
         assert(totime >= gtime);
@@ -598,6 +825,12 @@ void n_model::Optimisticcore::revert(const t_timestamp& rtime)
                 LOG_DEBUG("MCORE:: ", this->getCoreID(), " reverting message ", msg, " ", msg->toString());
                 if (msg->getTimeStamp().getTime() > totime) {
                         m_sent_messages.pop_back();
+                        if (m_lazyCancellation) {
+                                LOG_DEBUG("MCORE:: ", this->getCoreID(), " time: ", getTime(),
+                                        " revert : sent message > time , postponing cancellation. \n ", msg->toString());
+                                m_lazy_messages.push_back(msg);
+                                continue;
+                        }
                         LOG_DEBUG("MCORE:: ", this->getCoreID(), " time: ", getTime(),
                                 " revert : sent message > time , antimessagging. \n ", msg->toString());
                         this->sendAntiMessage(msg);
@@ -606,6 +839,10 @@ void n_model::Optimisticcore::revert(const t_timestamp& rtime)
                         break;
                 }
         }
+        if (m_lazyCancellation) {
+                std::stable_sort(m_lazy_messages.begin(), m_lazy_messages.end(),
+                        [](const t_msgptr& l, const t_msgptr& r){return l->getTimeStamp().getTime() < r->getTimeStamp().getTime();});
+        }
         
         while(m_processed_messages.size()){
                 // DO NOT access the pointer itself
@@ -645,45 +882,23 @@ bool n_model::Optimisticcore::existTransientMessage()
 
 void n_model::Optimisticcore::setColor(MessageColor mc)
 {
-        std::lock_guard<std::mutex> lock(m_colorlock);
         LOG_DEBUG("MCORE:: ", this->getCoreID(), " setting color from ", (m_color==WHITE?"white":"red"), " to ", (mc==WHITE?"white":"red"));
         this->m_color = mc;
 }
 
 MessageColor n_model::Optimisticcore::getColor()
 {
-        std::lock_guard<std::mutex> lock(m_colorlock);
         return m_color;
 }
 
-/**
- * Locking strategy explained :
- *      get/set time has a very high call frequency
- *      sim thread : write/read on time
- *      gvt thread : read on time.
- *      So if we share tmin between them (which is what gvt uses time for), and update (locked)
- *      that value sim t updates time, we avoid the unnecessary lock on reading our own writes.
- */
 void n_model::Optimisticcore::setTime(const t_timestamp& newtime)
 {
-        this->setTMin(newtime);
+        // Cancel before the time moves on, so the antimessages can't be passed by GVT.
+        if (!m_lazy_messages.empty())
+                cancelLazyMessages(newtime);
         Core::setTime(newtime);
 }
 
-t_timestamp n_model::Optimisticcore::getTred()
-{
-        std::lock_guard<std::mutex> lock(m_tredlock);
-        return this->m_tred;
-}
-
-void n_model::Optimisticcore::setTred(t_timestamp val)
-{
-        std::lock_guard<std::mutex> lock(m_tredlock);
-        LOG_DEBUG("MCORE:: ", this->getCoreID(), " setting tRed from ", m_tred, " to ", val);
-        this->m_tred = val;
-}
-
-
 t_timestamp 
 n_model::Optimisticcore::getFirstMessageTime()
 {
@@ -11,8 +11,8 @@
 #ifndef SRC_MODEL_OPTIMISTICCORE_H_
 #define SRC_MODEL_OPTIMISTICCORE_H_
 
+#include <chrono>
 #include "model/core.h"
-#include "model/v.h"
 #include "network/message.h"
 using n_network::MessageColor;
 
@@ -30,47 +30,36 @@ private:
 	t_networkptr			m_network;
 
 	/**
-	 * This core's current color state.
+	 * GVT shared with the other cores, nullptr if the core runs without one.
 	 */
-	MessageColor			m_color;
+	t_sharedgvtptr			m_sharedgvt;
 
 	/**
-	 * Local count vector for Mattern.
+	 * Color messages are sent in, the color of the last GVT epoch this core has seen.
 	 */
-	V				m_mcount_vector;
+	MessageColor			m_color;
 
 	/**
-	 * Locks access to V vector of this core
+	 * Last GVT epoch this core has seen, and the last one it reported in.
 	 */
-	std::mutex			m_vlock;
+	std::size_t			m_epoch;
+	std::size_t			m_reportedEpoch;
 
 	/**
-	 * Simulation lock
+	 * Nr of messages (and antimessages) sent/received per color, published to m_sharedgvt.
 	 */
-	std::mutex			m_locallock;
+	std::size_t			m_sentCount[2];
+	std::size_t			m_receivedCount[2];
 
 	/**
-	 * Synchronize access to color.
+	 * Simulation lock
 	 */
-	std::mutex			m_colorlock;
+	std::mutex			m_locallock;
 
 	/**
-	 * Lock for Tred value (as described in Mattern's GVT algorithm
-	 * on pages 117 - 121 (Fujimoto) )
+	 * Smallest time stamp of any message sent in the current color.
 	 */
-	std::mutex			m_tredlock;
-
-	/**
-	 * Tred is defined as the smallest time stamp of any red message sent by the processor
-	 * (Mattern)
-	 */
-	t_timestamp			m_tred;
-        
-        /**
-         * Tmin is <= first unprocessed message, which is equivalent of time().
-         * @synchronized
-         */
-        std::atomic<t_timestamp::t_time>        m_tmin;
+	t_timestamp::t_time		m_tred;
 
 	/**
 	 * Sent messages, stored in Front[earliest .... latest..now] Back order.
@@ -81,16 +70,122 @@ private:
          */
         std::deque<t_msgptr>                    m_sent_antimessages;
 
+        /**
+         * Remote messages (and antimessages) produced in the current round, indexed by destination core.
+         * Flushed to the network once per round, one synchronization per destination instead of one per message.
+         */
+        std::vector<std::vector<t_msgptr>>      m_outbox;
+
 	bool m_removeGVTMessages;
+
+        /**
+         * Checkpoint interval for the models that did not set their own.
+         * @see AtomicModel_impl::setCheckpointInterval
+         */
+        std::size_t m_checkpointInterval;
+
+        /**
+         * If true, a revert does not cancel the sent messages it undoes right away,
+         * but keeps them in m_lazy_messages until it is clear the re-execution does not produce them again.
+         */
+        bool m_lazyCancellation;
+
+        /**
+         * Undone sent messages waiting to be regenerated or cancelled, sorted on timestamp.
+         */
+        std::deque<t_msgptr>                    m_lazy_messages;
+
+        /**
+         * Nr of undone messages the re-execution produced again, each avoiding an antimessage.
+         */
+        std::size_t m_avoidedCancellations;
+
+        /**
+         * Nr of states and transitions the models keep, counted at the last collection and
+         * approximated by the nr of transitions since.
+         */
+        std::size_t m_modelHistory;
+
+        /**
+         * Optimism window : the core does not simulate beyond GVT + m_window, 0 if unbounded.
+         */
+        t_timestamp::t_time m_window;
+
+        /**
+         * The configured window, an adaptive window stays within a factor WINDOW_RANGE of it.
+         */
+        t_timestamp::t_time m_baseWindow;
+
+        /**
+         * If true, m_window follows the fraction of turns that end in a revert.
+         */
+        bool m_adaptiveWindow;
+
+        /**
+         * Nr of turns and reverts since the window was last adapted.
+         */
+        std::size_t m_windowTurns;
+        std::size_t m_windowReverts;
+
+        /**
+         * True while the core is beyond its window, since m_throttledSince.
+         */
+        bool m_throttled;
+        std::chrono::steady_clock::time_point m_throttledSince;
+
+        /**
+         * Total time (us) the core was throttled by the window.
+         */
+        std::size_t m_throttledTime;
+
+        /**
+         * A throttled step reverted, the revert flag (thread local) is set again when the step does run.
+         */
+        bool m_throttledRevert;
+
+        /**
+         * GVT at the last cancelback, the core holds until GVT has passed it. MAXTIME if not holding.
+         */
+        t_timestamp::t_time m_cancelbackGVT;
+
+        /**
+         * Nr of times this core rolled back to bring the history within the budget.
+         */
+        std::size_t m_cancelbacks;
         
         std::deque<n_network::hazard_pointer>                    m_processed_messages;
 
+        /**
+         * Messages taken from the network, or moved here with a model, that are not received yet.
+         * The next step receives them before the messages in the network.
+         */
+        std::vector<t_msgptr>                   m_inbox;
+
+        /**
+         * Earliest next time of the models moved to this core since the last step, MAXTIME if none.
+         * The next step reverts to it if the core is already beyond it.
+         */
+        t_timestamp::t_time m_adoptedTime;
+
+        /**
+         * Models moved to this core since the last step. If that step starts with a revert,
+         * their output is new, other output at the revert time has already been sent.
+         */
+        std::vector<t_raw_atomic>               m_adopted;
+
 	/**
-	 * Mattern 1.4, marks vcount for outgoing message
+	 * Paint an outgoing message (or antimessage) in the current color and count it for the GVT.
 	 */
 	void
 	countMessage(const t_msgptr& msg);
 
+	/**
+	 * Take part in the current GVT round, and apply a newly found GVT.
+	 * @pre Called at the start of a step, the previous step has flushed its messages.
+	 */
+	void
+	stepGVT();
+
 	/**
 	 * Send an antimessage.
 	 * Will construct an in place copy (remeber the original is shared mem),
@@ -102,33 +197,66 @@ private:
 	sendAntiMessage(const t_msgptr& msg);
 
 	/**
-	 * Waits until all send messages were received and we can move on with our GVT algorithm
-	 * @param msg the received control message
+	 * Hand all queued outgoing messages to the network.
+	 * @post all outboxes are empty.
 	 */
 	void
-	waitUntilOK(const t_controlmsg& msg, std::atomic<bool>& rungvt);
+	flushOutbox();
 
+	/**
+	 * Lazy cancellation : if msg is identical to an undone message, that message is sent again.
+	 * Identical means the same source, destination, timestamp, message type and an equal payload.
+	 * A payload type that can't be compared never matches, its undone messages are cancelled as usual.
+	 * @see n_network::Message::samePayload
+	 * @return true if a match was found, msg is then released.
+	 */
+	bool
+	matchLazyMessage(const t_msgptr& msg);
+
+	/**
+	 * Lazy cancellation : sends an antimessage for each undone message with timestamp before time,
+	 * the re-execution has passed it without producing it again.
+	 */
 	void
-	setTred(t_timestamp);
+	cancelLazyMessages(const t_timestamp& time);
+
+	/**
+	 * Lazy cancellation : cancels all undone messages if this core has no next event or stopped,
+	 * its clock won't move on to pass them.
+	 */
+	void
+	cancelIdleLazyMessages();
+
+	/**
+	 * Close a throttled stretch, if any, and add its duration to the throttled time.
+	 */
+	void
+	endThrottle();
+
+	/**
+	 * Cancelback : if the history of all cores exceeds the budget of the shared GVT, a GVT round is started,
+	 * and the core furthest ahead rolls back halfway to GVT. It then holds until the next GVT.
+	 * @return true if the core rolled back now or is still holding.
+	 * @see SharedGVT::setHistoryBudget
+	 */
+	bool
+	cancelback();
+
+	/**
+	 * Publish the current time and history of this core for the history budget, also when it is idle
+	 * or GVT has freed history, so the other cores don't see a stale slot.
+	 * An idle core publishes MAXTIME as its time.
+	 */
+	void
+	publishHistory();
+
+	/**
+	 * Count a turn for the adaptive window, every WINDOW_ADAPT_TURNS turns the window is halved if
+	 * more than 1 in 8 turns reverted, or doubled if less than 1 in 64 did.
+	 */
+	void
+	adaptWindow();
 
-	t_timestamp
-	getTred();
-        
-        t_timestamp
-        getTMin()const{return m_tmin.load();}
-        
-        void
-        setTMin(const t_timestamp& t){m_tmin.store(t.getTime());}
-        
-        void
-        receiveControlWorker(const t_controlmsg&, int round, std::atomic<bool>& rungvt);
-        
-        void
-        startGVTProcess(const t_controlmsg&, int round, std::atomic<bool>& rungvt);
-        
-        void
-        finalizeGVTRound(const t_controlmsg&, int round, std::atomic<bool>& rungvt);
-        
         /**
          * In optimistic, we can only safely destroy messages after gvt has been found.
          * Clear the vector, but mark the pointers as being processed in case we ever get
@@ -145,8 +273,37 @@ private:
          */
         void gcCollect();
 
+        /**
+         * Rebuild the model scheduler after models were added or removed.
+         */
+        void rescheduleModels();
+
+        /**
+         * Add a model that moved here from another core, with the messages it has not received yet.
+         * The messages are addressed to the model's new local id, and received by the next step.
+         * @pre messages that were in a scheduler come before the ones taken from the network.
+         */
+        void adoptModel(const t_atomicmodelptr& model, const std::vector<t_msgptr>& messages);
+
         
 protected:
+
+	/**
+	 * Check the optimism window and the history budget, and keep track of the time spent throttled by either.
+	 * A throttled core asks for a GVT round, since only a new GVT moves the window.
+	 * Called each step after the messages are received, a throttled core skips the rest of the step.
+	 * @return true if the core is live and its time is beyond GVT + window, or it holds after a cancelback.
+	 */
+	virtual
+	bool
+	throttle();
+
+	/**
+	 * Subclass hook, called from the simulation step once a new GVT is applied.
+	 */
+	virtual
+	void
+	signalGVT(){;}
         
         /**
 	 * Handle antimessage
@@ -162,17 +319,25 @@ protected:
 	handleAntiMessage(const t_msgptr& msg);
 
         /**
-         * Allow msg to be traced by (among others the GVT algorithm)
-         * @param msg
+         * Count a received message (or antimessage) for the GVT.
+         * @param c : the color it was sent in.
          */
         void
-        registerReceivedMessage(const t_msgptr& msg);
+        registerReceivedMessage(MessageColor c)
+        {
+                ++m_receivedCount[c];
+        }
         
         
         void queuePendingMessage(t_msgptr msg)override;
         
 
 public:
+	/// Nr of turns between adaptations of the optimism window.
+	static constexpr std::size_t WINDOW_ADAPT_TURNS = 1024;
+	/// An adaptive window stays within [window / WINDOW_RANGE, window * WINDOW_RANGE] of the configured window.
+	static constexpr std::size_t WINDOW_RANGE = 16;
+
 	Optimisticcore()=delete;
 	/**
 	 * MCore constructor
@@ -197,6 +362,75 @@ public:
 
         void shutDown() override;
 
+        /**
+         * Set the nr of transitions between state copies for the models that did not set their own.
+         * @param interval : 1 (the default) copies the state before each transition,
+         * AtomicModel_impl::CHECKPOINT_ADAPTIVE lets each model tune its own interval.
+         * @pre Called before initThread.
+         * @see AtomicModel_impl::setCheckpointInterval
+         */
+        void setCheckpointInterval(std::size_t interval)
+        {
+                m_checkpointInterval = interval;
+        }
+
+        /**
+         * Enable or disable lazy cancellation (default disabled).
+         * With lazy cancellation a revert does not send antimessages right away. A message the re-execution
+         * produces again is suppressed, only the undone messages it does not produce again are cancelled.
+         */
+        void setLazyCancellation(bool lazy)
+        {
+                m_lazyCancellation = lazy;
+        }
+
+        /**
+         * Bound how far the core can run ahead of GVT (default unbounded).
+         * A core whose time is beyond GVT + window does not simulate, it yields its thread until
+         * a new GVT (or a revert) brings it back within the window.
+         * @param window : 0 for an unbounded window.
+         * @param adaptive : if true the window shrinks when many turns revert, and grows when few do.
+         * @pre Called before the simulation starts.
+         */
+        void setOptimismWindow(t_timestamp::t_time window, bool adaptive = false)
+        {
+                m_window = window;
+                m_baseWindow = window;
+                m_adaptiveWindow = adaptive;
+        }
+
+        /**
+         * @return the current optimism window, 0 if unbounded.
+         */
+        t_timestamp::t_time getOptimismWindow() const
+        {
+                return m_window;
+        }
+
+        /**
+         * @return the time (us) this core has spent beyond its optimism window.
+         */
+        std::size_t getThrottledTime() const
+        {
+                return m_throttledTime;
+        }
+
+        /**
+         * @return the nr of rollbacks to keep the history within budget.
+         */
+        std::size_t getCancelbacks() const
+        {
+                return m_cancelbacks;
+        }
+
+        /**
+         * @return the nr of antimessages lazy cancellation avoided.
+         */
+        std::size_t getAvoidedCancellations() const
+        {
+                return m_avoidedCancellations;
+        }
+
 	/**
 	 * Pulls messages from network into mailbag (sorted by destination name
 	 * @attention does not yet lock on messages access
@@ -220,8 +454,7 @@ public:
 	void markMessageStored(const t_msgptr&)override;
 
 	/**
-	 * Get the current color this core is in (Mattern's)
-	 *
+	 * Get the color this core currently sends messages in.
 	 */
 	MessageColor
 	getColor()override;
@@ -237,7 +470,8 @@ public:
 	void revert(const t_timestamp& totime)override;
 
 	/**
-	 * Set core color. (Mattern's)
+	 * Set the color this core sends messages in.
+	 * @attention : the color follows the GVT epoch, only use this for a core without a shared GVT.
 	 */
 	void
 	setColor(MessageColor c)override;
@@ -249,15 +483,28 @@ public:
 	virtual void sortIncoming(const std::vector<t_msgptr>& messages);
 
 	/**
-	 * Step 1.7/1.6 in Mattern's algorithm.
-         * @param round : an integer denoting the round in the algorithm starting @0, so 1==2nd round.
+	 * Move model id to target, which must be an Optimisticcore as well.
+	 * Only a model whose last transition is before gvt can move : a later transition can still be
+	 * undone, and with it the messages it sent to models on this core, which are not kept after they are processed.
+	 * If it is not, this core reverts to gvt first.
+	 * A model with a message pending from target can't move, that message would become local to target
+	 * while target still keeps it as a sent message.
+	 * The model takes its pending messages along, including the ones still in the network.
+	 * The last model of this core takes the free local id, its messages are readdressed.
+	 * @pre No GVT round is in progress.
+	 */
+	bool
+	migrateModel(std::size_t id, Core& target, t_timestamp::t_time gvt)override;
+
+	/**
+	 * Take part in the rounds of gvt from now on.
+	 * @pre Called before the simulation starts, all cores get the same object.
 	 */
-	virtual
 	void
-	receiveControl(const t_controlmsg&, int round, std::atomic<bool>& rungvt)override;
+	setSharedGVT(const t_sharedgvtptr& gvt)override;
 
 	/**
-	 * Call superclass receive message, then decrements vcount (alg 1.5)
+	 * Call superclass receive message, then counts the message for the GVT.
 	 * @attention locked by caller on msglock
 	 */
 	virtual
@@ -292,7 +539,7 @@ public:
 
 	/**
 	 * Set current time to new value.
-	 * @synchronized on tmin, updates it to new value.
+	 * With lazy cancellation, cancels the undone messages the new time has passed first.
 	 */
 	void
 	setTime(const t_timestamp&)override;
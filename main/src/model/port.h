@@ -56,6 +56,27 @@ typedef std::pair<t_portptr_raw, t_zfunc> t_outconnect;
 
 class Model;
 
+/**
+ * @brief The type of the payload a message stores for data of type T, string literals are stored as std::string.
+ */
+template<typename T>
+struct message_payload
+{
+	typedef T type;
+};
+
+template<std::size_t N>
+struct message_payload<char[N]>
+{
+	typedef std::string type;
+};
+
+template<>
+struct message_payload<const char*>
+{
+	typedef std::string type;
+};
+
 class Port
 {
     friend class n_tools::GVizWriter;
@@ -205,7 +226,9 @@ public:
 	 * @brief Creates messages with a given payload and stores them in a container.
 	 *
 	 * These messages are addressed to all out-ports that are currently connected.
-	 * Zfunctions that apply will be called on the messages
+	 * Zfunctions that apply will be called on the messages, each of those gets its own copy of the payload.
+	 * The other messages share a single copy of the payload if there are several of them,
+	 * and the payload is not a small, trivially copyable type.
 	 *
 	 * @param message The payload of the message that is to be sent
 	 * @param container A reference to the container in which the messages will be stored
@@ -335,46 +358,63 @@ template<typename DataType>
 void Port::createMessages(const DataType& message,
         std::vector<n_network::t_msgptr>& container)
 {
+        typedef typename message_payload<DataType>::type t_payload;
         const n_model::uuid& srcuuid = this->getModelUUID();
         const n_network::t_timestamp nowtime = this->imminentTime();
+	// We want to iterate over the correct ports (whether we use direct connect or not)
+        const std::vector<t_outconnect>& outs = m_usingDirectConnect ? m_coupled_outs : m_outs;
+
+        // Messages without a zfunction share a single copy of the payload, if there is more than one.
+        n_network::SharedPayload<t_payload>* shared = nullptr;
+        if(n_network::is_shared_payload<t_payload>::value){
+#ifndef NO_TRACER
+                std::size_t copies = 1;
+#else
+                std::size_t copies = 0;
+#endif
+                for(const t_outconnect& pair : outs)
+                        copies += pair.second ? 0 : 1;
+                if(copies > 1){
+                        shared = n_tools::createPooledObject<n_network::SharedPayload<t_payload>>(message);
+                        shared->retain();       // Until all messages are created.
+                }
+        }
 	
 #ifndef NO_TRACER
 	{
                 // This message is simply to allow correct tracing of a model that generates output, but does not send it (ie trafficlight)
-		m_sentMessages.push_back(createMsg(
+                // Use dst==src to avoid overflow.
+                if(shared)
+                        m_sentMessages.push_back(n_tools::createPooledObject<n_network::MulticastMessage<t_payload>>(
+                                srcuuid, uuid(0, 0), nowtime,
+                                getPortID(), getPortID(), shared));
+                else
+                        m_sentMessages.push_back(createMsg(
                                 srcuuid, uuid(0, 0),nowtime,
                                 getPortID(), getPortID(),
-                                message, nullptr)
-                );// Use dst==src to avoid overflow.
-                
+                                message, nullptr));
 	}
 #endif
-	// We want to iterate over the correct ports (whether we use direct connect or not)
-	if (!m_usingDirectConnect) {
-		container.reserve(m_outs.size());
-		for (const t_outconnect& pair : m_outs) {
-			// We now know everything, we create the message, apply the zFunction and push it on the vector
-			container.push_back(createMsg(srcuuid, pair.first->getModelUUID(),
+	container.reserve(container.size() + outs.size());
+	for (const t_outconnect& pair : outs) {
+		// We now know everything, we create the message, apply the zFunction and push it on the vector
+		if(shared && !pair.second)
+			container.push_back(n_tools::createPooledObject<n_network::MulticastMessage<t_payload>>(
+				srcuuid, pair.first->getModelUUID(),
 				nowtime,
-				pair.first->getPortID(), getPortID(),
-				message, pair.second));
-#ifdef USE_STAT
-			++m_sendstat[pair.first];
-#endif
-		}
-	} else {
-		container.reserve(container.size() + m_coupled_outs.size());
-		for (const t_outconnect& pair : m_coupled_outs) {
+				pair.first->getPortID(), getPortID(), shared));
+		else
 			container.push_back(createMsg(srcuuid, pair.first->getModelUUID(),
 				nowtime,
 				pair.first->getPortID(), getPortID(),
 				message, pair.second));
 #ifdef USE_STAT
-			++m_sendstat[pair.first];
+		++m_sendstat[pair.first];
 #endif
-                        LOG_DEBUG("Message created == ", container.back()->toString());
-		}
+                LOG_DEBUG("Message created == ", container.back()->toString());
 	}
+        if(shared)
+                shared->release();
 }
 
 /*
@@ -0,0 +1,78 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include "model/profile.h"
+#include <cmath>
+#include <numeric>
+
+namespace n_model {
+
+std::size_t Profile::getBucket(t_time value)
+{
+	if(value <= t_time())
+		return 0;
+	if(value < t_time(2))
+		return 1;
+	return std::size_t(std::log2(double(value))) + 1;
+}
+
+void Profile::count(std::vector<std::size_t>& histogram, t_time value)
+{
+	const std::size_t bucket = getBucket(value);
+	if(histogram.size() <= bucket)
+		histogram.resize(bucket + 1, 0);
+	++histogram[bucket];
+}
+
+void Profile::setModels(const std::vector<t_atomicmodelptr>& models)
+{
+	m_models.resize(models.size());
+	for(std::size_t i = 0; i < models.size(); ++i)
+		m_models[i].m_name = models[i]->getName();
+}
+
+void Profile::countTransition(const AtomicModel_impl& model)
+{
+	ModelProfile& entry = m_models[model.getLocalID()];
+	++entry.m_transitions;
+	const t_timestamp next = model.getTimeNext();
+	if(!isInfinity(next)){
+		const t_time ta = next.getTime() - model.getTimeLast().getTime();
+		++entry.m_finite;
+		entry.m_timeAdvance += double(ta);
+		count(m_timeAdvances, ta);
+	}
+	const t_timestamp la = model.getLookahead();
+	if(isInfinity(la)){
+		++entry.m_infiniteLookahead;
+		return;
+	}
+	if(isZero(la))
+		++entry.m_zeroLookahead;
+	entry.m_lookahead += double(la.getTime());
+	count(m_lookaheads, la.getTime());
+}
+
+void Profile::countMessages(const std::vector<n_network::t_msgptr>& messages)
+{
+	for(const n_network::t_msgptr& msg : messages){
+		++m_models[msg->getSourceModel()].m_sent;
+		++m_links[Link{msg->getSourceModel(), msg->getSourcePort(), msg->getDestinationModel(),
+		        msg->getDestinationPort()}];
+	}
+}
+
+std::size_t Profile::getTransitions() const
+{
+	return std::accumulate(m_models.begin(), m_models.end(), std::size_t(0),
+	        [](std::size_t sum, const ModelProfile& entry){return sum + entry.m_transitions;});
+}
+
+} /* namespace n_model */
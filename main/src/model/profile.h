@@ -0,0 +1,153 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_MODEL_PROFILE_H_
+#define SRC_MODEL_PROFILE_H_
+
+#include <map>
+#include <vector>
+#include <string>
+#include <memory>
+#include "model/atomicmodel.h"
+
+namespace n_model {
+
+/**
+ * @brief What a (pilot) simulation run measured about its models.
+ *
+ * A single core fills this during the run : the transitions of each model, the nr of messages over each
+ * port link and the distribution of the time advance and lookahead of the transitions.
+ * Models are identified by their index in the core.
+ * @attention Only a classic (single core) simulation records a profile.
+ * @see n_control::Profiler
+ */
+class Profile
+{
+public:
+	typedef t_timestamp::t_time t_time;
+
+	/**
+	 * @brief Sums of a single model.
+	 */
+	struct ModelProfile
+	{
+		std::string m_name;
+		std::size_t m_transitions;
+		/// Nr of messages the model sent.
+		std::size_t m_sent;
+		/// Nr of transitions after which the model had a finite time advance.
+		std::size_t m_finite;
+		double m_timeAdvance;
+		/// Nr of transitions after which the lookahead was zero, resp. infinite.
+		std::size_t m_zeroLookahead;
+		std::size_t m_infiniteLookahead;
+		/// Sum of the finite lookaheads.
+		double m_lookahead;
+
+		ModelProfile()
+			: m_transitions(0), m_sent(0), m_finite(0), m_timeAdvance(0.0), m_zeroLookahead(0),
+			  m_infiniteLookahead(0), m_lookahead(0.0)
+		{
+		}
+	};
+
+	/**
+	 * @brief A connection from an output port to an input port, (model, port) ids of both ends.
+	 */
+	struct Link
+	{
+		std::size_t m_srcModel;
+		std::size_t m_srcPort;
+		std::size_t m_dstModel;
+		std::size_t m_dstPort;
+
+		bool operator<(const Link& other) const
+		{
+			if(m_srcModel != other.m_srcModel)
+				return m_srcModel < other.m_srcModel;
+			if(m_srcPort != other.m_srcPort)
+				return m_srcPort < other.m_srcPort;
+			if(m_dstModel != other.m_dstModel)
+				return m_dstModel < other.m_dstModel;
+			return m_dstPort < other.m_dstPort;
+		}
+	};
+
+private:
+	std::vector<ModelProfile> m_models;
+	std::map<Link, std::size_t> m_links;
+	std::vector<std::size_t> m_timeAdvances;
+	std::vector<std::size_t> m_lookaheads;
+
+	static void count(std::vector<std::size_t>& histogram, t_time value);
+
+public:
+	/**
+	 * Register the models of the core, in the order of their index.
+	 */
+	void setModels(const std::vector<t_atomicmodelptr>& models);
+
+	/**
+	 * Count a transition of model, after the model set its new time.
+	 */
+	void countTransition(const AtomicModel_impl& model);
+
+	/**
+	 * Count the output of a model.
+	 */
+	void countMessages(const std::vector<n_network::t_msgptr>& messages);
+
+	const std::vector<ModelProfile>& getModels() const
+	{
+		return m_models;
+	}
+
+	/**
+	 * @return the nr of messages sent over each link.
+	 */
+	const std::map<Link, std::size_t>& getLinks() const
+	{
+		return m_links;
+	}
+
+	/**
+	 * @return the nr of transitions per time advance bucket.
+	 * @see getBucket
+	 */
+	const std::vector<std::size_t>& getTimeAdvances() const
+	{
+		return m_timeAdvances;
+	}
+
+	/**
+	 * @return the nr of transitions per finite lookahead bucket.
+	 * @see getBucket
+	 */
+	const std::vector<std::size_t>& getLookaheads() const
+	{
+		return m_lookaheads;
+	}
+
+	/**
+	 * @return the histogram bucket of value : 0 for zero, b > 0 for [2^(b-1), 2^b), values below 1 are in bucket 1.
+	 */
+	static std::size_t getBucket(t_time value);
+
+	/**
+	 * @return the sum of the transitions of all models.
+	 */
+	std::size_t getTransitions() const;
+};
+
+typedef std::shared_ptr<Profile> t_profileptr;
+
+} /* namespace n_model */
+
+#endif /* SRC_MODEL_PROFILE_H_ */
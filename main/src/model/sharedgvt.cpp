@@ -0,0 +1,162 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include <algorithm>
+#include "model/sharedgvt.h"
+#include "tools/globallog.h"
+
+namespace n_model {
+
+std::size_t adaptGVTInterval(std::size_t interval, std::size_t lastInterval, std::size_t history,
+        std::size_t lastHistory, bool advanced, std::size_t maximum)
+{
+	maximum = std::max(maximum, std::size_t(1));
+	interval = std::min(std::max(interval, std::size_t(1)), maximum);
+	if(lastInterval == 0)
+		return interval;
+	// Compare history/interval against lastHistory/lastInterval without dividing.
+	const std::size_t rate = history * lastInterval;
+	const std::size_t lastRate = lastHistory * interval;
+	if(history > GVT_HISTORY_FLOOR && rate > lastRate + lastRate/2)
+		return std::max(interval/2, std::size_t(1));
+	if(advanced && rate <= lastRate + lastRate/8)
+		return std::min(interval + interval/4 + 1, maximum);
+	return interval;
+}
+
+SharedGVT::SharedGVT(std::size_t cores, std::size_t interval, bool adaptive)
+	: m_cores(cores), m_slots(cores), m_epoch(0), m_active(false), m_switched(0), m_reported(0), m_gvt(0),
+	  m_next(0), m_interval(interval), m_maximum(std::max(interval, std::size_t(1)) * GVT_BACKOFF),
+	  m_adaptive(adaptive), m_lastInterval(0), m_lastHistory(0), m_rounds(0), m_found(0), m_shorter(0), m_longer(0), m_waited(0),
+	  m_budget(0), m_cancelbacks(0)
+{
+	const auto first = std::chrono::steady_clock::now() + std::chrono::milliseconds(interval);
+	m_next.store(first.time_since_epoch().count());
+}
+
+bool SharedGVT::startIfDue()
+{
+	if(m_active.load(std::memory_order_relaxed))
+		return false;
+	if(std::chrono::steady_clock::now().time_since_epoch().count() < m_next.load(std::memory_order_relaxed))
+		return false;
+	return start();
+}
+
+bool SharedGVT::start()
+{
+	bool idle = false;
+	if(!m_active.compare_exchange_strong(idle, true))
+		return false;
+	// All cores reported in the previous round, nobody reads these until the epoch moves.
+	m_switched.store(0);
+	m_reported.store(0);
+	m_waited += m_interval.load();
+	++m_rounds;
+	m_started = std::chrono::steady_clock::now();
+	const std::size_t epoch = m_epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+	LOG_INFO("GVT :: starting round ", epoch, " after ", m_interval.load(), " ms");
+	return true;
+}
+
+void SharedGVT::switched()
+{
+	m_switched.fetch_add(1, std::memory_order_acq_rel);
+}
+
+bool SharedGVT::isDrained(std::size_t c) const
+{
+	// Sent counts are final (nobody sends in c), received counts only grow up to them.
+	std::size_t sent = 0;
+	std::size_t received = 0;
+	for(const auto& slot : m_slots){
+		sent += slot.m_sent[c].load(std::memory_order_acquire);
+		received += slot.m_received[c].load(std::memory_order_acquire);
+	}
+	return sent == received;
+}
+
+bool SharedGVT::canReport() const
+{
+	if(m_switched.load(std::memory_order_acquire) != m_cores)
+		return false;
+	return isDrained(colorOf(getEpoch() - 1));
+}
+
+bool SharedGVT::report(std::size_t core, t_time localmin, std::size_t history)
+{
+	CoreSlot& slot = m_slots[core];
+	slot.m_min.store(localmin, std::memory_order_relaxed);
+	slot.m_history.store(history, std::memory_order_relaxed);
+	if(m_reported.fetch_add(1, std::memory_order_acq_rel) + 1 != m_cores)
+		return false;
+	finishRound();
+	return true;
+}
+
+bool SharedGVT::isOverBudget() const
+{
+	if(m_budget == 0)
+		return false;
+	std::size_t history = 0;
+	for(const auto& slot : m_slots)
+		history += slot.m_live.load(std::memory_order_relaxed);
+	return history > m_budget;
+}
+
+bool SharedGVT::isFurthest(std::size_t core) const
+{
+	const t_time now = m_slots[core].m_now.load(std::memory_order_relaxed);
+	for(std::size_t i = 0; i < m_cores; ++i){
+		const t_time other = m_slots[i].m_now.load(std::memory_order_relaxed);
+		// An idle core can't cancel back.
+		if(other == n_network::t_timestamp::MAXTIME)
+			continue;
+		if(other > now || (other == now && i < core))
+			return false;
+	}
+	return true;
+}
+
+void SharedGVT::finishRound()
+{
+	t_time gvt = n_network::t_timestamp::MAXTIME;
+	std::size_t history = 0;
+	for(const auto& slot : m_slots){
+		gvt = std::min(gvt, slot.m_min.load(std::memory_order_relaxed));
+		history += slot.m_history.load(std::memory_order_relaxed);
+	}
+	const t_time last = m_gvt.load(std::memory_order_relaxed);
+	const bool advanced = gvt != n_network::t_timestamp::MAXTIME && gvt > last;
+	if(advanced){
+		m_gvt.store(gvt, std::memory_order_release);
+		++m_found;
+	}
+	LOG_INFO("GVT :: round ", getEpoch(), " found ", gvt, " in ",
+	        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-m_started).count(), " us");
+
+	std::size_t interval = m_interval.load();
+	if(m_adaptive){
+		const std::size_t next = adaptGVTInterval(interval, m_lastInterval, history, m_lastHistory, advanced, m_maximum);
+		if(next < interval)
+			++m_shorter;
+		else if(next > interval)
+			++m_longer;
+		m_lastInterval = interval;
+		m_lastHistory = history;
+		interval = next;
+		m_interval.store(interval);
+	}
+	const auto next = std::chrono::steady_clock::now() + std::chrono::milliseconds(interval);
+	m_next.store(next.time_since_epoch().count(), std::memory_order_relaxed);
+	m_active.store(false, std::memory_order_release);
+}
+
+} /* namespace n_model */
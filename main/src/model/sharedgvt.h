@@ -0,0 +1,304 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_MODEL_SHAREDGVT_H_
+#define SRC_MODEL_SHAREDGVT_H_
+
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include "network/timestamp.h"
+#include "network/message.h"
+
+namespace n_model {
+
+/**
+ * The adaptive GVT interval never exceeds the configured interval times this factor.
+ */
+constexpr std::size_t GVT_BACKOFF = 4;
+
+/**
+ * Below this nr of kept messages and states, growth is not a reason to shorten the GVT interval.
+ */
+constexpr std::size_t GVT_HISTORY_FLOOR = 1024;
+
+/**
+ * Choose the next GVT interval.
+ * The history (messages and states kept for reverts) is compared per ms of interval, so a longer interval
+ * alone does not count as growth.
+ * If the history grows more than half faster than in the previous round, the interval is halved.
+ * If the GVT advanced and the history did not grow noticeably faster, the interval backs off by a quarter.
+ * @param interval : the interval (ms) waited before the last round.
+ * @param lastInterval : the interval (ms) waited before the round before, 0 if there was none.
+ * @param history : summed history of the cores in the last round.
+ * @param lastHistory : summed history of the cores in the round before.
+ * @param advanced : true if the last round found a GVT larger than the previous one.
+ * @param maximum : upper bound for the result.
+ * @return an interval in [1, maximum]
+ */
+std::size_t adaptGVTInterval(std::size_t interval, std::size_t lastInterval, std::size_t history,
+        std::size_t lastHistory, bool advanced, std::size_t maximum);
+
+/**
+ * @brief GVT for optimistic cores sharing an address space (after Fujimoto and Hybinette).
+ *
+ * There is no GVT thread and no barrier, the cores advance a round from their own simulation step :
+ * 1. A core starts a round when the interval has elapsed, by incrementing the epoch.
+ * 2. A core that sees the new epoch switches the color it sends in, and counts itself switched.
+ * 3. Once all cores have switched, no message is sent in the old color anymore. Each core then reports its
+ *    local minimum (its time and the smallest timestamp it sent in the new color) as soon as all messages
+ *    in the old color are received.
+ * 4. The last core to report publishes the minimum of the reports as the new GVT.
+ * Sent and received messages are counted per core and color, each counter has a single writer,
+ * so sending a message takes no lock.
+ * @attention : each core id may only be used by one thread at a time.
+ */
+class SharedGVT
+{
+public:
+	typedef n_network::t_timestamp::t_time t_time;
+
+private:
+	static constexpr std::size_t CACHELINE = 64;
+
+	/**
+	 * Counters published by a single core, written only by the thread running that core.
+	 */
+	struct alignas(CACHELINE) CoreSlot
+	{
+		std::atomic<std::size_t> m_sent[2];
+		std::atomic<std::size_t> m_received[2];
+		std::atomic<t_time> m_min;
+		std::atomic<std::size_t> m_history;
+		/// Time and history as of the core's last step, for the history budget.
+		std::atomic<t_time> m_now;
+		std::atomic<std::size_t> m_live;
+
+		CoreSlot()
+			: m_min(0), m_history(0), m_now(0), m_live(0)
+		{
+			for(std::size_t c = 0; c < 2; ++c){
+				m_sent[c].store(0);
+				m_received[c].store(0);
+			}
+		}
+	};
+
+	const std::size_t m_cores;
+	std::vector<CoreSlot> m_slots;
+
+	alignas(CACHELINE) std::atomic<std::size_t> m_epoch;
+	/// True from the start of a round until the GVT is published.
+	std::atomic<bool> m_active;
+	std::atomic<std::size_t> m_switched;
+	std::atomic<std::size_t> m_reported;
+
+	alignas(CACHELINE) std::atomic<t_time> m_gvt;
+	/// Earliest start of the next round, in steady_clock ticks.
+	std::atomic<std::chrono::steady_clock::rep> m_next;
+	std::atomic<std::size_t> m_interval;
+
+	/// Only touched by the core that completes a round.
+	const std::size_t m_maximum;
+	const bool m_adaptive;
+	std::size_t m_lastInterval;
+	std::size_t m_lastHistory;
+	std::chrono::steady_clock::time_point m_started;
+
+	std::atomic<std::size_t> m_rounds;
+	std::atomic<std::size_t> m_found;
+	std::atomic<std::size_t> m_shorter;
+	std::atomic<std::size_t> m_longer;
+	std::atomic<std::size_t> m_waited;
+
+	/// Nr of messages and states all cores together may keep for reverts, 0 if unbounded.
+	std::size_t m_budget;
+	std::atomic<std::size_t> m_cancelbacks;
+
+	/**
+	 * @return true if every message sent in color c has been received.
+	 * @pre no core sends in color c.
+	 */
+	bool isDrained(std::size_t c) const;
+
+	/**
+	 * Publish the minimum of all reports and prepare the next round.
+	 */
+	void finishRound();
+
+public:
+	/**
+	 * @param cores : nr of cores taking part, core ids are [0, cores).
+	 * @param interval : time (ms) between the end of a round and the start of the next.
+	 * @param adaptive : if true the interval adapts to the growth of the cores' history.
+	 * @see adaptGVTInterval
+	 */
+	SharedGVT(std::size_t cores, std::size_t interval, bool adaptive = true);
+
+	SharedGVT(const SharedGVT&) = delete;
+	SharedGVT& operator=(const SharedGVT&) = delete;
+
+	/**
+	 * @return the current epoch, a core sends in color epoch % 2.
+	 */
+	std::size_t getEpoch() const
+	{
+		return m_epoch.load(std::memory_order_acquire);
+	}
+
+	static n_network::MessageColor colorOf(std::size_t epoch)
+	{
+		return (epoch & 1) ? n_network::MessageColor::RED : n_network::MessageColor::WHITE;
+	}
+
+	/**
+	 * @return the last published GVT, 0 if none was found yet.
+	 */
+	t_time getGVT() const
+	{
+		return m_gvt.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Start a round if none is running and the interval has elapsed.
+	 * @return true if this call started a round.
+	 */
+	bool startIfDue();
+
+	/**
+	 * Start a round if none is running.
+	 * @return true if this call started a round.
+	 */
+	bool start();
+
+	/**
+	 * @return true if a round is running.
+	 */
+	bool isActive() const
+	{
+		return m_active.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Publish the nr of messages the core has sent in color c.
+	 * @param total : count since the start of the simulation.
+	 */
+	void setSent(std::size_t core, n_network::MessageColor c, std::size_t total)
+	{
+		m_slots[core].m_sent[c].store(total, std::memory_order_release);
+	}
+
+	/**
+	 * Publish the nr of messages in color c the core has received and handled.
+	 * @param total : count since the start of the simulation.
+	 */
+	void setReceived(std::size_t core, n_network::MessageColor c, std::size_t total)
+	{
+		m_slots[core].m_received[c].store(total, std::memory_order_release);
+	}
+
+	/**
+	 * Register that a core has switched to the color of the current epoch.
+	 * @pre all messages the core sent in the previous color are published with setSent.
+	 */
+	void switched();
+
+	/**
+	 * @return true if the cores can report in the current round.
+	 */
+	bool canReport() const;
+
+	/**
+	 * Report the local minimum of core for the current round.
+	 * @param history : nr of messages and states the core keeps for reverts.
+	 * @pre canReport()
+	 * @return true if this report completed the round.
+	 */
+	bool report(std::size_t core, t_time localmin, std::size_t history);
+
+	/**
+	 * @return the interval (ms) to wait before the next round.
+	 */
+	std::size_t getInterval() const
+	{
+		return m_interval.load(std::memory_order_relaxed);
+	}
+
+	/// @return the nr of rounds started.
+	std::size_t getRounds() const
+	{ return m_rounds.load(); }
+
+	/// @return the nr of rounds that advanced the GVT.
+	std::size_t getFound() const
+	{ return m_found.load(); }
+
+	/// @return the nr of times the interval was shortened.
+	std::size_t getShortened() const
+	{ return m_shorter.load(); }
+
+	/// @return the nr of times the interval was lengthened.
+	std::size_t getLengthened() const
+	{ return m_longer.load(); }
+
+	/// @return the summed intervals (ms) waited before each round.
+	std::size_t getWaited() const
+	{ return m_waited.load(); }
+
+	/**
+	 * Bound the nr of messages and states the cores keep for reverts, summed over all cores.
+	 * @param budget : 0 (the default) for no bound.
+	 * @pre Called before the simulation starts.
+	 * @see Optimisticcore::cancelback
+	 */
+	void setHistoryBudget(std::size_t budget)
+	{
+		m_budget = budget;
+	}
+
+	std::size_t getHistoryBudget() const
+	{
+		return m_budget;
+	}
+
+	/**
+	 * Publish the time and history of core, for isOverBudget and isFurthest.
+	 */
+	void publish(std::size_t core, t_time now, std::size_t history)
+	{
+		m_slots[core].m_now.store(now, std::memory_order_relaxed);
+		m_slots[core].m_live.store(history, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @return true if the published histories together exceed the budget.
+	 */
+	bool isOverBudget() const;
+
+	/**
+	 * @return true if no other core published a later time, on equal times the lowest id is furthest.
+	 * Cores that published MAXTIME (idle) are ignored.
+	 */
+	bool isFurthest(std::size_t core) const;
+
+	/// Count a core rolled back to bring the history within budget.
+	void cancelledBack()
+	{ ++m_cancelbacks; }
+
+	/// @return the nr of cancelbacks.
+	std::size_t getCancelbacks() const
+	{ return m_cancelbacks.load(); }
+};
+
+typedef std::shared_ptr<SharedGVT> t_sharedgvtptr;
+
+} /* namespace n_model */
+
+#endif /* SRC_MODEL_SHAREDGVT_H_ */
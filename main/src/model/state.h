@@ -17,6 +17,10 @@
 #include "tools/stringtools.h"
 #include <assert.h>
 #include <typeinfo>
+#include <type_traits>
+#include <istream>
+#include <ostream>
+#include <cstdint>
 
 // representation of states
 
@@ -107,6 +111,47 @@ template<> struct ToCell<std::string> {
 	}
 };
 
+// Binary representation of states, used by snapshots.
+// The default copies the bytes of trivially copyable types, any other type needs a specialization.
+// A specialization returns false if the stream fails.
+template<typename T, typename = void> struct ToBinary {
+	static bool exec(std::ostream&, const T&) {
+		LOG_ERROR("No ToBinary::exec overload for type ", typeid(T).name());
+		return false;
+	}
+};
+template<typename T, typename = void> struct FromBinary {
+	static bool exec(std::istream&, T&) {
+		LOG_ERROR("No FromBinary::exec overload for type ", typeid(T).name());
+		return false;
+	}
+};
+template<typename T> struct ToBinary<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type> {
+	static bool exec(std::ostream& out, const T& val) {
+		return out.write(reinterpret_cast<const char*>(&val), sizeof(T)).good();
+	}
+};
+template<typename T> struct FromBinary<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type> {
+	static bool exec(std::istream& in, T& val) {
+		return in.read(reinterpret_cast<char*>(&val), sizeof(T)).good();
+	}
+};
+template<> struct ToBinary<std::string> {
+	static bool exec(std::ostream& out, const std::string& val) {
+		const uint64_t size = val.size();
+		return ToBinary<uint64_t>::exec(out, size) && out.write(val.data(), size).good();
+	}
+};
+template<> struct FromBinary<std::string> {
+	static bool exec(std::istream& in, std::string& val) {
+		uint64_t size = 0;
+		if(!FromBinary<uint64_t>::exec(in, size))
+			return false;
+		val.resize(size);
+		return size == 0 || in.read(&val[0], size).good();
+	}
+};
+
 #undef STATE_REPR_STRUCT
 #undef STATE_REPR_ARITHMETIC
 #undef STATE_REPR_ARITHMETIC_GROUP
@@ -168,6 +213,28 @@ public:
 		return "";
 	}
 
+	/**
+	 * @brief Writes the state to a binary stream
+	 * @return false if the state can't be written
+	 * @see n_control::Controller::saveSnapshot
+	 */
+	virtual bool toBinary(std::ostream&) const
+	{
+		LOG_ERROR("STATE: Not implemented: 'bool n_model::State::toBinary(std::ostream&)'");
+		return false;
+	}
+
+	/**
+	 * @brief Reads the state back from what toBinary wrote
+	 * @return false if the state can't be read
+	 * @see n_control::Controller::loadSnapshot
+	 */
+	virtual bool fromBinary(std::istream&)
+	{
+		LOG_ERROR("STATE: Not implemented: 'bool n_model::State::fromBinary(std::istream&)'");
+		return false;
+	}
+
 	virtual ~State()
 	{
 	}
@@ -277,6 +344,24 @@ public:
 		return ToCell<t_type>::exec(m_value);
 	}
 
+	/**
+	 * @brief Writes the state to a binary stream
+	 * @see ToBinary
+	 */
+	virtual bool toBinary(std::ostream& out) const override
+	{
+		return ToBinary<t_type>::exec(out, m_value);
+	}
+
+	/**
+	 * @brief Reads the state from a binary stream
+	 * @see FromBinary
+	 */
+	virtual bool fromBinary(std::istream& in) override
+	{
+		return FromBinary<t_type>::exec(in, m_value);
+	}
+
 	/**
 	 * Destroys this object by running the destructor and removing it from the heap.
 	 * Note: only call this method if the object was created with an object pool.
@@ -343,6 +428,16 @@ public:
 		return "";
 	}
 
+	virtual bool toBinary(std::ostream&) const override
+	{
+		return true;
+	}
+
+	virtual bool fromBinary(std::istream&) override
+	{
+		return true;
+	}
+
 	/**
      * Destroys this object by running the destructor and removing it from the heap.
 	 */
@@ -353,4 +448,12 @@ public:
 };
 }
 
+namespace n_pools {
+/**
+ * States are copied at every transition by the optimistic kernels, these come from slabs of a single size class.
+ */
+template<typename T>
+struct size_class_pooled<n_model::State__impl<T>>: public std::true_type{};
+}
+
 #endif /* STATE_H_ */
@@ -0,0 +1,91 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_MODEL_SWITCHPOLICY_H_
+#define SRC_MODEL_SWITCHPOLICY_H_
+
+#include <memory>
+#include <cstddef>
+
+namespace n_model {
+
+/**
+ * Synchronization protocol a Hybridcore is running.
+ */
+enum class SyncMode{
+	CONSERVATIVE,	///< only simulate up to the time all other cores have reached.
+	OPTIMISTIC	///< simulate ahead, revert on stragglers.
+};
+
+/**
+ * What a Hybridcore measured since the last GVT.
+ */
+struct SyncCounts{
+	/// Nr of simulation steps.
+	std::size_t m_turns;
+	/// Nr of steps that waited on another core (conservative).
+	std::size_t m_stalls;
+	/// Nr of reverts.
+	std::size_t m_reverts;
+
+	SyncCounts()
+		: m_turns(0), m_stalls(0), m_reverts(0)
+	{;}
+};
+
+/**
+ * Decides the protocol of a Hybridcore each time a new GVT is found.
+ * Subclass to provide another policy.
+ * @attention : a policy is shared by all cores, choose is called concurrently.
+ */
+class SwitchPolicy{
+public:
+	SwitchPolicy() = default;
+	virtual ~SwitchPolicy(){;}
+
+	/**
+	 * @param current : the protocol the core ran since the last GVT.
+	 * @param counts : what the core measured since the last GVT, counts.m_turns > 0.
+	 * @return the protocol to run until the next GVT.
+	 */
+	virtual
+	SyncMode
+	choose(SyncMode current, const SyncCounts& counts) const = 0;
+};
+
+/**
+ * Default policy : a conservative core that stalls more often than stallRatio of its turns switches to optimistic,
+ * an optimistic core that reverts more often than revertRatio of its turns switches to conservative.
+ */
+class ThresholdSwitchPolicy: public SwitchPolicy{
+private:
+	double m_stallRatio;
+	double m_revertRatio;
+public:
+	ThresholdSwitchPolicy(double stallRatio = 0.5, double revertRatio = 0.2)
+		: m_stallRatio(stallRatio), m_revertRatio(revertRatio)
+	{;}
+
+	SyncMode
+	choose(SyncMode current, const SyncCounts& counts) const override
+	{
+		if(current == SyncMode::CONSERVATIVE && counts.m_stalls > m_stallRatio * counts.m_turns)
+			return SyncMode::OPTIMISTIC;
+		if(current == SyncMode::OPTIMISTIC && counts.m_reverts > m_revertRatio * counts.m_turns)
+			return SyncMode::CONSERVATIVE;
+		return current;
+	}
+};
+
+typedef std::shared_ptr<SwitchPolicy> t_switchpolicyptr;
+
+} /* namespace n_model */
+
+#endif /* SRC_MODEL_SWITCHPOLICY_H_ */
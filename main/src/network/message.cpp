@@ -29,13 +29,61 @@ n_network::operator<<(std::ostream& os, const n_network::MessageColor& c){
 }
 
 
+namespace {
+
+void releaseMessage(n_network::Message* msg)
+{
+        n_tools::destroyPooledObject<n_network::Message>(msg);
+}
+
+void deleteMessage(n_network::Message* msg)
+{
+        delete msg;
+}
+
+n_network::Message* copyMessage(const n_network::Message* msg)
+{
+        return n_tools::createPooledObject<n_network::Message>(msg);
+}
+
+void formatMessage(std::ostream&, const n_network::Message*)
+{
+        LOG_ERROR("Message::getPayload called on base class.");
+        LOG_FLUSH;
+        throw std::logic_error("Message::getPayload called on base class.");
+}
+
+/**
+ * Nr of registered types, Message itself is registered statically.
+ */
+std::atomic<std::size_t> registeredTypes(1);
+
+}
+
+n_network::MessageOps n_network::messageTypes[n_const::msgtype_max] = {{&releaseMessage, &deleteMessage, &copyMessage, &formatMessage, nullptr}};
+
+n_network::t_msgtype
+n_network::registerMessageType(const MessageOps& ops)
+{
+        const std::size_t type = registeredTypes.fetch_add(1);
+        if(type >= n_const::msgtype_max){
+                LOG_ERROR("Too many message types, maximum is ", n_const::msgtype_max);
+                LOG_FLUSH;
+                throw std::length_error("Too many message types.");
+        }
+        messageTypes[type] = ops;
+        return static_cast<t_msgtype>(type);
+}
+
 n_network::Message::Message(const n_model::uuid& srcUUID, const n_model::uuid& dstUUID, const t_timestamp& time_made,
-				const std::size_t& destport, const std::size_t& sourceport)
+				const std::size_t& destport, const std::size_t& sourceport, t_msgtype type)
 		:
 		m_timestamp(time_made),
                 m_src_id(sourceport, srcUUID.m_core_id, srcUUID.m_local_id),
                 m_dst_id(destport, dstUUID.m_core_id, dstUUID.m_local_id),
-                m_atomic_flags(0u)
+                m_type(type),
+                m_sender_flags(0u),
+                m_receiver_flags(0u)
 	{
 #ifdef  SAFETY_CHECKS
                 if(std::max(destport, sourceport) > n_const::port_max)
@@ -60,7 +108,7 @@ n_network::Message::toString() const
         result << " to core " << getDestinationCore() ;
 	result << " payload " << this->getPayload();
 	result << " color : " << this->getColor();
-	result << " flags: " << std::bitset<8>(m_atomic_flags.load());
+	result << " flags: " << std::bitset<8>(m_sender_flags.load() | m_receiver_flags.load());
 	if(isAntiMessage()){
 		result << " anti="<< std::boolalpha << isAntiMessage();
 	}
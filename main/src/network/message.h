@@ -22,6 +22,8 @@
 #include <iosfwd>
 #include <atomic>
 #include <cstdint>
+#include <type_traits>
+#include <cstring>
 
 namespace n_network {
 
@@ -37,13 +39,76 @@ enum MessageColor : uint8_t{WHITE = 0, RED = 1};
 // 2^4: ANTI? The message is an anti message
 // 2^5: KILL? The message can be safely killed by the sending core.
 // 2^6: ERASE? When found in the message scheduler, this message can be safely ignored.
-enum Status : uint8_t{COLOR=MessageColor::RED, DELETE=2, PROCESSED=4, HEAPED=8, ANTI=16, KILL=32, ERASE=64};
+// 2^7: ANTICOLOR : color of the antimessage, the original keeps its own color while it can be in transit.
+enum Status : uint8_t{COLOR=MessageColor::RED, DELETE=2, PROCESSED=4, HEAPED=8, ANTI=16, KILL=32, ERASE=64, ANTICOLOR=128};
+// Color, anti and anticolor are only written by the sending core, the others only by the receiving core.
+// Each side has its own flag word.
+constexpr uint8_t sender_flags = Status::COLOR | Status::ANTI | Status::ANTICOLOR;
 
 std::ostream&
 operator<<(std::ostream& os, const MessageColor& c);
 
+class Message;
+
+/**
+ * Identifies the runtime type of a message, index in messageTypes.
+ */
+typedef uint16_t t_msgtype;
+
+/**
+ * @brief The operations that depend on the runtime type of a message.
+ * A message stores the index of its type in messageTypes instead of a vtable pointer,
+ * so the header holds only what the kernel needs. Only release, copy and equal are used while simulating,
+ * format is used by tracers and logging.
+ * @see messageType
+ */
+struct MessageOps
+{
+	/**
+	 * Destruct and return the message to the pool it was created from.
+	 */
+	void (*m_release)(Message*);
+	/**
+	 * Destruct and delete a message created with createRawObject.
+	 */
+	void (*m_delete)(Message*);
+	/**
+	 * Create a pooled copy.
+	 */
+	Message* (*m_copy)(const Message*);
+	/**
+	 * Write the payload to a stream.
+	 */
+	void (*m_format)(std::ostream&, const Message*);
+	/**
+	 * Compare the payloads of two messages of this type, nullptr if the payload type can't be compared.
+	 */
+	bool (*m_equal)(const Message*, const Message*);
+};
+
+namespace n_const{
+        /**
+         * Maximum nr of message types in a single executable.
+         */
+        constexpr std::size_t msgtype_max = 256;
+}
+
+/**
+ * All registered message types. Entry 0 is Message itself.
+ */
+extern MessageOps messageTypes[n_const::msgtype_max];
+
+/**
+ * Add a message type to messageTypes.
+ * @return The type id.
+ * @throw std::length_error if more than n_const::msgtype_max types are registered.
+ */
+t_msgtype registerMessageType(const MessageOps& ops);
+
 /**
  * A Message representing an event passed between models.
+ * Messages have no virtual functions, the runtime type is found by the type id.
+ * Derived classes register themselves with messageType, and must not add virtual functions either.
  */
 class /* __attribute__((aligned(64)))*/Message
 {
@@ -59,14 +124,50 @@ protected:
         const mid             m_src_id;
 
         /**
-         * Unique destination identifier.
+         * Unique destination identifier, only changes if the destination model moves to another core.
          */
-        const mid             m_dst_id;
+        mid                   m_dst_id;
         
         typedef uint8_t         t_flag_word;
-    
-	std::atomic<t_flag_word> m_atomic_flags;
-        
+
+        /**
+         * Index in messageTypes.
+         */
+        const t_msgtype         m_type;
+
+	/**
+	 * Flags written by the sending core (sender_flags) and by the receiving core.
+	 */
+	std::atomic<t_flag_word> m_sender_flags;
+	std::atomic<t_flag_word> m_receiver_flags;
+
+        std::atomic<t_flag_word>& flagWord(Status st)
+        {
+                return (st & sender_flags) ? m_sender_flags : m_receiver_flags;
+        }
+
+        const std::atomic<t_flag_word>& flagWord(Status st)const
+        {
+                return (st & sender_flags) ? m_sender_flags : m_receiver_flags;
+        }
+
+	/**
+	 * @brief Constructor for derived classes.
+	 * @param type : the id of the runtime type, from messageType.
+	 */
+	Message(const n_model::uuid& srcUUID, const n_model::uuid& dstUUID,
+	const t_timestamp& time_made,
+	const std::size_t& destport, const std::size_t& sourceport, t_msgtype type);
+
+	/**
+	 * @brief Copy constructor for derived classes, the flags of the copy are cleared.
+	 */
+	Message(const Message* original, t_msgtype type)
+		: m_timestamp(original->m_timestamp), m_src_id(original->m_src_id), m_dst_id(original->m_dst_id),
+		  m_type(type), m_sender_flags(0u), m_receiver_flags(0u)
+	{
+	}
+
         Message(const Message&) = delete;
         Message(const Message&&) = delete;
         Message& operator=(const Message&)=delete;
@@ -85,7 +186,36 @@ public:
 	 */
 	Message(const n_model::uuid& srcUUID, const n_model::uuid& dstUUID,
 	const t_timestamp& time_made,
-	const std::size_t& destport, const std::size_t& sourceport);
+	const std::size_t& destport, const std::size_t& sourceport)
+		: Message(srcUUID, dstUUID, time_made, destport, sourceport, 0u)
+	{
+	}
+
+	/**
+	 * @brief Constructor for a copy of a message, the flags of the copy are cleared.
+	 * @see copyMessage
+	 */
+	explicit Message(const Message* original)
+		: Message(original, 0u)
+	{
+	}
+
+	/**
+	 * @brief Creates a pooled copy of this message, the flags of the copy are cleared.
+	 * The copy is independent of this message, release it with releaseMe.
+	 */
+	Message* copyMessage() const
+	{
+		return messageTypes[m_type].m_copy(this);
+	}
+
+	/**
+	 * @return The id of the runtime type of this message.
+	 */
+	t_msgtype getType() const
+	{
+		return m_type;
+	}
 
         std::size_t getDestinationPort() const
         { 
@@ -102,6 +232,15 @@ public:
                 return m_dst_id.modelid();
         }
         
+        /**
+         * Address the message to the destination model at its new location, the port is unchanged.
+         * @attention : only while no other thread can read the message.
+         */
+        void setDestination(std::size_t core, std::size_t model)
+        {
+                m_dst_id = mid(m_dst_id.portid(), core, model);
+        }
+
         std::size_t getSourceCore() const
 	{
 		return m_src_id.coreid();
@@ -120,19 +259,19 @@ public:
 	void setAntiMessage(bool b)
 	{
         if(b)
-            m_atomic_flags |= Status::ANTI;
+            m_sender_flags |= Status::ANTI;
         else
-            m_atomic_flags &= ~Status::ANTI;
+            m_sender_flags &= ~Status::ANTI;
 	}
 
 	bool isAntiMessage() const
 	{
-		return (m_atomic_flags & Status::ANTI);
+		return (m_sender_flags & Status::ANTI);
 	}
         
 	MessageColor getColor() const
 	{       
-                return static_cast<MessageColor>(m_atomic_flags & MessageColor::RED);
+                return static_cast<MessageColor>(m_sender_flags & MessageColor::RED);
 	}
 
 	/**
@@ -144,9 +283,27 @@ public:
 	void paint(MessageColor newcolor)
 	{
                 if(newcolor==MessageColor::RED)
-                    m_atomic_flags |= newcolor;
+                    m_sender_flags |= newcolor;
                 else
-                    m_atomic_flags &= ~MessageColor::RED;
+                    m_sender_flags &= ~MessageColor::RED;
+	}
+
+	/**
+	 * @return the color the antimessage for this message was sent in.
+	 * @pre isAntiMessage()
+	 */
+	MessageColor getAntiColor() const
+	{
+                return (m_sender_flags & Status::ANTICOLOR) ? MessageColor::RED : MessageColor::WHITE;
+	}
+
+	/**
+	 * @brief Sets the color of the antimessage, leaves the color of the original untouched.
+	 * @see paint
+	 */
+	void paintAnti(MessageColor newcolor)
+	{
+                setFlag(Status::ANTICOLOR, newcolor==MessageColor::RED);
 	}
 
         
@@ -154,14 +311,14 @@ public:
         {
             LOG_DEBUG("setting ", newst, " flag of ", this, " ", toString(), " to ", value);
             if(value)
-                m_atomic_flags |= newst;
+                flagWord(newst) |= newst;
             else
-                m_atomic_flags &= ~newst;
+                flagWord(newst) &= ~newst;
         }
 
         bool flagIsSet(Status st)const
         {
-            return (m_atomic_flags & st);   
+            return (flagWord(st) & st);   
             //In general should be (flag & mask) == mask, but conversion to bool serves fine.
         }
 
@@ -173,12 +330,22 @@ public:
 	 * trace output for the sent/received messages.
 	 * @see n_network::getMsgPayload To extract the actual payload, instead of just a string representation.
 	 */
-	virtual std::string getPayload() const
+	std::string getPayload() const
+	{
+		std::stringstream ssr;
+		messageTypes[m_type].m_format(ssr, this);
+		return ssr.str();
+	}
+
+	/**
+	 * @return true if other has the same type as this message and an equal payload.
+	 * Always false for a payload type without operator== that is not trivially copyable.
+	 * @see PayloadEqual
+	 */
+	bool samePayload(const Message* other) const
 	{
-		LOG_ERROR("Message::getPayload called on base class.");
-                LOG_FLUSH;
-                throw std::logic_error("Message::getPayload called on base class.");
-		return "";
+		const auto equal = messageTypes[m_type].m_equal;
+		return other->m_type == m_type && equal && equal(this, other);
 	}
 
 	/**
@@ -188,7 +355,7 @@ public:
 	 * @see getPayload For how to retrieve the string representation of the payload.
 	 * @see n_network::getMsgPayload For a more convenient way to get the payload of any message.
 	 */
-	virtual std::string toString() const;
+	std::string toString() const;
 
 	/**
 	 * @brief Returns the timestamp of the message. That is, the time of creation.
@@ -215,9 +382,18 @@ public:
          * @pre This object was allocated using the registered pool. This will invoke the destructor.
          * @post The object is no longer accessible.
          */
-        virtual void releaseMe()
+        void releaseMe()
         {
-                n_tools::destroyPooledObject<typename std::remove_pointer<decltype(this)>::type>(this);
+                messageTypes[m_type].m_release(this);
+        }
+
+        /**
+         * Delete a message created with createRawObject, the destructor of its runtime type is invoked.
+         * @post The object is no longer accessible.
+         */
+        void deleteMe()
+        {
+                messageTypes[m_type].m_delete(this);
         }
 
 	/**
@@ -232,7 +408,7 @@ public:
 		m_timestamp = t_timestamp(m_timestamp.getTime(), causal);
 	}
 
-	virtual ~Message()
+	~Message()
 	{
         ;
 	}
@@ -257,6 +433,88 @@ public:
         
 };
 
+static_assert(sizeof(Message) <= sizeof(t_timestamp) + 3*sizeof(t_word), "Message header should be timestamp, ids and type/flags.");
+
+/**
+ * True if T has an operator==.
+ */
+template<typename T, typename = void>
+struct has_equality: std::false_type{};
+template<typename T>
+struct has_equality<T, decltype(void(std::declval<const T&>() == std::declval<const T&>()))>: std::true_type{};
+
+/**
+ * @brief Compares two payloads of type DataType : with operator== if it has one, else bytewise if it is
+ * trivially copyable. Other types can't be compared, value is false and there is no exec.
+ */
+template<typename DataType, typename = void>
+struct PayloadEqual: std::false_type
+{
+};
+template<typename DataType>
+struct PayloadEqual<DataType, typename std::enable_if<has_equality<DataType>::value>::type>: std::true_type
+{
+	static bool exec(const DataType& left, const DataType& right)
+	{
+		return left == right;
+	}
+};
+template<typename DataType>
+struct PayloadEqual<DataType, typename std::enable_if<!has_equality<DataType>::value
+	&& std::is_trivially_copyable<DataType>::value>::type>: std::true_type
+{
+	static bool exec(const DataType& left, const DataType& right)
+	{
+		return std::memcmp(&left, &right, sizeof(DataType)) == 0;
+	}
+};
+
+/**
+ * @return MessageOps::m_equal for message type M.
+ */
+template<typename M, typename DataType = typename std::decay<decltype(std::declval<const M&>().getData())>::type>
+typename std::enable_if<PayloadEqual<DataType>::value, bool (*)(const Message*, const Message*)>::type
+payloadEqual()
+{
+        return [](const Message* left, const Message* right)->bool{
+                return PayloadEqual<DataType>::exec(static_cast<const M*>(left)->getData(), static_cast<const M*>(right)->getData());
+        };
+}
+template<typename M, typename DataType = typename std::decay<decltype(std::declval<const M&>().getData())>::type>
+typename std::enable_if<!PayloadEqual<DataType>::value, bool (*)(const Message*, const Message*)>::type
+payloadEqual()
+{
+        return nullptr;
+}
+
+/**
+ * @return The type id of message type M, registered on first use.
+ */
+template<typename M>
+t_msgtype messageType()
+{
+        struct ops{
+                static void release(Message* msg)
+                {
+                        n_tools::destroyPooledObject<M>(static_cast<M*>(msg));
+                }
+                static void remove(Message* msg)
+                {
+                        delete static_cast<M*>(msg);
+                }
+                static Message* copy(const Message* msg)
+                {
+                        return n_tools::createPooledObject<M>(static_cast<const M*>(msg));
+                }
+                static void format(std::ostream& os, const Message* msg)
+                {
+                        os << static_cast<const M*>(msg)->getData();
+                }
+        };
+        static const t_msgtype type = registerMessageType(MessageOps{&ops::release, &ops::remove, &ops::copy, &ops::format, payloadEqual<M>()});
+        return type;
+}
+
 bool operator<(const Message& left, const Message& right);
 
         
@@ -280,6 +538,90 @@ bool operator!=(const Message& left, const Message& right);
 typedef std::shared_ptr<Message> t_shared_msgptr;
 typedef Message* t_msgptr;
 
+/**
+ * @brief Payload shared by all messages created by a single output over several connections.
+ * The payload is reference counted, the last message that lets go of it returns it to the pool.
+ * @see MulticastMessage
+ */
+template<typename DataType>
+class SharedPayload
+{
+private:
+	const DataType m_data;
+	std::atomic<std::size_t> m_refs;
+
+	SharedPayload(const SharedPayload&) = delete;
+	SharedPayload& operator=(const SharedPayload&) = delete;
+public:
+	template<typename ArgType>
+	explicit SharedPayload(const ArgType& data)
+		: m_data(data), m_refs(0)
+	{
+	}
+
+	const DataType& getData() const
+	{
+		return m_data;
+	}
+
+	void retain()
+	{
+		m_refs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @post If this was the last reference, this object is no longer accessible.
+	 */
+	void release()
+	{
+		if(m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			n_tools::destroyPooledObject<SharedPayload<DataType>>(this);
+	}
+};
+
+/**
+ * @brief True if a DataType is expensive enough to copy that messages should share it.
+ * Small trivially copyable payloads are cheaper to copy than to reference count.
+ */
+template<typename DataType>
+struct is_shared_payload: std::integral_constant<bool,
+	!(std::is_trivially_copyable<DataType>::value && sizeof(DataType) <= 2*sizeof(void*))>
+{
+};
+
+/**
+ * @brief Base class for messages with a (non-string) payload, the payload is stored by the derived class.
+ * @tparam DataType The type of the data that will be stored as the payload of the message.
+ * @see SpecializedMessage, MulticastMessage
+ */
+template<typename DataType>
+class PayloadMessage: public Message
+{
+private:
+	const DataType* const m_payload;
+protected:
+	PayloadMessage(const n_model::uuid& srcUUID, const n_model::uuid& dstUUID, const t_timestamp& time_made,
+		const std::size_t& destport, const std::size_t& sourceport, t_msgtype type, const DataType* payload)
+		: Message(srcUUID, dstUUID, time_made, destport, sourceport, type), m_payload(payload)
+	{
+	}
+
+	PayloadMessage(const Message* original, t_msgtype type, const DataType* payload)
+		: Message(original, type), m_payload(payload)
+	{
+	}
+public:
+	/**
+	 * @brief Retrieves the (non-string) payload of the message
+	 * @see n_network::getMsgPayload For a more convenient way to get the payload of any message.
+	 */
+	const DataType& getData() const
+	{
+		return *m_payload;
+	}
+
+};
+
 /**
  * @brief Message class for sending data that is not a string.
  * @tparam DataType The type of the data that will be stored as the payload of the message.
@@ -289,7 +631,7 @@ typedef Message* t_msgptr;
  * @see n_model::Port::createMessages for creating the correct message type.
  */
 template<typename DataType>
-class /*__attribute__((aligned(64)))*/ SpecializedMessage: public Message
+class /*__attribute__((aligned(64)))*/ SpecializedMessage: public PayloadMessage<DataType>
 {
 private:
 	const DataType m_data;
@@ -307,43 +649,64 @@ public:
 	 * @attention Core id is initialized at limits::max().
 	 */
 	SpecializedMessage(n_model::uuid srcUUID, n_model::uuid dstUUID, const t_timestamp& time_made, const std::size_t& destport, const std::size_t& sourceport, const DataType& data):
-		Message(srcUUID, dstUUID, time_made, destport, sourceport),
+		PayloadMessage<DataType>(srcUUID, dstUUID, time_made, destport, sourceport, messageType<SpecializedMessage<DataType>>(), &m_data),
 		m_data(data)
 	{
 	}
-                
+
+	/**
+	 * @brief Constructor for a copy of a message, the flags of the copy are cleared.
+	 * @see copyMessage
+	 */
+	explicit SpecializedMessage(const SpecializedMessage* original)
+		: PayloadMessage<DataType>(original, original->getType(), &m_data), m_data(original->m_data)
+	{
+	}
+
         ~SpecializedMessage(){;}        
+};
 
+/**
+ * @brief Message that points to a payload shared with the other messages of the same output.
+ * Used by Port::createMessages for an output over several connections, so the payload
+ * is allocated and copied only once.
+ * @see SharedPayload
+ */
+template<typename DataType>
+class MulticastMessage: public PayloadMessage<DataType>
+{
+private:
+	SharedPayload<DataType>* const m_shared;
+public:
 	/**
-	 * @brief Retrieves the (non-string) payload of the message
-	 * @see n_network::getMsgPayload For a more convenient way to get the payload of any message.
+	 * @param shared : the payload, this message holds a reference to it until it is released.
+	 * @see SpecializedMessage for the other parameters.
 	 */
-	const DataType& getData() const{
-		return m_data;
+	MulticastMessage(n_model::uuid srcUUID, n_model::uuid dstUUID, const t_timestamp& time_made, const std::size_t& destport, const std::size_t& sourceport, SharedPayload<DataType>* shared):
+		PayloadMessage<DataType>(srcUUID, dstUUID, time_made, destport, sourceport, messageType<MulticastMessage<DataType>>(), &shared->getData()),
+		m_shared(shared)
+	{
+		m_shared->retain();
 	}
 
 	/**
-	 * @brief Returns a string representation of the payload of this message.
-	 * @see n_network::getMsgPayload For a more convenient way to get the payload of any message.
+	 * @brief Constructor for a copy of a message, the flags of the copy are cleared.
+	 * The copy shares the payload of the original.
+	 * @see copyMessage
 	 */
-	virtual std::string getPayload() const override
+	explicit MulticastMessage(const MulticastMessage* original)
+		: PayloadMessage<DataType>(original, original->getType(), &original->m_shared->getData()), m_shared(original->m_shared)
 	{
-		std::stringstream ssr;
-		const DataType& data = getData();
-		ssr << data;
-		return ssr.str();
+		m_shared->retain();
 	}
-        
-        /**
-         * Deregister object with pool. This will invoke the destructor.
-         * @pre This object was allocated using the registered pool.
-         * @post This object is no longer accessible.
-         */
-        virtual void releaseMe()override
-        {
-                n_tools::destroyPooledObject<typename std::remove_pointer<decltype(this)>::type>(this);
-        }
 
+	/**
+	 * Releases the payload if no other message uses it.
+	 */
+	~MulticastMessage()
+	{
+		m_shared->release();
+	}
 };
 
 
@@ -356,7 +719,7 @@ public:
  */
 template<typename T>
 const T& getMsgPayload(const t_msgptr& msg){
-        return n_tools::staticRawCast<const n_network::SpecializedMessage<T>>(msg)->getData();
+        return n_tools::staticRawCast<const n_network::PayloadMessage<T>>(msg)->getData();
 }
 
 
@@ -374,6 +737,16 @@ struct hazard_pointer{
 
 } // end namespace n_network
 
+namespace n_pools {
+/**
+ * Messages are allocated and released in large numbers, from slabs of a single size class.
+ */
+template<typename DataType>
+struct size_class_pooled<n_network::SpecializedMessage<DataType>>: public std::true_type{};
+template<typename DataType>
+struct size_class_pooled<n_network::MulticastMessage<DataType>>: public std::true_type{};
+} // end namespace n_pools
+
 /**
  * @brief Hash specialization for Message
  */
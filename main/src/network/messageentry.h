@@ -75,6 +75,18 @@ public:
 	}
 };
 
+/**
+ * Numeric key of an entry for bucket based schedulers, a smaller key is scheduled first.
+ * @see n_scheduler::LadderScheduler
+ */
+struct MessageEntryTime
+{
+	double operator()(const MessageEntry& entry) const
+	{
+		return double(entry.getMessage()->getTimeStamp().getTime());
+	}
+};
+
 }
 
 namespace std {
@@ -9,6 +9,8 @@
  */
 
 #include "network/network.h"
+#include "network/spscnetwork.h"
+#include "tools/objectfactory.h"
 #include <assert.h>
 
 namespace n_network {
@@ -19,6 +21,11 @@ Network::Network(size_t cores)
 	LOG_DEBUG("NETWORK: Network constructor with ", cores, " queues.");
 }
 
+Network::Network(size_t cores, size_t queues)
+	: m_cores(cores), m_queues(queues),m_count(0)
+{
+}
+
 void Network::acceptMessage(const t_msgptr& msg)
 {
         ++m_count;
@@ -61,4 +68,15 @@ bool Network::empty()const{
         return (m_count==0);
 }
 
+t_networkptr createNetwork(NetworkType type, size_t cores)
+{
+	switch(type){
+	case NetworkType::SPSC:
+		return n_tools::createObject<SPSCNetwork>(cores);
+	case NetworkType::LOCKED:
+	default:
+		return n_tools::createObject<Network>(cores);
+	}
+}
+
 }
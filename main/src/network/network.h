@@ -19,6 +19,17 @@
 
 namespace n_network{
 
+/**
+ * Selects the Network implementation a parallel simulation uses.
+ */
+enum class NetworkType
+{
+	/** One synchronized queue per destination core. */
+	LOCKED,
+	/** A lock free ring buffer per (source, destination) pair. @see SPSCNetwork */
+	SPSC
+};
+
 /**
  * Abstraction of Network (Cores communicating via network).
  * Receives (push) messages from cores, messages are pulled from destination core.
@@ -29,6 +40,15 @@ private:
 	size_t	m_cores;
 	std::vector<Msgqueue<t_msgptr>> m_queues;
         std::atomic<int_fast64_t> m_count;
+
+protected:
+	/**
+	 * Create a network object with #cores, but only #queues synchronized queues.
+	 * For subclasses that replace the queues.
+	 */
+	Network(size_t cores, size_t queues);
+
+	size_t coreAmount()const{return m_cores;}
 	
 public:
 	typedef std::vector<t_msgptr> t_messages;
@@ -42,13 +62,14 @@ public:
         
         /**
          */
-        ~Network() = default;
+        virtual ~Network() = default;
 
 	/**
 	 * Called by a core pushing a message to the network.
 	 * @pre : msg has destination core id set.
 	 * @post : msg will be queued for destination.
 	 */
+	virtual
 	void
 	acceptMessage(const t_msgptr& msg);
 
@@ -61,6 +82,7 @@ public:
 	 * @pre: All messages in msgs have coreID as destination.
 	 * @post: all messages will be queued for the destination core.
 	 */
+	virtual
 	void
 	giveMessages(size_t coreID, const std::vector<t_msgptr>& msgs);
 
@@ -70,6 +92,7 @@ public:
 	 * @attention locked
 	 * @pre coreid < cores
 	 */
+	virtual
 	t_messages
 	getMessages(std::size_t coreid);
 
@@ -77,14 +100,16 @@ public:
 	 * Check if the network has any pending messages.
 	 * Use this if you don't want to pop pending messages, only check for them.
 	 */
+	virtual
 	bool
 	havePendingMessages(std::size_t coreid)const;
         
+        virtual
         bool
         empty()const;
 
 //-------------statistics gathering--------------
-	void printStats(std::ostream& out = std::cout) const
+	virtual void printStats(std::ostream& out = std::cout) const
 	{
 #ifdef USE_STAT
 		for(const auto& i:m_queues)
@@ -96,6 +121,12 @@ public:
 
 typedef std::shared_ptr<Network> t_networkptr;
 
+/**
+ * Create a network of the given type for #cores.
+ */
+t_networkptr
+createNetwork(NetworkType type, size_t cores);
+
 }// end namespace
 
 
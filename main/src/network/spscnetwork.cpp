@@ -0,0 +1,118 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2015 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include "network/spscnetwork.h"
+#include "tools/statistic.h"
+#include <assert.h>
+#include <cstdlib>
+#include <new>
+
+namespace n_network {
+
+constexpr std::size_t SPSCNetwork::DEFAULT_CAPACITY;
+
+void SPSCNetwork::ChannelDeleter::operator()(Channel* ch) const
+{
+	ch->~Channel();
+	free(ch);
+}
+
+SPSCNetwork::t_channelptr SPSCNetwork::makeChannel(std::size_t capacity)
+{
+	void* mem = nullptr;
+	if(posix_memalign(&mem, alignof(Channel), sizeof(Channel)) != 0)
+		throw std::bad_alloc();
+	try{
+		return t_channelptr(new (mem) Channel(capacity));
+	}catch(...){
+		free(mem);
+		throw;
+	}
+}
+
+SPSCNetwork::SPSCNetwork(size_t cores, size_t capacity)
+	: Network(cores, 0)
+{
+	m_channels.reserve(cores*cores);
+	for(size_t i = 0; i < cores*cores; ++i)
+		m_channels.push_back(makeChannel(capacity));
+	LOG_DEBUG("NETWORK: SPSC Network constructor with ", cores, " cores, channel capacity ", capacity);
+}
+
+void SPSCNetwork::acceptMessage(const t_msgptr& msg)
+{
+	channel(msg->getSourceCore(), msg->getDestinationCore()).push(msg);
+	LOG_DEBUG("\tNETWORK: SPSC Network accepting message");
+}
+
+void SPSCNetwork::giveMessages(size_t coreID, const std::vector<t_msgptr>& msgs)
+{
+	if(msgs.empty())
+		return;
+#ifdef SAFETY_CHECKS
+	assert(coreID < coreAmount() && "The coreID is invalid.");
+	for(t_msgptr msg: msgs){
+		assert(coreID == msg->getDestinationCore() && "All messages must have the same destination core.");
+		assert(msgs.front()->getSourceCore() == msg->getSourceCore() && "All messages must have the same source core.");
+	}
+#endif
+	Channel& ch = channel(msgs.front()->getSourceCore(), coreID);
+	for(const t_msgptr& msg : msgs)
+		ch.push(msg);
+}
+
+Network::t_messages SPSCNetwork::getMessages(std::size_t coreid)
+{
+	LOG_DEBUG("\tNETWORK: SPSC Network sending msgs to ", coreid);
+	t_messages msgs;
+	const std::size_t cores = coreAmount();
+	for(std::size_t src = 0; src < cores; ++src)
+		channel(src, coreid).drain(msgs);
+	return msgs;
+}
+
+bool SPSCNetwork::havePendingMessages(std::size_t coreid) const
+{
+	const std::size_t cores = coreAmount();
+	for(std::size_t src = 0; src < cores; ++src){
+		if(!channel(src, coreid).empty())
+			return true;
+	}
+	return false;
+}
+
+bool SPSCNetwork::empty() const
+{
+	const std::size_t cores = coreAmount();
+	for(std::size_t dst = 0; dst < cores; ++dst){
+		if(havePendingMessages(dst))
+			return false;
+	}
+	return true;
+}
+
+std::size_t SPSCNetwork::spills() const
+{
+	std::size_t total = 0;
+	for(const auto& ch : m_channels)
+		total += ch->spills();
+	return total;
+}
+
+void SPSCNetwork::printStats(std::ostream& out) const
+{
+#ifdef USE_STAT
+	out << n_tools::t_uintstat("_network/spsc_spills", "messages", spills());
+#else
+	(void)out;
+#endif
+}
+
+} /* namespace n_network */
@@ -0,0 +1,124 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2015 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_NETWORK_SPSCNETWORK_H_
+#define SRC_NETWORK_SPSCNETWORK_H_
+
+#include "network/network.h"
+#include "network/spscqueue.h"
+#include <memory>
+
+namespace n_network {
+
+/**
+ * Network with a bounded lock free channel per (source core, destination core) pair.
+ * Each channel has exactly one producer (the source core) and one consumer (the destination core),
+ * so sending a message is a single release store, no lock or shared counter is touched.
+ * A core receiving its messages drains all channels in which it is the destination in one batch.
+ *
+ * If a channel is full, the sender spills into a locked overflow queue for that channel instead of
+ * waiting on the receiver (which could be run by the same thread). Order per channel is preserved.
+ * @see SPSCQueue
+ * @attention : Requires that a message is only ever sent by the core getSourceCore() reports.
+ */
+class SPSCNetwork: public Network
+{
+private:
+	typedef SPSCQueue<t_msgptr> Channel;
+
+	/**
+	 * Destroys a channel allocated by makeChannel.
+	 */
+	struct ChannelDeleter
+	{
+		void operator()(Channel* ch) const;
+	};
+
+	typedef std::unique_ptr<Channel, ChannelDeleter> t_channelptr;
+
+	/**
+	 * Channels, indexed by [destination * cores + source].
+	 * Grouping by destination keeps the channels a receiver drains together.
+	 */
+	std::vector<t_channelptr> m_channels;
+
+	/**
+	 * @return a channel on its own cache lines. Plain new does not respect the (over)alignment of a channel in C++14.
+	 * @throw std::bad_alloc
+	 */
+	static t_channelptr
+	makeChannel(std::size_t capacity);
+
+	Channel&
+	channel(std::size_t source, std::size_t destination)
+	{
+		return *m_channels[destination*coreAmount() + source];
+	}
+
+	const Channel&
+	channel(std::size_t source, std::size_t destination)const
+	{
+		return *m_channels[destination*coreAmount() + source];
+	}
+
+public:
+	/**
+	 * Default nr of messages a single channel can hold before it spills.
+	 */
+	static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+	/**
+	 * Create a network for #cores with a channel per core pair.
+	 * @param capacity : nr of messages each channel can queue before it spills into a locked queue.
+	 */
+	SPSCNetwork(size_t cores, size_t capacity = DEFAULT_CAPACITY);
+
+	virtual ~SPSCNetwork() = default;
+
+	/**
+	 * @pre : called by the thread running msg's source core.
+	 */
+	void
+	acceptMessage(const t_msgptr& msg)override;
+
+	/**
+	 * @pre : called by the thread running the (single) source core of all messages in msgs.
+	 */
+	void
+	giveMessages(size_t coreID, const std::vector<t_msgptr>& msgs)override;
+
+	/**
+	 * Drain all channels to coreid.
+	 * @pre : called by the thread running core coreid.
+	 */
+	t_messages
+	getMessages(std::size_t coreid)override;
+
+	bool
+	havePendingMessages(std::size_t coreid)const override;
+
+	/**
+	 * @attention : O(cores^2), only intended for termination checks.
+	 */
+	bool
+	empty()const override;
+
+	/**
+	 * @return the total nr of messages that did not fit in their channel.
+	 */
+	std::size_t
+	spills()const;
+
+	void printStats(std::ostream& out = std::cout) const override;
+};
+
+} /* namespace n_network */
+
+#endif /* SRC_NETWORK_SPSCNETWORK_H_ */
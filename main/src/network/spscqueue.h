@@ -0,0 +1,153 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2015 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_NETWORK_SPSCQUEUE_H_
+#define SRC_NETWORK_SPSCQUEUE_H_
+
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <cassert>
+
+namespace n_network {
+
+/**
+ * Bounded single producer, single consumer ring buffer with an unbounded, locked overflow.
+ *
+ * The producer only takes the overflow lock if the ring is full, the consumer only if the producer
+ * has signalled overflow. Items are delivered in the order they were pushed.
+ * @attention : at most one thread may call push, and at most one (other) thread may call drain at any time.
+ * A handoff of either role between threads needs a happens-before relation (e.g. a lock).
+ * @tparam Q : trivially copyable element type (a pointer).
+ */
+template<typename Q>
+class SPSCQueue
+{
+private:
+	static constexpr std::size_t CACHELINE = 64;
+
+	/// Written by the consumer only.
+	alignas(CACHELINE) std::atomic<std::size_t> m_head;
+	/// Producer's cached copy of m_head, avoids reading the consumer's line on each push.
+	std::size_t m_headcache;
+
+	/// Written by the producer only.
+	alignas(CACHELINE) std::atomic<std::size_t> m_tail;
+	/// Set by the producer if m_overflow holds items, cleared by the consumer.
+	std::atomic<bool> m_hasoverflow;
+
+	alignas(CACHELINE) std::mutex m_overflowlock;
+	std::vector<Q> m_overflow;
+	/// Nr of items that did not fit in the ring, only written under m_overflowlock.
+	std::atomic<std::size_t> m_spills;
+
+	const std::size_t m_mask;
+	std::vector<Q> m_ring;
+
+	static std::size_t roundUp(std::size_t n)
+	{
+		std::size_t p = 1;
+		while (p < n)
+			p <<= 1;
+		return p;
+	}
+
+public:
+	/**
+	 * @param capacity : size of the ring, rounded up to a power of 2.
+	 */
+	explicit SPSCQueue(std::size_t capacity)
+		: m_head(0), m_headcache(0), m_tail(0), m_hasoverflow(false), m_spills(0),
+		  m_mask(roundUp(capacity) - 1), m_ring(m_mask + 1)
+	{
+		assert(capacity > 0 && "SPSC capacity can't be zero.");
+	}
+
+	SPSCQueue(const SPSCQueue&) = delete;
+	SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+	/**
+	 * Add element to the queue.
+	 * @producer
+	 */
+	void push(const Q& element)
+	{
+		if (!m_hasoverflow.load(std::memory_order_relaxed)) {   // Only the producer sets the flag.
+			const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail - m_headcache > m_mask)
+				m_headcache = m_head.load(std::memory_order_acquire);
+			if (tail - m_headcache <= m_mask) {
+				m_ring[tail & m_mask] = element;
+				m_tail.store(tail + 1, std::memory_order_release);
+				return;
+			}
+		}
+		// Ring is full, or older items are already waiting in the overflow.
+		std::lock_guard<std::mutex> lock(m_overflowlock);
+		m_overflow.push_back(element);
+		m_spills.store(m_spills.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		m_hasoverflow.store(true, std::memory_order_release);
+	}
+
+	/**
+	 * Move all queued items to the back of out.
+	 * @consumer
+	 * @return the nr of items added.
+	 */
+	std::size_t drain(std::vector<Q>& out)
+	{
+		// Read the flag first : every ring item pushed before the overflow started is then visible.
+		const bool overflow = m_hasoverflow.load(std::memory_order_acquire);
+		const std::size_t head = m_head.load(std::memory_order_relaxed);
+		const std::size_t tail = m_tail.load(std::memory_order_acquire);
+		for (std::size_t i = head; i != tail; ++i)
+			out.push_back(m_ring[i & m_mask]);
+		m_head.store(tail, std::memory_order_release);
+		std::size_t count = tail - head;
+		if (overflow) {
+			std::lock_guard<std::mutex> lock(m_overflowlock);
+			out.insert(out.end(), m_overflow.begin(), m_overflow.end());
+			count += m_overflow.size();
+			m_overflow.clear();
+			m_hasoverflow.store(false, std::memory_order_release);
+		}
+		return count;
+	}
+
+	/**
+	 * @return true if there are no items queued, approximate if either side is active.
+	 * @threadsafe
+	 */
+	bool empty() const
+	{
+		return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire)
+			&& !m_hasoverflow.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @return the nr of items that did not fit in the ring.
+	 */
+	std::size_t spills() const
+	{
+		return m_spills.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @return the capacity of the ring (not counting overflow).
+	 */
+	std::size_t capacity() const
+	{
+		return m_mask + 1;
+	}
+};
+
+} /* namespace n_network */
+
+#endif /* SRC_NETWORK_SPSCQUEUE_H_ */
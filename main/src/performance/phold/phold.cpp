@@ -39,7 +39,7 @@ std::size_t getRand(std::size_t event, t_randgen& randgen)
  */
 
 HeavyPHOLDProcessor::HeavyPHOLDProcessor(std::string name, size_t iter, size_t totalAtomics, size_t modelNumber,
-        std::vector<size_t> local, std::vector<size_t> remote, size_t percentageRemotes, double percentagePriority)
+        std::vector<size_t> local, std::vector<size_t> remote, size_t percentageRemotes, double percentagePriority, bool reversible)
 	: AtomicModel(name), m_percentageRemotes(percentageRemotes), m_percentagePriority(percentagePriority), m_iter(iter), m_local(local), m_remote(remote), m_messageCount(0)
 {
 	addInPort("inport");
@@ -47,6 +47,8 @@ HeavyPHOLDProcessor::HeavyPHOLDProcessor(std::string name, size_t iter, size_t t
 		m_outs.push_back(addOutPort("outport_" + n_tools::toString(i)));
 	}
 	state().m_events.push_back(EventPair(modelNumber, getProcTime(modelNumber)));
+	setReversible(reversible);
+	setStaticLookahead(T_STEP);
 }
 
 HeavyPHOLDProcessor::~HeavyPHOLDProcessor()
@@ -123,16 +125,30 @@ void HeavyPHOLDProcessor::intTransition()
         if(state().m_events.size()==0)
                 throw std::out_of_range("Int Transition pop on empty.");
 #endif
+	pushUndo(state().m_events[0].m_modelNumber);
+	pushUndo(state().m_events[0].m_procTime);
 	state().m_events.pop_front();
 
 }
 
+void HeavyPHOLDProcessor::reverseIntTransition()
+{
+	LOG_INFO("[PHOLD] - ",getName()," reverses an INTERNAL TRANSITION");
+	EventTime procTime = popUndo<EventTime>();
+	size_t modelNumber = popUndo<size_t>();
+	state().m_events.push_front(EventPair(modelNumber, procTime));
+}
+
 void HeavyPHOLDProcessor::confTransition(const std::vector<n_network::t_msgptr> & message)
 {
 	LOG_INFO("[PHOLD] - ",getName()," does a CONFLUENT TRANSITION");
-	if (!state().m_events.empty()) {
+	const bool popped = !state().m_events.empty();
+	if (popped) {
+		pushUndo(state().m_events[0].m_modelNumber);
+		pushUndo(state().m_events[0].m_procTime);
 		state().m_events.pop_front();
 	}
+	pushUndo(popped);
 	for (auto& msg : message) {
 		++m_messageCount;
 		size_t payload = n_network::getMsgPayload<size_t>(msg);
@@ -147,6 +163,7 @@ void HeavyPHOLDProcessor::extTransition(const std::vector<n_network::t_msgptr>&
 {
 	LOG_INFO("[PHOLD] - ",getName()," does an EXTERNAL TRANSITION");
 	if (!state().m_events.empty()) {
+		pushUndo(state().m_events[0].m_procTime);
 		state().m_events[0].m_procTime -= m_elapsed.getTime();
 	}
 	for (auto& msg : message) {
@@ -159,6 +176,30 @@ void HeavyPHOLDProcessor::extTransition(const std::vector<n_network::t_msgptr>&
 	LOG_INFO("[PHOLD] - ",getName()," has received ",m_messageCount," messages in total.");
 }
 
+void HeavyPHOLDProcessor::reverseConfTransition(std::size_t messages)
+{
+	LOG_INFO("[PHOLD] - ",getName()," reverses a CONFLUENT TRANSITION");
+	for (std::size_t i = 0; i < messages; ++i)
+		state().m_events.pop_back();
+	m_messageCount -= messages;
+	if (popUndo<bool>()) {
+		EventTime procTime = popUndo<EventTime>();
+		size_t modelNumber = popUndo<size_t>();
+		state().m_events.push_front(EventPair(modelNumber, procTime));
+	}
+}
+
+void HeavyPHOLDProcessor::reverseExtTransition(std::size_t messages)
+{
+	LOG_INFO("[PHOLD] - ",getName()," reverses an EXTERNAL TRANSITION");
+	for (std::size_t i = 0; i < messages; ++i)
+		state().m_events.pop_back();
+	m_messageCount -= messages;
+	if (!state().m_events.empty()) {
+		state().m_events[0].m_procTime = popUndo<EventTime>();
+	}
+}
+
 void HeavyPHOLDProcessor::output(std::vector<n_network::t_msgptr>& msgs) const
 {
 	LOG_INFO("[PHOLD] - ",getName()," produces OUTPUT");
@@ -186,7 +227,8 @@ n_network::t_timestamp HeavyPHOLDProcessor::lookAhead() const
  * PHOLD
  */
 
-PHOLD::PHOLD(size_t nodes, size_t atomicsPerNode, size_t iter, std::size_t percentageRemotes, double percentagePriority)
+PHOLD::PHOLD(size_t nodes, size_t atomicsPerNode, size_t iter, std::size_t percentageRemotes, double percentagePriority,
+	bool reversible)
 	: n_model::CoupledModel("PHOLD")
 {
 	std::vector<n_model::t_atomicmodelptr> processors;
@@ -212,7 +254,7 @@ PHOLD::PHOLD(size_t nodes, size_t atomicsPerNode, size_t iter, std::size_t perce
 			std::vector<size_t> inoj = procs[i];
 			inoj.erase(std::remove(inoj.begin(), inoj.end(), num), inoj.end());
 			auto p = n_tools::createObject<HeavyPHOLDProcessor>("Processor_" + n_tools::toString(cntr),
-			        iter, totalAtomics, cntr, inoj, allnoi, percentageRemotes, percentagePriority);
+			        iter, totalAtomics, cntr, inoj, allnoi, percentageRemotes, percentagePriority, reversible);
 			processors.push_back(p);
 			addSubModel(p);
 			++cntr;
@@ -71,13 +71,16 @@ private:
 	mutable t_randgen m_rand;	//This object could be a global object, but then we'd need to lock it during parallel simulation.
 public:
 	HeavyPHOLDProcessor(std::string name, size_t iter, size_t totalAtomics, size_t modelNumber, std::vector<size_t> local,
-	        std::vector<size_t> remote, size_t percentageRemotes, double percentagePriority);
+	        std::vector<size_t> remote, size_t percentageRemotes, double percentagePriority, bool reversible = false);
 	virtual ~HeavyPHOLDProcessor();
 
 	virtual n_network::t_timestamp timeAdvance() const override;
 	virtual void intTransition() override;
 	virtual void confTransition(const std::vector<n_network::t_msgptr> & message) override;
 	virtual void extTransition(const std::vector<n_network::t_msgptr> & message) override;
+	virtual void reverseIntTransition() override;
+	virtual void reverseConfTransition(std::size_t messages) override;
+	virtual void reverseExtTransition(std::size_t messages) override;
 	virtual void output(std::vector<n_network::t_msgptr>& msgs) const override;
 	virtual n_network::t_timestamp lookAhead() const override;
 
@@ -88,7 +91,12 @@ public:
 class PHOLD: public n_model::CoupledModel
 {
 public:
-	PHOLD(size_t nodes, size_t atomicsPerNode, size_t iter, std::size_t percentageRemotes, double percentagePriority = 0.1);
+	/**
+	 * @param reversible : if true, the processors undo their transitions with reverse computation
+	 * instead of state copies in optimistic simulation.
+	 */
+	PHOLD(size_t nodes, size_t atomicsPerNode, size_t iter, std::size_t percentageRemotes, double percentagePriority = 0.1,
+		bool reversible = false);
 	virtual ~PHOLD();
 };
 
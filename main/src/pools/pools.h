@@ -13,6 +13,9 @@
 
 #include <new>
 #include <cstdlib>
+#include <cstddef>
+#include <type_traits>
+#include <sys/mman.h>
 #include "boost/pool/object_pool.hpp"
 #include "boost/pool/pool.hpp"
 #include "boost/pool/singleton_pool.hpp"
@@ -634,8 +637,336 @@ class Pool<Object, spool<Object>>:public PoolInterface<Object>{
 };
 
 
+//// Size class pools
+
+constexpr size_t slab_size = 2ull << 20;        // A transparent huge page on x86-64.
+constexpr size_t size_class_step = 8;
+constexpr size_t size_class_count = 128;        // Objects up to 1kB.
+
+/**
+ * Nr of slabs each thread maps (and faults in) when it first uses a size class pool.
+ */
+inline
+std::atomic<size_t>& slabReserveImpl__()
+{
+        static std::atomic<size_t> reserve(0);
+        return reserve;
+}
+
+/**
+ * Set the nr of slabs a thread reserves, only threads that have not used a size class pool yet are affected.
+ */
+inline
+void setSlabReserve(size_t slabs){slabReserveImpl__().store(slabs);}
+
+inline
+size_t getSlabReserve(){return slabReserveImpl__().load();}
+
+/**
+ * Thread local heap of slab_size memory blocks, aligned on slab_size so the kernel can back them with huge pages.
+ * A slab belongs to a single size class, objects of that class are cut from it and recycled on a freelist.
+ * Slabs are only returned to the OS when the thread exits.
+ */
+class SizeClassHeap{
+        private:
+                struct free_node{
+                        free_node* m_next;
+                };
+
+                struct size_class{
+                        free_node*      m_free;
+                        char*           m_bump;
+                        char*           m_end;
+                };
+
+                size_class              m_classes[size_class_count];
+
+                /**
+                 * All slabs we mapped.
+                 */
+                std::vector<void*>      m_slabs;
+
+                /**
+                 * Mapped slabs not yet given to a size class.
+                 */
+                std::vector<void*>      m_spare;
+
+                /**
+                 * Map a slab_size aligned slab : map twice the size, and unmap the unaligned head and tail.
+                 * @throw bad_alloc if the mapping fails.
+                 */
+                void* mapSlab()
+                {
+                        char* raw = (char*) mmap(nullptr, 2*slab_size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+                        if(raw == (char*) MAP_FAILED)
+                                throw std::bad_alloc();
+                        char* slab = (char*) (((uintptr_t) raw + slab_size - 1) & ~(slab_size - 1));
+                        if(slab != raw)
+                                munmap(raw, slab - raw);
+                        munmap(slab + slab_size, raw + slab_size - slab);
+#ifdef MADV_HUGEPAGE
+                        madvise(slab, slab_size, MADV_HUGEPAGE);
+#endif
+                        m_slabs.push_back(slab);
+                        return slab;
+                }
+
+                void refill(size_class& c)
+                {
+                        void* slab = nullptr;
+                        if(m_spare.empty())
+                                slab = mapSlab();
+                        else{
+                                slab = m_spare.back();
+                                m_spare.pop_back();
+                        }
+                        c.m_bump = (char*) slab;
+                        c.m_end = c.m_bump + slab_size;
+                }
+        public:
+                /**
+                 * @param reserve Nr of slabs to map and fault in now.
+                 */
+                explicit SizeClassHeap(size_t reserve)
+                {
+                        for(size_class& c : m_classes)
+                                c = size_class{nullptr, nullptr, nullptr};
+                        for(size_t i = 0; i < reserve; ++i){
+                                char* slab = (char*) mapSlab();
+                                // One write per huge page, or per page if the kernel won't give us huge ones.
+                                for(size_t off = 0; off < slab_size; off += 4096)
+                                        slab[off] = 0;
+                                m_spare.push_back(slab);
+                        }
+                }
+
+                ~SizeClassHeap()
+                {
+                        for(void* slab : m_slabs)
+                                munmap(slab, slab_size);
+                }
+
+                SizeClassHeap(const SizeClassHeap&) = delete;
+                SizeClassHeap& operator=(const SizeClassHeap&) = delete;
+
+                /**
+                 * @return The size class of objects of size bytes, fits() checks there is one.
+                 */
+                static constexpr size_t classOf(size_t bytes)
+                {
+                        return bytes ? (bytes - 1) / size_class_step : 0;
+                }
+
+                template<typename T>
+                static constexpr bool fits()
+                {
+                        return classOf(sizeof(T)) < size_class_count && alignof(T) <= size_class_step;
+                }
+
+                /**
+                 * @return (size class + 1) * size_class_step bytes, aligned on size_class_step.
+                 * @throw bad_alloc if a new slab cannot be mapped.
+                 */
+                void* allocate(size_t cls)
+                {
+                        size_class& c = m_classes[cls];
+                        if(c.m_free){
+                                free_node* n = c.m_free;
+                                c.m_free = n->m_next;
+                                return n;
+                        }
+                        const size_t sz = (cls + 1) * size_class_step;
+                        if(c.m_bump + sz > c.m_end)
+                                refill(c);
+                        void* obj = c.m_bump;
+                        c.m_bump += sz;
+                        return obj;
+                }
+
+                void deallocate(void* obj, size_t cls)
+                {
+                        size_class& c = m_classes[cls];
+                        free_node* n = (free_node*) obj;
+                        n->m_next = c.m_free;
+                        c.m_free = n;
+                }
+
+                /**
+                 * @return Nr of slabs mapped by this heap.
+                 */
+                size_t slabs()const
+                {
+                        return m_slabs.size();
+                }
+
+                /**
+                 * The heap of the calling thread, created at first use with getSlabReserve() slabs.
+                 */
+                static SizeClassHeap& local()
+                {
+                        thread_local SizeClassHeap heap(getSlabReserve());
+                        return heap;
+                }
+};
+
 /**
- * Pool configuration code. 
+ * Pool drawing from the thread's SizeClassHeap, all types with the same size class share its slabs.
+ * @attention : objects must be deallocated on the thread that allocated them, use a RemoteFreePool to lift this.
+ */
+template<typename T>
+class SizeClassPool:public PoolInterface<T>{
+        static_assert(SizeClassHeap::fits<T>(), "Type too large or overaligned for a size class.");
+        private:
+                static constexpr size_t s_class = SizeClassHeap::classOf(sizeof(T));
+                SizeClassHeap&  m_heap;
+        public:
+                /**
+                 * @param psize ignored, the heap is sized with setSlabReserve().
+                 */
+                explicit SizeClassPool(size_t /*psize*/, size_t /*nsize*/=0):m_heap(SizeClassHeap::local()){;}
+
+                T* allocate()override
+                {
+                        return (T*) m_heap.allocate(s_class);
+                }
+
+                void deallocate(T* t)override
+                {
+                        t->~T();
+                        m_heap.deallocate(t, s_class);
+                }
+};
+
+/**
+ * Types that are pooled in size classes, specialized next to the type (e.g. messages, states).
+ */
+template<typename T>
+struct size_class_pooled:public std::false_type{};
+
+//// Remote free
+
+template<typename T>
+class RemoteFreeList;
+
+/**
+ * Memory block of a remote free pool : the object, prefixed with the pool that allocated it.
+ * While the block is on a remote free list the object's memory links the list.
+ */
+template<typename T>
+struct remote_block{
+        RemoteFreeList<T>* m_owner;
+        union{
+                remote_block* m_next;
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type m_object;
+        };
+
+        static remote_block* fromObject(T* t)
+        {
+                return (remote_block*) ((char*) t - offsetof(remote_block, m_object));
+        }
+};
+
+/**
+ * Type (and inner pool) independent part of a remote free pool, any thread can return blocks to it.
+ */
+template<typename T>
+class RemoteFreeList:public PoolInterface<T>{
+        protected:
+                typedef remote_block<T> t_block;
+
+                /**
+                 * Lock free stack of blocks deallocated by other threads, pushed by them, taken in full by the owner.
+                 */
+                std::atomic<t_block*>   m_remote;
+
+                /**
+                 * @return All blocks deallocated by other threads since the last call, as a linked list.
+                 */
+                t_block* takeRemote()
+                {
+                        return m_remote.exchange(nullptr, std::memory_order_acquire);
+                }
+        public:
+                RemoteFreeList():m_remote(nullptr){;}
+
+                /**
+                 * Return a block from a thread other than the owner.
+                 * @pre ~T() has been called on the block's object.
+                 */
+                void remoteFree(t_block* b)
+                {
+                        t_block* head = m_remote.load(std::memory_order_relaxed);
+                        do{
+                                b->m_next = head;
+                        }while(!m_remote.compare_exchange_weak(head, b, std::memory_order_release, std::memory_order_relaxed));
+                }
+};
+
+/**
+ * Wraps a thread local pool so objects can be deallocated by any thread.
+ * Each object carries the pool that allocated it, an object from another thread's pool is pushed on that pool's
+ * remote free list instead of our own. The owner returns those in batch to its inner pool at its next allocate().
+ * Costs a pointer per object, and an uncontended atomic load per allocate().
+ * @param P : the inner pool type, e.g. SCObjectPool.
+ * @attention : a pool must outlive all deallocations of its objects by other threads, i.e. the threads
+ * that own the pools must not exit before all others are done deallocating.
+ */
+template<typename T, template<typename> class P>
+class RemoteFreePool:public RemoteFreeList<T>{
+        private:
+                typedef typename RemoteFreeList<T>::t_block t_block;
+
+                P<t_block>      m_pool;
+
+                /**
+                 * Return all remotely freed blocks to the inner pool.
+                 */
+                void reclaim()
+                {
+                        t_block* b = this->takeRemote();
+                        while(b){
+                                t_block* next = b->m_next;
+                                m_pool.deallocate(b);
+                                b = next;
+                        }
+                }
+        public:
+                explicit RemoteFreePool(size_t psize):m_pool(psize){;}
+
+                ~RemoteFreePool()
+                {
+                        reclaim();
+                }
+
+                /**
+                 * @return A pointer to the next free object, after reclaiming blocks other threads deallocated.
+                 * @throw bad_alloc if the inner pool cannot service the request.
+                 */
+                T* allocate()override
+                {
+                        if(this->m_remote.load(std::memory_order_relaxed))
+                                reclaim();
+                        t_block* b = m_pool.allocate();
+                        b->m_owner = this;
+                        return (T*) &b->m_object;
+                }
+
+                /**
+                 * Destroy t and return its memory to the pool that allocated it, which can be owned by another thread.
+                 */
+                void deallocate(T* t)override
+                {
+                        t->~T();
+                        t_block* b = t_block::fromObject(t);
+                        if(b->m_owner == this)
+                                m_pool.deallocate(b);
+                        else
+                                b->m_owner->remoteFree(b);
+                }
+};
+
+/**
+ * Pool configuration code.
  * The problem solved here is 2-part: 
  *  - Set an appropriate pool type depending on what simulation type a kernel is running.
  *  - Allow each kernel its own dedicated pool, per object class. 
@@ -669,6 +1000,14 @@ using MCObjectPool = Pool<Object,std::false_type>;
 using MCObjectPool = Pool<Object, boost::pool<>>;
 #endif
 
+// Size classed types, on any thread. Objects too large for a size class fall back to the multi core pool.
+template<typename Object>
+#ifdef POOL_NO_SIZE_CLASS
+using SizeClassObjectPool = MCObjectPool<Object>;
+#else
+using SizeClassObjectPool = typename std::conditional<SizeClassHeap::fits<Object>(), SizeClassPool<Object>, MCObjectPool<Object>>::type;
+#endif
+
 
 /**
  * Registers a pool per thread, forward decl.
@@ -734,14 +1073,17 @@ void setMain(){isMainImpl__()=true;}
 
 /**
  * Registers a pool per thread.
+ * All pool types are wrapped in a RemoteFreePool, a thread can release objects from any other thread's pool.
  * @pre main has called getMainThreadID() at least once as first caller.
  * @param psize : initial size of the pool.
  */
 template<typename T>
-PoolInterface<T>* 
+PoolInterface<T>*
 initializePool(size_t psize)
 {
-        return ( isMain() ? (PoolInterface<T>*) new SCObjectPool<T>(psize) : (PoolInterface<T>*) new MCObjectPool<T>(psize) );
+        if(size_class_pooled<T>::value)
+                return new RemoteFreePool<T, SizeClassObjectPool>(psize);
+        return ( isMain() ? (PoolInterface<T>*) new RemoteFreePool<T, SCObjectPool>(psize) : (PoolInterface<T>*) new RemoteFreePool<T, MCObjectPool>(psize) );
 }
 
 
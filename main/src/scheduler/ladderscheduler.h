@@ -0,0 +1,416 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2015 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_SCHEDULER_LADDERSCHEDULER_H_
+#define SRC_SCHEDULER_LADDERSCHEDULER_H_
+
+#include "scheduler/scheduler.h"
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace n_scheduler {
+
+/**
+ * Ladder queue (Tang, Goh, Thng), a multi level calendar queue with amortized O(1) push/pop.
+ *
+ * Items live in three tiers, all of them plain vectors so there is no per item allocation:
+ * 	top    : unsorted, all items with key >= m_topstart.
+ * 	rungs  : each rung is an array of buckets of equal width, a deeper rung subdivides a single bucket of the rung above it.
+ * 	bottom : a small sorted vector, the back is the first item to be scheduled.
+ * Items are only sorted when a bucket is small enough (or its keys can no longer be split) to be moved to bottom.
+ *
+ * Complexity (amortized, for keys that are not too skewed) :
+ * 	push()/pop()/top() : O(1)
+ * 	unschedule_until : O(k) for k items unscheduled.
+ * 	erase/contains : O(n)
+ *
+ * @tparam T : item type, the priority is (as for all schedulers) defined by operator<(const T&, const T&), which is a max heap convention.
+ * @tparam Key : functor, double Key()(const T&) returns a numeric key for an item, where a smaller key means a higher priority.
+ * Key must be consistent with operator< : key(a) < key(b) implies b < a.
+ * @attention Not synchronized.
+ */
+template<typename T, typename Key>
+class LadderScheduler final: public Scheduler<T>
+{
+private:
+	/**
+	 * Buckets that are larger than this are split in a new rung instead of sorted.
+	 */
+	static constexpr std::size_t THRESHOLD = 50;
+
+	/**
+	 * Nr of items in bottom that triggers a conversion of bottom into a new rung.
+	 */
+	static constexpr std::size_t BOTTOMLIMIT = 4 * THRESHOLD;
+
+	static constexpr std::size_t MAXRUNGS = 8;
+
+	struct Rung
+	{
+		/// Key of the lower bound of bucket 0.
+		double m_start;
+		double m_width;
+		/// First bucket that can still hold items, buckets < m_cur are dequeued.
+		std::size_t m_cur;
+		/// Nr of items in this rung.
+		std::size_t m_count;
+		std::vector<std::vector<T>> m_buckets;
+
+		double currentStart() const
+		{
+			return m_start + m_width * double(m_cur);
+		}
+
+		std::size_t bucketIndex(double key) const
+		{
+			const double offset = (key - m_start) / m_width;
+			std::size_t idx = (offset < double(m_buckets.size())) ? std::size_t(offset) : m_buckets.size() - 1;
+			return std::max(idx, m_cur);
+		}
+	};
+
+	Key m_key;
+
+	std::vector<T> m_top;
+	double m_topstart;
+	double m_topmin;
+	double m_topmax;
+
+	/**
+	 * Rung storage is kept (with the capacity of its buckets) when a rung is exhausted,
+	 * only the first m_rungcount rungs are in use.
+	 */
+	std::vector<Rung> m_rungs;
+	std::size_t m_rungcount;
+
+	/**
+	 * Sorted on operator<, so the back is the first item to be scheduled.
+	 */
+	std::vector<T> m_bottom;
+
+	std::size_t m_size;
+
+	void resetTop()
+	{
+		m_top.clear();
+		m_topmin = std::numeric_limits<double>::max();
+		m_topmax = std::numeric_limits<double>::lowest();
+	}
+
+	void sortBottom()
+	{
+		std::sort(m_bottom.begin(), m_bottom.end());
+	}
+
+	void insertBottom(const T& item)
+	{
+		m_bottom.insert(std::upper_bound(m_bottom.begin(), m_bottom.end(), item), item);
+		if (m_bottom.size() > BOTTOMLIMIT && m_rungcount < MAXRUNGS) {
+			// Bottom keys are below the current bucket of all rungs, so it can become the deepest rung.
+			if (spawnRung(m_bottom, m_key(m_bottom.back()), m_key(m_bottom.front())))
+				m_bottom.clear();
+		}
+	}
+
+	/**
+	 * Distribute items over a new, deepest rung.
+	 * @param lo, hi : the smallest and largest key in items.
+	 * @return false if the keys are too close to be split, items is then left untouched.
+	 */
+	bool spawnRung(const std::vector<T>& items, double lo, double hi)
+	{
+		const double width = (hi - lo) / double(items.size());
+		if (!(width > 0.0) || !(lo + width > lo) || !std::isfinite(width))
+			return false;
+		if (m_rungcount == m_rungs.size())
+			m_rungs.push_back(Rung());
+		Rung& rung = m_rungs[m_rungcount];
+		rung.m_start = lo;
+		rung.m_width = width;
+		rung.m_cur = 0;
+		rung.m_count = items.size();
+		// One bucket extra so that hi never falls outside the rung.
+		const std::size_t buckets = items.size() + 1;
+		if (rung.m_buckets.size() > buckets)
+			rung.m_buckets.resize(buckets);
+		for (auto& bucket : rung.m_buckets)
+			bucket.clear();
+		rung.m_buckets.resize(buckets);
+		for (const T& item : items)
+			rung.m_buckets[rung.bucketIndex(m_key(item))].push_back(item);
+		++m_rungcount;
+		return true;
+	}
+
+	/**
+	 * Ensure bottom holds the first item(s), if there are any.
+	 */
+	void refill()
+	{
+		while (m_bottom.empty()) {
+			if (m_rungcount == 0) {
+				if (m_top.empty())
+					return;
+				if (spawnRung(m_top, m_topmin, m_topmax)) {
+					const Rung& rung = m_rungs[0];
+					m_topstart = rung.m_start + rung.m_width * double(rung.m_buckets.size());
+				} else {
+					// All keys are equal, anything not later than that key has to be sorted with them.
+					m_bottom.swap(m_top);
+					sortBottom();
+					m_topstart = std::nextafter(m_topmax, std::numeric_limits<double>::max());
+				}
+				resetTop();
+				continue;
+			}
+			Rung& rung = m_rungs[m_rungcount - 1];
+			if (rung.m_count == 0) {
+				--m_rungcount;
+				continue;
+			}
+			while (rung.m_buckets[rung.m_cur].empty())
+				++rung.m_cur;
+			std::vector<T>& bucket = rung.m_buckets[rung.m_cur];
+			++rung.m_cur;
+			rung.m_count -= bucket.size();
+			if (bucket.size() > THRESHOLD && m_rungcount < MAXRUNGS) {
+				double lo = std::numeric_limits<double>::max();
+				double hi = std::numeric_limits<double>::lowest();
+				for (const T& item : bucket) {
+					const double key = m_key(item);
+					lo = std::min(lo, key);
+					hi = std::max(hi, key);
+				}
+				if (spawnRung(bucket, lo, hi)) {
+					bucket.clear();
+					continue;
+				}
+			}
+			m_bottom.swap(bucket);
+			sortBottom();
+		}
+	}
+
+	/**
+	 * Remove the first element equal to elem from an unsorted vector.
+	 */
+	static bool eraseFrom(std::vector<T>& items, const T& elem)
+	{
+		auto iter = std::find(items.begin(), items.end(), elem);
+		if (iter == items.end())
+			return false;
+		*iter = items.back();
+		items.pop_back();
+		return true;
+	}
+
+public:
+	LadderScheduler()
+		: m_topstart(std::numeric_limits<double>::lowest()), m_rungcount(0), m_size(0)
+	{
+		resetTop();
+	}
+
+	virtual ~LadderScheduler()
+	{
+		;
+	}
+
+	virtual void push_back(const T& item) override
+	{
+		++m_size;
+		const double key = m_key(item);
+		if (key >= m_topstart) {
+			m_top.push_back(item);
+			m_topmin = std::min(m_topmin, key);
+			m_topmax = std::max(m_topmax, key);
+			return;
+		}
+		for (std::size_t i = 0; i < m_rungcount; ++i) {
+			Rung& rung = m_rungs[i];
+			if (key >= rung.currentStart()) {
+				rung.m_buckets[rung.bucketIndex(key)].push_back(item);
+				++rung.m_count;
+				return;
+			}
+		}
+		insertBottom(item);
+	}
+
+	virtual size_t size() const override
+	{
+		return m_size;
+	}
+
+	virtual bool empty() const override
+	{
+		return m_size == 0;
+	}
+
+	/**
+	 * @brief top Get item to be scheduled first.
+	 * @throws out_of_range if scheduler is empty.
+	 */
+	virtual const T& top() override
+	{
+		if (m_size == 0)
+			throw std::out_of_range("No elements in scheduler to top.");
+		refill();
+		return m_bottom.back();
+	}
+
+	/**
+	 * @brief pop Remove and return top item of scheduler.
+	 * @throws out_of_range if scheduler is empty.
+	 */
+	virtual T pop() override
+	{
+		if (m_size == 0)
+			throw std::out_of_range("No elements in scheduler to pop.");
+		refill();
+		T top_el = m_bottom.back();
+		m_bottom.pop_back();
+		--m_size;
+		return top_el;
+	}
+
+	virtual bool isLockable() const override
+	{
+		return false;
+	}
+
+	virtual
+	void
+	unschedule_until(std::vector<T>& container, const T& time) override
+	{
+		while (m_size) {
+			refill();
+			const T& element = m_bottom.back();
+			if (element < time)
+				break;
+			container.push_back(element);
+			m_bottom.pop_back();
+			--m_size;
+		}
+		testInvariant();
+	}
+
+	/**
+	 * Remove all items, releases the bucket memory.
+	 */
+	virtual
+	void
+	clear() override
+	{
+		std::vector<T>().swap(m_top);
+		std::vector<T>().swap(m_bottom);
+		m_rungs.clear();
+		m_rungcount = 0;
+		m_size = 0;
+		m_topstart = std::numeric_limits<double>::lowest();
+		resetTop();
+	}
+
+	virtual
+	bool
+	contains(const T& elem) const override
+	{
+		if (std::find(m_bottom.begin(), m_bottom.end(), elem) != m_bottom.end())
+			return true;
+		for (std::size_t i = 0; i < m_rungcount; ++i) {
+			const Rung& rung = m_rungs[i];
+			for (std::size_t b = rung.m_cur; b < rung.m_buckets.size(); ++b) {
+				if (std::find(rung.m_buckets[b].begin(), rung.m_buckets[b].end(), elem) != rung.m_buckets[b].end())
+					return true;
+			}
+		}
+		return std::find(m_top.begin(), m_top.end(), elem) != m_top.end();
+	}
+
+	virtual
+	bool
+	erase(const T& elem) override
+	{
+		bool found = false;
+		auto iter = std::find(m_bottom.begin(), m_bottom.end(), elem);
+		if (iter != m_bottom.end()) {
+			m_bottom.erase(iter);
+			found = true;
+		}
+		for (std::size_t i = 0; i < m_rungcount && !found; ++i) {
+			Rung& rung = m_rungs[i];
+			for (std::size_t b = rung.m_cur; b < rung.m_buckets.size() && !found; ++b) {
+				if (eraseFrom(rung.m_buckets[b], elem)) {
+					--rung.m_count;
+					found = true;
+				}
+			}
+		}
+		// Top's min/max are left as is, they remain valid bounds.
+		if (!found)
+			found = eraseFrom(m_top, elem);
+		if (found)
+			--m_size;
+		testInvariant();
+		return found;
+	}
+
+	virtual
+	void
+	printScheduler() const override
+	{
+#if LOGGING
+		LOG_DEBUG("Printing scheduler (unordered):");
+		for (auto iter = m_bottom.rbegin(); iter != m_bottom.rend(); ++iter)
+			LOG_DEBUG(" ", *iter);
+		for (std::size_t i = m_rungcount; i > 0; --i) {
+			const Rung& rung = m_rungs[i - 1];
+			for (std::size_t b = rung.m_cur; b < rung.m_buckets.size(); ++b)
+				for (const T& item : rung.m_buckets[b])
+					LOG_DEBUG(" ", item);
+		}
+		for (const T& item : m_top)
+			LOG_DEBUG(" ", item);
+#endif
+	}
+
+	virtual
+	void
+	testInvariant() const override
+	{
+#ifdef SAFETY_CHECKS
+		std::size_t count = m_bottom.size() + m_top.size();
+		for (std::size_t i = 0; i < m_rungcount; ++i)
+			count += m_rungs[i].m_count;
+		if (count != m_size) {
+			std::stringstream ss;
+			ss << "Invariant Scheduler failed :: \n";
+			ss << "Items in ladder == " << count << " != size == " << m_size;
+			throw std::logic_error(ss.str());
+		}
+#endif
+	}
+
+	/**
+	 * @return the nr of rungs currently in use.
+	 */
+	std::size_t rungs() const
+	{
+		return m_rungcount;
+	}
+};
+
+} /* namespace n_scheduler */
+
+#endif /* SRC_SCHEDULER_LADDERSCHEDULER_H_ */
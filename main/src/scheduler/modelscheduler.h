@@ -13,6 +13,9 @@
 
 #include "scheduler/modelheapscheduler.h"
 #include "scheduler/genericmodelscheduler.h"
+#ifndef FPTIME
+#include "scheduler/modelwheelscheduler.h"
+#endif
 #include "model/atomicmodel.h"
 
 namespace n_scheduler {
@@ -34,7 +37,23 @@ struct ModelScheduler<ModelHeapScheduler, Heap>
 	typedef ModelHeapScheduler<n_model::t_raw_atomic> t_type;
 };
 
+#ifndef FPTIME
+template<template<typename...T> class Heap>
+struct ModelScheduler<ModelWheelScheduler, Heap>
+{
+	typedef ModelWheelScheduler<n_model::t_raw_atomic> t_type;
+};
+#endif
+
+/**
+ * The model scheduler used by all cores.
+ * Define WHEEL_SCHEDULER to use the timing wheel, only for integral time.
+ */
+#if defined(WHEEL_SCHEDULER) && !defined(FPTIME)
+typedef ModelScheduler<ModelWheelScheduler, std::vector>::t_type t_defaultModelScheduler;
+#else
 typedef ModelScheduler<ModelHeapScheduler, std::vector>::t_type t_defaultModelScheduler;
+#endif
 typedef ModelScheduler<n_scheduler::VectorScheduler, boost::heap::pairing_heap>::t_type t_Vector_PairingHeap_scheduler;
 
 } /* namespace n_scheduler */
@@ -0,0 +1,408 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2015 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_SCHEDULER_MODELWHEELSCHEDULER_H_
+#define SRC_SCHEDULER_MODELWHEELSCHEDULER_H_
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+#include "scheduler/scheduler.h"
+#include "model/atomicmodel.h"
+#include "tools/globallog.h"
+
+namespace n_scheduler {
+
+template<typename S>
+class ModelWheelScheduler: public Scheduler<S> {
+	static_assert(std::is_same<S, n_model::t_raw_atomic>::value,
+		"The wheel scheduler is currently only implemented for n_model::t_raw_atomic.");
+};
+
+/**
+ * @brief A model scheduler based on a timing wheel, for integral time.
+ *
+ * Models with a next time in [base, base + W) are kept in one of W buckets, indexed by time modulo W.
+ * Models that are scheduled further away are kept in an unsorted far list, and passive models (infinite
+ * next time) in a separate list, so they are never looked at.
+ * The base only moves forward, if time moves back (e.g. after a revert) the wheel is rebuilt.
+ * W is chosen on each rebuild (updateAll) to fit the spread of the finite next times.
+ *
+ * Complexity, for time advances that fit in the wheel :
+ * 	push_back/update : O(1)
+ * 	findUntil : O(k) with k the amount of found items.
+ * 	topTime : O(k + gap) with gap the amount of empty buckets skipped, amortized over the advance in time.
+ * 	updateAll : O(N + W)
+ * If time advances are spread widely, the far list is scanned often and the heap scheduler is the better choice.
+ * @note Imminents with the same time are found in a different order than with the heap, so traces
+ * can list simultaneous inputs of a port in another order than the reference outputs (made with the heap).
+ * @attention The keys are only read on push_back, update and updateAll. As for the heap, a model may not change its
+ * next time without being updated before the next findUntil/topTime.
+ */
+template<>
+class ModelWheelScheduler<n_model::t_raw_atomic>
+{
+private:
+	typedef n_network::t_timestamp::t_time t_time;
+	static_assert(std::is_integral<t_time>::value, "The wheel scheduler requires integral time, don't use it with FPTIME.");
+
+	static constexpr t_time INF = std::numeric_limits<t_time>::max();
+	static constexpr std::size_t MINWHEEL = 64;
+	static constexpr std::size_t MAXWHEEL = std::size_t(1) << 16;
+
+	enum Location : unsigned char {WHEEL, FAR, PASSIVE};
+
+	struct Entry
+	{
+		n_model::t_raw_atomic m_ptr;
+		/// Next time of the model when it was last (re)scheduled.
+		t_time m_key;
+		/// Position in the bucket/list the entry is in.
+		std::size_t m_pos;
+		Location m_where;
+
+		Entry(n_model::t_raw_atomic ptr)
+			: m_ptr(ptr), m_key(INF), m_pos(0), m_where(PASSIVE)
+		{}
+	};
+
+	std::vector<Entry> m_index;
+	/// Buckets hold indices in m_index.
+	std::vector<std::vector<std::size_t>> m_wheel;
+	std::size_t m_mask;
+	/// All keys in the wheel are in [m_base, m_base + m_wheel.size()).
+	t_time m_base;
+	std::size_t m_wheelcount;
+	std::vector<std::size_t> m_far;
+	/// Lower bound on the keys in m_far.
+	t_time m_farmin;
+	std::vector<std::size_t> m_passive;
+
+	std::vector<std::size_t>& listFor(const Entry& entry)
+	{
+		switch(entry.m_where){
+		case WHEEL:
+			return m_wheel[entry.m_key & m_mask];
+		case FAR:
+			return m_far;
+		default:
+			return m_passive;
+		}
+	}
+
+	void link(std::size_t id)
+	{
+		Entry& entry = m_index[id];
+		std::vector<std::size_t>* list;
+		if(entry.m_key == INF){
+			entry.m_where = PASSIVE;
+			list = &m_passive;
+		}else if(entry.m_key - m_base < m_wheel.size()){
+			entry.m_where = WHEEL;
+			list = &m_wheel[entry.m_key & m_mask];
+			++m_wheelcount;
+		}else{
+			entry.m_where = FAR;
+			list = &m_far;
+			m_farmin = std::min(m_farmin, entry.m_key);
+		}
+		entry.m_pos = list->size();
+		list->push_back(id);
+	}
+
+	void unlink(std::size_t id)
+	{
+		const Entry& entry = m_index[id];
+		std::vector<std::size_t>& list = listFor(entry);
+		const std::size_t moved = list.back();
+		list[entry.m_pos] = moved;
+		m_index[moved].m_pos = entry.m_pos;
+		list.pop_back();
+		if(entry.m_where == WHEEL)
+			--m_wheelcount;
+	}
+
+	/**
+	 * Move the far items that fit in the wheel after the base has moved.
+	 */
+	void migrate()
+	{
+		std::vector<std::size_t> far;
+		far.swap(m_far);
+		m_farmin = INF;
+		for(std::size_t id : far)
+			link(id);
+	}
+
+	/**
+	 * Advance the base to the first non empty bucket.
+	 * @return false if there are no finite keys.
+	 */
+	bool advance()
+	{
+		if(m_wheelcount == 0){
+			if(m_far.empty())
+				return false;
+			m_base = m_farmin;
+			migrate();
+		}
+		while(m_wheel[m_base & m_mask].empty()){
+			++m_base;
+			if(m_farmin - m_base < m_wheel.size())
+				migrate();
+		}
+		return true;
+	}
+
+	void rebuild()
+	{
+		t_time lo = INF;
+		t_time hi = 0;
+		for(const Entry& entry : m_index){
+			if(entry.m_key == INF)
+				continue;
+			lo = std::min(lo, entry.m_key);
+			hi = std::max(hi, entry.m_key);
+		}
+		std::size_t width = MINWHEEL;
+		while(lo != INF && width <= std::size_t(hi - lo) && width < MAXWHEEL)
+			width <<= 1;
+		for(auto& bucket : m_wheel)
+			bucket.clear();
+		m_wheel.resize(width);
+		m_mask = width - 1;
+		m_base = (lo == INF)? 0: lo;
+		m_wheelcount = 0;
+		m_far.clear();
+		m_farmin = INF;
+		m_passive.clear();
+		for(std::size_t i = 0; i < m_index.size(); ++i)
+			link(i);
+	}
+
+	void reschedule(std::size_t id)
+	{
+		Entry& entry = m_index[id];
+		const t_time key = entry.m_ptr->getTimeNext().getTime();
+		if(key == entry.m_key)
+			return;
+		if(key < m_base){
+			// Time went back, the window can't move back without aliasing.
+			entry.m_key = key;
+			rebuild();
+			return;
+		}
+		unlink(id);
+		entry.m_key = key;
+		link(id);
+	}
+
+public:
+	ModelWheelScheduler()
+		: m_wheel(MINWHEEL), m_mask(MINWHEEL - 1), m_base(0), m_wheelcount(0), m_farmin(INF)
+	{ }
+
+	ModelWheelScheduler(std::size_t size)
+		: ModelWheelScheduler()
+	{
+		reserve(size);
+	}
+
+	void reserve(std::size_t size)
+	{
+		m_index.reserve(size);
+	}
+
+	std::size_t size() const
+	{ return m_index.size(); }
+
+	inline
+	std::size_t indexSize() const
+	{ return m_index.size(); }
+
+	/**
+	 * The wheel never needs a full rebuild to be consistent.
+	 */
+	bool dirty() const
+	{ return false; }
+
+	void clear()
+	{
+		m_index.clear();
+		for(auto& bucket : m_wheel)
+			bucket.clear();
+		m_wheelcount = 0;
+		m_far.clear();
+		m_farmin = INF;
+		m_passive.clear();
+		m_base = 0;
+	}
+
+	/**
+	 * Adds a new model, its index is its local id.
+	 * @pre The next time of the model is set.
+	 */
+	void push_back(n_model::t_raw_atomic item)
+	{
+		m_index.push_back(Entry(item));
+		m_index.back().m_key = item->getTimeNext().getTime();
+		if(m_index.back().m_key < m_base){
+			rebuild();
+			return;
+		}
+		link(m_index.size() - 1);
+	}
+
+	/**
+	 * Removes the model with local id index, the last model takes its index.
+	 */
+	void remove(std::size_t index)
+	{
+		unlink(index);
+		const std::size_t last = m_index.size() - 1;
+		if(index != last){
+			unlink(last);
+			m_index[index] = m_index[last];
+			m_index.pop_back();
+			link(index);
+		}else{
+			m_index.pop_back();
+		}
+	}
+
+	/**
+	 * @brief Finds all items with a next internal transition time equal to mark.
+	 * @see ModelHeapScheduler::findUntil
+	 */
+	void
+	findUntil(std::vector<n_model::t_raw_atomic> &container, const n_network::t_timestamp& mark) const
+	{
+		const t_time time = mark.getTime();
+		const std::vector<std::size_t>* list = &m_far;
+		if(time == INF)
+			list = &m_passive;
+		else if(time >= m_base && time - m_base < m_wheel.size())
+			list = &m_wheel[time & m_mask];
+		for(std::size_t id : *list){
+			const Entry& entry = m_index[id];
+			if(entry.m_key != time)
+				continue;
+			container.push_back(entry.m_ptr);
+			entry.m_ptr->markInternal();
+		}
+	}
+
+	/**
+	 * @brief Returns the next internal transition time of the first model, or infinity if there is none.
+	 * @note Not const, the wheel is advanced to the first model.
+	 */
+	n_network::t_timestamp
+	topTime()
+	{
+		if(!advance())
+			return n_network::t_timestamp::infinity();
+		// The bucket holds all models with the same time, the causality decides.
+		n_network::t_timestamp first = n_network::t_timestamp::infinity();
+		for(std::size_t id : m_wheel[m_base & m_mask])
+			first = std::min(first, m_index[id].m_ptr->getTimeNext());
+		return first;
+	}
+
+	bool
+	contains(n_model::t_raw_atomic elem) const
+	{ return (elem->getLocalID() < size() && elem == m_index[elem->getLocalID()].m_ptr); }
+
+	void
+	update(std::size_t index)
+	{ reschedule(index); }
+
+	void
+	update(n_model::t_raw_atomic elem)
+	{
+		assert(contains(elem) && "Can't update an item that the scheduler doesn't have.");
+		reschedule(elem->getLocalID());
+	}
+
+	/**
+	 * Reschedule all models, and resize the wheel to the current spread of next times.
+	 */
+	void
+	updateAll()
+	{
+		for(Entry& entry : m_index)
+			entry.m_key = entry.m_ptr->getTimeNext().getTime();
+		rebuild();
+	}
+
+	/**
+	 * Single updates are O(1), so they are always preferred.
+	 * @see ModelHeapScheduler::signalUpdateSize
+	 */
+	inline
+	void
+	signalUpdateSize(std::size_t)
+	{ }
+
+	inline
+	bool
+	doSingleUpdate() const
+	{ return true; }
+
+	template<typename... T>
+	void
+	printScheduler(T... vals)
+	{
+#if LOGGING
+		LOG_DEBUG(vals..., " Scheduler state:");
+		LOG_DEBUG(vals..., "    wheel size: ", m_wheel.size(), " base: ", m_base, " in wheel: ", m_wheelcount, " far: ", m_far.size(), " passive: ", m_passive.size());
+		for(std::size_t i = 0; i < size(); ++i){
+			auto m = m_index[i].m_ptr;
+			LOG_DEBUG(vals..., "    ", i, "\t:  model: ", m->getName(), ", time: ", m->getTimeNext(), ", key: ", m_index[i].m_key);
+		}
+#endif
+	}
+
+	/**
+	 * @brief Tests if all models are scheduled on their current next time.
+	 * @note The test is implemented as an assertion.
+	 */
+	void
+	testInvariant()
+	{
+#ifndef NDEBUG
+		std::size_t inwheel = 0;
+		for(std::size_t i = 0; i < m_index.size(); ++i){
+			const Entry& entry = m_index[i];
+			assert(entry.m_key == entry.m_ptr->getTimeNext().getTime() && "Wheel scheduler holds an outdated model time.");
+			assert(listFor(entry)[entry.m_pos] == i && "Wheel scheduler entry is not linked.");
+			if(entry.m_where == WHEEL){
+				assert(entry.m_key - m_base < m_wheel.size() && "Wheel scheduler entry outside window.");
+				++inwheel;
+			}
+			if(entry.m_where == FAR)
+				assert(entry.m_key >= m_farmin && "Wheel scheduler far bound is violated.");
+		}
+		assert(inwheel == m_wheelcount && "Wheel scheduler count is off.");
+#endif
+	}
+};
+
+//specialization for if no additional message is added to printScheduler
+template<>
+inline void
+ModelWheelScheduler<n_model::t_raw_atomic>::printScheduler<>()
+{
+	printScheduler("");
+}
+
+} /* namespace n_scheduler */
+
+#endif /* SRC_SCHEDULER_MODELWHEELSCHEDULER_H_ */
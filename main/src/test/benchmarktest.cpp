@@ -61,6 +61,38 @@ TEST(Benchmark, devstone_single)
     LOG_MOVE("out.txt", true);
 }
 
+TEST(Benchmark, devstone_single_forkjoin)
+{
+    LOG_MOVE("logs/bmarkDevstoneSingleForkjoin.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "DEVStone";
+	conf.m_simType = n_control::SimType::CLASSIC;
+	conf.m_coreAmount = 4;
+	conf.m_saveInterval = 250;
+	conf.m_allocator = n_tools::createObject<n_devstone::DevstoneAlloc>();
+	conf.m_transitionThreads = 4;
+	conf.m_transitionMinimum = 2;
+	std::size_t width = 5;
+	std::size_t depth = 5;
+	bool randTa = false;
+
+	auto ctrl = conf.createController();
+	t_timestamp endTime(eTime, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject< n_devstone::DEVStone>(width, depth, randTa);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "devstoneSingleForkjoin.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	// Same trace as the serial run.
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "devstoneSingleForkjoin.txt", SUBTESTFOLDER "devstoneSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
 TEST(Benchmark, devstone_opt)
 {
     LOG_MOVE("logs/bmarkDevstoneOpt.log", false);
@@ -119,6 +151,37 @@ TEST(Benchmark, devstone_cons)
     LOG_MOVE("out.txt", true);
 }
 
+TEST(Benchmark, devstone_cons_forkjoin)
+{
+    LOG_MOVE("logs/bmarkDevstoneConsForkjoin.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "DEVStone";
+	conf.m_simType = n_control::SimType::CONSERVATIVE;
+	conf.m_coreAmount = 4;
+	conf.m_saveInterval = 250;
+	conf.m_allocator = n_tools::createObject<n_devstone::DevstoneAlloc>();
+	conf.m_transitionThreads = 3;
+	conf.m_transitionMinimum = 2;
+	std::size_t width = 5;
+	std::size_t depth = 5;
+	bool randTa = false;
+
+	auto ctrl = conf.createController();
+	t_timestamp endTime(eTime, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject< n_devstone::DEVStone>(width, depth, randTa);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "devstoneConservativeForkjoin.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "devstoneConservativeForkjoin.txt", SUBTESTFOLDER "devstoneSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
 TEST(Benchmark, devstone_single_r)
 {
     LOG_MOVE("logs/bmarkDevstoneSingleR.log", false);
@@ -177,6 +240,36 @@ TEST(Benchmark, devstone_opt_r)
     LOG_MOVE("out.txt", true);
 }
 
+TEST(Benchmark, devstone_opt_r_checkpoint)
+{
+    LOG_MOVE("logs/bmarkDevstoneOptRCheckpoint.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "DEVStone";
+	conf.m_simType = n_control::SimType::OPTIMISTIC;
+	conf.m_coreAmount = 4;
+	conf.m_saveInterval = 250;
+	conf.m_checkpointInterval = n_model::AtomicModel_impl::CHECKPOINT_ADAPTIVE;
+	conf.m_allocator = n_tools::createObject<n_devstone::DevstoneAlloc>();
+	std::size_t width = 5;
+	std::size_t depth = 5;
+	bool randTa = true;
+
+	auto ctrl = conf.createController();
+	t_timestamp endTime(eTime, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject< n_devstone::DEVStone>(width, depth, randTa);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "devstoneOptimisticRCheckpoint.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "devstoneOptimisticRCheckpoint.txt", SUBTESTFOLDER "devstoneSingleR.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
 TEST(Benchmark, devstone_cons_r)
 {
     LOG_MOVE("logs/bmarkDevstoneConsR.log", false);
@@ -270,6 +363,210 @@ TEST(Benchmark, phold_opt)
     LOG_MOVE("out.txt", true);
 }
 
+TEST(Benchmark, phold_opt_reverse)
+{
+    LOG_MOVE("logs/bmarkPholdOptReverse.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "PHOLD";
+	conf.m_simType = n_control::SimType::OPTIMISTIC;
+	conf.m_coreAmount = 4;
+	conf.m_saveInterval = 250;
+	conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
+	std::size_t nodes = 4;
+	std::size_t apn = 2;
+	std::size_t iter = 0;
+	std::size_t percentageRemotes = 10;
+
+	auto ctrl = conf.createController();
+	t_timestamp endTime(eTimePhold, 0);
+	ctrl->setTerminationTime(endTime);
+
+	// Processors undo their transitions with reverse computation instead of state copies.
+	t_coupledmodelptr d = n_tools::createObject<n_benchmarks_phold::PHOLD>(nodes, apn, iter,
+	        percentageRemotes, 0.1, true);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "pholdOptimisticReverse.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "pholdOptimisticReverse.txt", SUBTESTFOLDER "pholdSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
+TEST(Benchmark, phold_opt_checkpoint)
+{
+    LOG_MOVE("logs/bmarkPholdOptCheckpoint.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "PHOLD";
+	conf.m_simType = n_control::SimType::OPTIMISTIC;
+	conf.m_coreAmount = 4;
+	conf.m_saveInterval = 250;
+	conf.m_checkpointInterval = 4;
+	conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
+	std::size_t nodes = 4;
+	std::size_t apn = 2;
+	std::size_t iter = 0;
+	std::size_t percentageRemotes = 10;
+
+	auto ctrl = conf.createController();
+	t_timestamp endTime(eTimePhold, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject<n_benchmarks_phold::PHOLD>(nodes, apn, iter,
+	        percentageRemotes);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "pholdOptimisticCheckpoint.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "pholdOptimisticCheckpoint.txt", SUBTESTFOLDER "pholdSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
+TEST(Benchmark, phold_opt_lazy)
+{
+    LOG_MOVE("logs/bmarkPholdOptLazy.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "PHOLD";
+	conf.m_simType = n_control::SimType::OPTIMISTIC;
+	conf.m_coreAmount = 4;
+	conf.m_saveInterval = 250;
+	conf.m_lazyCancellation = true;
+	conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
+	std::size_t nodes = 4;
+	std::size_t apn = 2;
+	std::size_t iter = 0;
+	std::size_t percentageRemotes = 10;
+
+	auto ctrl = conf.createController();
+	t_timestamp endTime(eTimePhold, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject<n_benchmarks_phold::PHOLD>(nodes, apn, iter,
+	        percentageRemotes);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "pholdOptimisticLazy.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "pholdOptimisticLazy.txt", SUBTESTFOLDER "pholdSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
+TEST(Benchmark, phold_opt_window)
+{
+    LOG_MOVE("logs/bmarkPholdOptWindow.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "PHOLD";
+	conf.m_simType = n_control::SimType::OPTIMISTIC;
+	conf.m_coreAmount = 4;
+	conf.m_saveInterval = 250;
+	conf.m_optimismWindow = 50;
+	conf.m_adaptiveWindow = true;
+	conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
+	std::size_t nodes = 4;
+	std::size_t apn = 2;
+	std::size_t iter = 0;
+	std::size_t percentageRemotes = 10;
+
+	auto ctrl = conf.createController();
+	t_timestamp endTime(eTimePhold, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject<n_benchmarks_phold::PHOLD>(nodes, apn, iter,
+	        percentageRemotes);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "pholdOptimisticWindow.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "pholdOptimisticWindow.txt", SUBTESTFOLDER "pholdSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
+TEST(Benchmark, phold_hybrid)
+{
+    LOG_MOVE("logs/bmarkPholdHybrid.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "PHOLD";
+	conf.m_simType = n_control::SimType::HYBRID;
+	conf.m_coreAmount = 4;
+	conf.m_saveInterval = 250;
+	conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
+	std::size_t nodes = 4;
+	std::size_t apn = 2;
+	std::size_t iter = 0;
+	std::size_t percentageRemotes = 10;
+
+	auto ctrl = conf.createController();
+	t_timestamp endTime(eTimePhold, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject<n_benchmarks_phold::PHOLD>(nodes, apn, iter,
+	        percentageRemotes);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "pholdHybrid.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "pholdHybrid.txt", SUBTESTFOLDER "pholdSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
+/**
+ * Switches protocol at each GVT, regardless of what was measured.
+ */
+class AlternatingSwitchPolicy: public SwitchPolicy{
+public:
+	SyncMode choose(SyncMode current, const SyncCounts&) const override
+	{
+		return (current == SyncMode::CONSERVATIVE)? SyncMode::OPTIMISTIC : SyncMode::CONSERVATIVE;
+	}
+};
+
+TEST(Benchmark, phold_hybrid_alternating)
+{
+    LOG_MOVE("logs/bmarkPholdHybridAlt.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "PHOLD";
+	conf.m_simType = n_control::SimType::HYBRID;
+	conf.m_coreAmount = 4;
+	conf.m_saveInterval = 250;
+	conf.m_switchPolicy = n_tools::createObject<AlternatingSwitchPolicy>();
+	conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
+	std::size_t nodes = 4;
+	std::size_t apn = 2;
+	std::size_t iter = 0;
+	std::size_t percentageRemotes = 10;
+
+	auto ctrl = conf.createController();
+	ctrl->setGVTInterval(1);
+	t_timestamp endTime(eTimePhold, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject<n_benchmarks_phold::PHOLD>(nodes, apn, iter,
+	        percentageRemotes);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "pholdHybridAlt.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "pholdHybridAlt.txt", SUBTESTFOLDER "pholdSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
 TEST(Benchmark, phold_cons)
 {
     LOG_MOVE("logs/bmarkPholdCons.log", false);
@@ -301,6 +598,163 @@ TEST(Benchmark, phold_cons)
     LOG_MOVE("out.txt", true);
 }
 
+TEST(Benchmark, phold_opt_workers)
+{
+    LOG_MOVE("logs/bmarkPholdOptWorkers.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "PHOLD";
+	conf.m_simType = n_control::SimType::OPTIMISTIC;
+	conf.m_coreAmount = 4;
+	conf.m_workerThreads = 2;
+	conf.m_saveInterval = 250;
+	conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
+	std::size_t nodes = 4;
+	std::size_t apn = 2;
+	std::size_t iter = 0;
+	std::size_t percentageRemotes = 10;
+
+	auto ctrl = conf.createController();
+	EXPECT_EQ(ctrl->getWorkerThreads(), 2u);
+	t_timestamp endTime(eTimePhold, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject<n_benchmarks_phold::PHOLD>(nodes, apn, iter,
+	        percentageRemotes);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "pholdOptimisticWorkers.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "pholdOptimisticWorkers.txt", SUBTESTFOLDER "pholdSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
+TEST(Benchmark, phold_cons_workers)
+{
+    LOG_MOVE("logs/bmarkPholdConsWorkers.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "PHOLD";
+	conf.m_simType = n_control::SimType::CONSERVATIVE;
+	conf.m_coreAmount = 4;
+	conf.m_workerThreads = 2;
+	conf.m_saveInterval = 250;
+	conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
+	std::size_t nodes = 4;
+	std::size_t apn = 2;
+	std::size_t iter = 0;
+	std::size_t percentageRemotes = 10;
+
+	auto ctrl = conf.createController();
+	t_timestamp endTime(eTimePhold, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject<n_benchmarks_phold::PHOLD>(nodes, apn, iter,
+	        percentageRemotes);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "pholdConservativeWorkers.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "pholdConservativeWorkers.txt", SUBTESTFOLDER "pholdSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
+TEST(Benchmark, phold_opt_spsc)
+{
+    LOG_MOVE("logs/bmarkPholdOptSpsc.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "PHOLD";
+	conf.m_simType = n_control::SimType::OPTIMISTIC;
+	conf.m_coreAmount = 4;
+	conf.m_networkType = n_network::NetworkType::SPSC;
+	conf.m_saveInterval = 250;
+	conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
+	std::size_t nodes = 4;
+	std::size_t apn = 2;
+	std::size_t iter = 0;
+	std::size_t percentageRemotes = 10;
+
+	auto ctrl = conf.createController();
+	t_timestamp endTime(eTimePhold, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject<n_benchmarks_phold::PHOLD>(nodes, apn, iter,
+	        percentageRemotes);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "pholdOptimisticSpsc.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "pholdOptimisticSpsc.txt", SUBTESTFOLDER "pholdSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
+/**
+ * Moves all active models but one of each core to the next core, each round, regardless of the load.
+ */
+class RotatingBalancePolicy: public BalancePolicy{
+public:
+	std::vector<Migration> balance(const std::vector<CoreLoad>& loads) override
+	{
+		std::vector<Migration> moves;
+		for(std::size_t core = 0; core < loads.size(); ++core){
+			const std::vector<std::size_t>& events = loads[core].m_events;
+			bool first = true;
+			for(std::size_t id = 0; id < events.size(); ++id){
+				if(!events[id])
+					continue;
+				if(!first)
+					moves.emplace_back(core, id, (core + 1) % loads.size());
+				first = false;
+			}
+		}
+		return moves;
+	}
+};
+
+TEST(Benchmark, phold_opt_balance)
+{
+    LOG_MOVE("logs/bmarkPholdOptBalance.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "PHOLD";
+	conf.m_simType = n_control::SimType::OPTIMISTIC;
+	conf.m_coreAmount = 4;
+	conf.m_networkType = n_network::NetworkType::SPSC;
+	conf.m_saveInterval = 250;
+	conf.m_balancePolicy = n_tools::createObject<RotatingBalancePolicy>();
+	conf.m_balanceRounds = 1;
+	conf.m_allocator = n_tools::createObject<n_benchmarks_phold::PHoldAlloc>();
+	std::size_t nodes = 4;
+	std::size_t apn = 2;
+	// Slow transitions, so there are several GVT (and balance) rounds.
+	std::size_t iter = 5000000;
+	std::size_t percentageRemotes = 10;
+
+	auto ctrl = conf.createController();
+	ctrl->setGVTInterval(1);
+	t_timestamp endTime(eTimePhold, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject<n_benchmarks_phold::PHOLD>(nodes, apn, iter,
+	        percentageRemotes);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "pholdOptimisticBalance.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_GT(ctrl->getMigrations(), 0u);
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "pholdOptimisticBalance.txt", SUBTESTFOLDER "pholdSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
 constexpr t_timestamp::t_time eTimeConnect = 5000;
 
 TEST(Benchmark, connect_single)
@@ -331,6 +785,36 @@ TEST(Benchmark, connect_single)
     LOG_MOVE("out.txt", true);
 }
 
+TEST(Benchmark, connect_single_forkjoin)
+{
+    LOG_MOVE("logs/bmarkConnectSingleForkjoin.log", false);
+	n_control::ControllerConfig conf;
+	conf.m_name = "Interconnect";
+	conf.m_simType = n_control::SimType::CLASSIC;
+	conf.m_coreAmount = 4;
+	conf.m_saveInterval = 250;
+	conf.m_allocator = n_tools::createObject<n_interconnect::InterconnectAlloc>();
+	conf.m_transitionThreads = 3;
+	conf.m_transitionMinimum = 2;
+	std::size_t width = 4;
+	bool randTa = false;
+
+	auto ctrl = conf.createController();
+	t_timestamp endTime(eTimeConnect, 0);
+	ctrl->setTerminationTime(endTime);
+
+	t_coupledmodelptr d = n_tools::createObject<n_interconnect::HighInterconnect>(width, randTa);
+	ctrl->addModel(d);
+	std::ofstream filestream(SUBTESTFOLDER "connectSingleForkjoin.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		ctrl->simulate();
+	};
+
+	EXPECT_EQ(n_misc::filecmp(SUBTESTFOLDER "connectSingleForkjoin.txt", SUBTESTFOLDER "connectSingle.corr"), 0);
+    LOG_MOVE("out.txt", true);
+}
+
 TEST(Benchmark, connect_opt)
 {
     LOG_MOVE("logs/bmarkConnectOpt.log", false);
@@ -15,6 +15,11 @@
 #include "control/controller.h"
 #include "model/conservativecore.h"
 #include "control/simpleallocator.h"
+#include "control/graphallocator.h"
+#include "control/fileallocator.h"
+#include "control/profiler.h"
+#include "model/rootmodel.h"
+#include "performance/devstone/devstone.h"
 #include "examples/trafficlight_classic/trafficlight.h"
 #include "tracers/tracers.h"
 #include "tools/coutredirect.h"
@@ -30,6 +35,9 @@
 #include <sstream>
 #include <vector>
 #include <chrono>
+#include <functional>
+#include <unistd.h>
+#include <sys/wait.h>
 
 using namespace n_control;
 using namespace n_model;
@@ -65,6 +73,141 @@ TEST(Controller, allocation)
 	EXPECT_EQ(m4->getCorenumber(), 1);
 }
 
+TEST(Controller, graphAllocation)
+{
+	RecordProperty("description", "Partitioning of the model graph by the GraphAllocator");
+
+	// Two cliques joined by one edge.
+	AllocGraph cliques;
+	const std::size_t n = 16;
+	cliques.m_weights.assign(n, 1);
+	cliques.m_fixed.assign(n, -1);
+	cliques.m_edges.resize(n);
+	for(std::size_t i = 0; i < n; ++i){
+		for(std::size_t j = 0; j < n; ++j){
+			if(i != j && (i < n/2) == (j < n/2))
+				cliques.m_edges[i].push_back(AllocGraph::t_edge(j, 1));
+		}
+	}
+	cliques.m_edges[0].push_back(AllocGraph::t_edge(n-1, 1));
+	cliques.m_edges[n-1].push_back(AllocGraph::t_edge(0, 1));
+	std::vector<std::size_t> parts = GraphAllocator::partition(cliques, 2);
+	EXPECT_EQ(cliques.cut(parts), 1u);
+	EXPECT_EQ(std::count(parts.begin(), parts.end(), parts[0]), long(n/2));
+
+	// A ring, large enough to be coarsened, with one vertex fixed.
+	AllocGraph ring;
+	const std::size_t r = 256;
+	ring.m_weights.assign(r, 1);
+	ring.m_fixed.assign(r, -1);
+	ring.m_fixed[0] = 3;
+	ring.m_edges.resize(r);
+	for(std::size_t i = 0; i < r; ++i){
+		ring.m_edges[i].push_back(AllocGraph::t_edge((i+1)%r, 1));
+		ring.m_edges[i].push_back(AllocGraph::t_edge((i+r-1)%r, 1));
+	}
+	parts = GraphAllocator::partition(ring, 4);
+	EXPECT_EQ(parts[0], 3u);
+	EXPECT_LE(ring.cut(parts), 8u);
+	for(std::size_t p = 0; p < 4; ++p)
+		EXPECT_LE(std::count(parts.begin(), parts.end(), p), 66);
+
+	// A real model : fewer connections between cores than round robin.
+	n_model::RootModel root;
+	const std::vector<t_atomicmodelptr>& models = root.directConnect(
+	        createObject<n_devstone::DEVStone>(10, 10, false));
+	auto graphalloc = createObject<GraphAllocator>(4, false);
+	graphalloc->allocateAll(models);
+	const AllocGraph graph = graphalloc->buildGraph(models);
+	std::vector<std::size_t> allocated;
+	for(const auto& model : models)
+		allocated.push_back(model->getCorenumber());
+	EXPECT_EQ(graph.cut(allocated), graphalloc->getCut());
+
+	createObject<SimpleAllocator>(4, false)->allocateAll(models);
+	std::vector<std::size_t> roundrobin;
+	for(const auto& model : models)
+		roundrobin.push_back(model->getCorenumber());
+	EXPECT_LT(graphalloc->getCut(), graph.cut(roundrobin));
+}
+
+TEST(Controller, profiler)
+{
+	RecordProperty("description", "A pilot run recommends a setup, the FileAllocator reads its core map");
+
+	Profiler profiler(4);
+	ControllerConfig conf;
+	conf.m_name = "Pilot";
+	conf.m_profile = profiler.getProfile();
+	std::ofstream filestream(TESTFOLDER "controller/profilertest.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		auto ctrl = conf.createController();
+		ctrl->setTerminationTime(t_timestamp(200, 0));
+		ctrl->addModel(createObject<n_devstone::DEVStone>(8, 4, false));
+		ctrl->simulate();
+	}
+	const auto& profiled = profiler.getProfile()->getModels();
+	ASSERT_FALSE(profiled.empty());
+	EXPECT_GT(profiler.getProfile()->getTransitions(), 0u);
+	EXPECT_FALSE(profiler.getProfile()->getLinks().empty());
+	const AllocGraph graph = profiler.buildGraph();
+	EXPECT_EQ(graph.size(), profiled.size());
+	EXPECT_EQ(graph.totalWeight(), profiler.getProfile()->getTransitions());
+
+	const Profiler::Recommendation rec = profiler.recommend();
+	EXPECT_GE(rec.m_cores, 1u);
+	EXPECT_LE(rec.m_cores, 4u);
+	ASSERT_EQ(rec.m_coreMap.size(), profiled.size());
+	EXPECT_EQ(rec.m_cut, graph.cut(rec.m_coreMap));
+
+	std::stringstream map;
+	profiler.writeCoreMap(rec, map);
+	FileAllocator fileAlloc(map);
+	EXPECT_EQ(fileAlloc.coreAmount(), rec.m_cores);
+	ASSERT_TRUE(fileAlloc.hasFileSimType());
+	EXPECT_EQ(fileAlloc.getFileSimType(), rec.m_simType);
+	std::unordered_map<std::string, std::size_t> expected;
+	for(std::size_t i = 0; i < profiled.size(); ++i)
+		expected[profiled[i].m_name] = rec.m_coreMap[i];
+	n_model::RootModel root;
+	const std::vector<t_atomicmodelptr>& models = root.directConnect(
+	        createObject<n_devstone::DEVStone>(8, 4, false));
+	fileAlloc.allocateAll(models);
+	for(const auto& model : models)
+		EXPECT_EQ(std::size_t(model->getCorenumber()), expected[model->getName()]);
+
+	std::stringstream malformed("@cores 2\nfoo\n");
+	EXPECT_THROW(FileAllocator alloc(malformed), std::logic_error);
+	EXPECT_THROW(FileAllocator::parseSimType("pdevs"), std::logic_error);
+}
+
+TEST(Controller, balancePolicy)
+{
+	RecordProperty("description", "Choice of the models to move by the ThresholdBalancePolicy");
+	ThresholdBalancePolicy policy(1.25, 4);
+	std::vector<CoreLoad> loads(3);
+	loads[0].m_busy = 1000;
+	loads[0].m_events = {10, 10};
+	loads[1].m_busy = 1100;
+	loads[1].m_events = {5, 6};
+	loads[2].m_busy = 1200;
+	loads[2].m_events = {1, 1};
+	// Within the imbalance.
+	EXPECT_TRUE(policy.balance(loads).empty());
+
+	// Half the difference is 1000 ns, or 500 of the 1500 transitions of core 2.
+	// The busiest model would overshoot, models 4 and 2 together fit.
+	loads[2].m_busy = 3000;
+	loads[2].m_events = {50, 700, 200, 250, 300};
+	std::vector<Migration> moves = policy.balance(loads);
+	ASSERT_EQ(moves.size(), 2u);
+	EXPECT_EQ(moves[0].m_core, 2u);
+	EXPECT_EQ(moves[0].m_target, 0u);
+	EXPECT_EQ(moves[0].m_model, 4u);
+	EXPECT_EQ(moves[1].m_model, 2u);
+}
+
 TEST(Controller, cDEVS)
 {
 	RecordProperty("description", "Running a simple single core simulation");
@@ -222,6 +365,188 @@ TEST(Controller, pDEVS)
 	EXPECT_EQ(n_misc::filecmp(TESTFOLDER "controller/pdevstest.txt", TESTFOLDER "controller/pdevstest.corr"), 0);
 }
 
+/*
+ * Runs the model create makes until endTime, resuming from snapshot if not empty.
+ * @return the state and times of each model at the end, the new snapshot is written to saved.
+ */
+std::vector<t_coreptr> createCores(SimType type)
+{
+	const std::size_t cores = (type == SimType::CLASSIC)? 1: 2;
+	t_networkptr network = createObject<Network>(cores);
+	std::vector<t_coreptr> coreMap;
+	t_eotvector eotvector = createObject<SharedAtomic<t_timestamp::t_time>>(cores, 0u);
+	t_timevector timevector = createObject<SharedAtomic<t_timestamp::t_time>>(cores + 1, std::numeric_limits<t_timestamp::t_time>::max());
+	timevector->set(cores, 0u);
+	for(std::size_t i = 0; i < cores; ++i){
+		if(type == SimType::CLASSIC)
+			coreMap.push_back(createObject<Core>());
+		else if(type == SimType::CONSERVATIVE)
+			coreMap.push_back(createObject<Conservativecore>(network, i, cores, eotvector, timevector));
+		else
+			coreMap.push_back(createObject<Optimisticcore>(network, i, cores));
+	}
+	return coreMap;
+}
+
+std::vector<std::string> describeModels(const t_coupledmodelptr& m)
+{
+	std::vector<std::string> result;
+	for(const auto& model : m->getComponents()){
+		auto atomic = std::static_pointer_cast<AtomicModel_impl>(model);
+		result.push_back(atomic->getName() + " " + atomic->getState()->toString() + " "
+			+ n_tools::toString(atomic->getTimeLast().getTime()) + " " + n_tools::toString(atomic->getTimeNext().getTime()));
+	}
+	return result;
+}
+
+std::vector<std::string> runSnapshot(SimType type, t_timestamp endTime, const std::string& snapshot, std::string& saved,
+	const std::function<t_coupledmodelptr()>& create = []{ return createObject<n_examples_coupled::TrafficSystem>("trafficSystem"); })
+{
+	auto tracers = createObject<n_tracers::t_tracerset>();
+	std::vector<t_coreptr> coreMap = createCores(type);
+	std::shared_ptr<Allocator> allocator = createObject<SimpleAllocator>(coreMap.size());
+	Controller ctrl("testController", coreMap, allocator, tracers);
+	ctrl.setSimType(type);
+	ctrl.setTerminationTime(endTime);
+	t_coupledmodelptr m = create();
+	ctrl.addModel(m);
+	if(!snapshot.empty()){
+		std::istringstream in(snapshot);
+		EXPECT_LT(ctrl.loadSnapshot(in), endTime);
+		// The models don't start over.
+		for(const auto& model : m->getComponents())
+			EXPECT_GT(std::static_pointer_cast<AtomicModel_impl>(model)->getTimeLast().getTime(), 0u);
+	}
+	ctrl.simulate();
+	std::ostringstream out;
+	ctrl.saveSnapshot(out);
+	saved = out.str();
+	return describeModels(m);
+}
+
+TEST(Controller, snapshot)
+{
+	RecordProperty("description", "Resuming from a snapshot ends as a simulation that did not stop, in any simulation type.");
+	std::ofstream filestream(TESTFOLDER "controller/tmp.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		const t_timestamp warm(1000, 0);
+		const t_timestamp endTime(2000, 0);
+		std::string snapshot;
+		std::string discard;
+		const std::vector<std::string> reference = runSnapshot(SimType::CLASSIC, endTime, "", discard);
+
+		runSnapshot(SimType::CLASSIC, warm, "", snapshot);
+		EXPECT_EQ(runSnapshot(SimType::CLASSIC, endTime, snapshot, discard), reference);
+		EXPECT_EQ(runSnapshot(SimType::OPTIMISTIC, endTime, snapshot, discard), reference);
+
+		runSnapshot(SimType::OPTIMISTIC, warm, "", snapshot);
+		EXPECT_EQ(runSnapshot(SimType::CLASSIC, endTime, snapshot, discard), reference);
+
+		const auto modelC = []{ return createObject<n_examples_abstract_c::ModelC>("modelC"); };
+		const std::vector<std::string> referenceC = runSnapshot(SimType::CLASSIC, t_timestamp(60, 0), "", discard, modelC);
+		// ModelB only has a lookahead in states 0 and 3, at 35 it is in state 3.
+		runSnapshot(SimType::CONSERVATIVE, t_timestamp(35, 0), "", snapshot, modelC);
+		EXPECT_EQ(runSnapshot(SimType::CONSERVATIVE, t_timestamp(60, 0), snapshot, discard, modelC), referenceC);
+		EXPECT_EQ(runSnapshot(SimType::CLASSIC, t_timestamp(60, 0), snapshot, discard, modelC), referenceC);
+
+		// A snapshot of other models, or no snapshot at all, is refused.
+		auto tracers = createObject<n_tracers::t_tracerset>();
+		std::vector<t_coreptr> coreMap = {createObject<Core>()};
+		std::shared_ptr<Allocator> allocator = createObject<SimpleAllocator>(1);
+		Controller ctrl("testController", coreMap, allocator, tracers);
+		ctrl.addModel(t_atomicmodelptr(createObject<TrafficLight>("Fst")));
+		std::istringstream other(snapshot);
+		EXPECT_THROW(ctrl.loadSnapshot(other), std::logic_error);
+		std::istringstream garbage("not a snapshot");
+		EXPECT_THROW(ctrl.loadSnapshot(garbage), std::logic_error);
+	}
+}
+
+/**
+ * Forks a simulation stopped at warm, the parent continues to parentEnd and the child to childEnd.
+ * @return the models of the parent, and of the child in childResult.
+ */
+std::vector<std::string> runFork(SimType type, const std::function<t_coupledmodelptr()>& create, t_timestamp warm,
+	t_timestamp parentEnd, t_timestamp childEnd, std::vector<std::string>& childResult)
+{
+	auto tracers = createObject<n_tracers::t_tracerset>();
+	std::vector<t_coreptr> coreMap = createCores(type);
+	std::shared_ptr<Allocator> allocator = createObject<SimpleAllocator>(coreMap.size());
+	Controller ctrl("testController", coreMap, allocator, tracers);
+	ctrl.setSimType(type);
+	ctrl.setTerminationTime(warm);
+	t_coupledmodelptr m = create();
+	ctrl.addModel(m);
+	ctrl.simulate();
+
+	int fds[2];
+	EXPECT_EQ(pipe(fds), 0);
+	const pid_t pid = ctrl.fork();
+	if(pid == 0){
+		// Never return to the test runner in the child.
+		std::string result;
+		try{
+			ctrl.setTerminationTime(childEnd);
+			ctrl.simulate();
+			for(const auto& line : describeModels(m))
+				result += line + "\n";
+		}catch(...){
+			result = "child failed";
+		}
+		ssize_t written = write(fds[1], result.data(), result.size());
+		_exit(written == ssize_t(result.size())? 0: 1);
+	}
+	close(fds[1]);
+	EXPECT_GT(pid, 0);
+	ctrl.setTerminationTime(parentEnd);
+	ctrl.simulate();
+
+	std::string child;
+	char buffer[256];
+	for(ssize_t n; (n = read(fds[0], buffer, sizeof(buffer))) > 0;)
+		child.append(buffer, n);
+	close(fds[0]);
+	int status = 1;
+	waitpid(pid, &status, 0);
+	EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	childResult.clear();
+	std::istringstream lines(child);
+	for(std::string line; std::getline(lines, line);)
+		childResult.push_back(line);
+	return describeModels(m);
+}
+
+TEST(Controller, fork)
+{
+	RecordProperty("description", "Both branches of a forked simulation end as a simulation that did not stop.");
+	std::ofstream filestream(TESTFOLDER "controller/tmp.txt");
+	{
+		CoutRedirect myRedirect(filestream);
+		std::string discard;
+		std::vector<std::string> child;
+		const auto traffic = []{ return createObject<n_examples_coupled::TrafficSystem>("trafficSystem"); };
+		const std::vector<std::string> reference = runSnapshot(SimType::CLASSIC, t_timestamp(2000, 0), "", discard);
+		const std::vector<std::string> shorter = runSnapshot(SimType::CLASSIC, t_timestamp(1500, 0), "", discard);
+		EXPECT_EQ(runFork(SimType::CLASSIC, traffic, t_timestamp(1000, 0), t_timestamp(1500, 0), t_timestamp(2000, 0), child), shorter);
+		EXPECT_EQ(child, reference);
+
+		// ModelB only has a lookahead in states 0 and 3, at 35 it is in state 3.
+		const auto modelC = []{ return createObject<n_examples_abstract_c::ModelC>("modelC"); };
+		const std::vector<std::string> referenceC = runSnapshot(SimType::CLASSIC, t_timestamp(60, 0), "", discard, modelC);
+		const std::vector<std::string> shorterC = runSnapshot(SimType::CLASSIC, t_timestamp(50, 0), "", discard, modelC);
+		EXPECT_EQ(runFork(SimType::CONSERVATIVE, modelC, t_timestamp(35, 0), t_timestamp(60, 0), t_timestamp(50, 0), child), referenceC);
+		EXPECT_EQ(child, shorterC);
+
+		auto tracers = createObject<n_tracers::t_tracerset>();
+		std::vector<t_coreptr> coreMap = createCores(SimType::OPTIMISTIC);
+		std::shared_ptr<Allocator> allocator = createObject<SimpleAllocator>(coreMap.size());
+		Controller ctrl("testController", coreMap, allocator, tracers);
+		ctrl.setSimType(SimType::OPTIMISTIC);
+		EXPECT_THROW(ctrl.fork(), std::logic_error);
+	}
+}
+
 TEST(Controller, ControllerConfig)
 {
 	RecordProperty("description", "Setting up a simulation using the ControllerConfig object");
@@ -283,3 +608,24 @@ TEST(Controller, CONDEVS)
 
 	EXPECT_EQ(n_misc::filecmp(TESTFOLDER "controller/condevstest.txt", TESTFOLDER "controller/condevstest.corr"), 0);
 }
+
+TEST(Controller, adaptiveGVTInterval)
+{
+	RecordProperty("description", "Choosing the GVT interval from the growth of the cores' history");
+	const std::size_t maximum = 200 * GVT_BACKOFF;
+	// First round : nothing to compare against.
+	EXPECT_EQ(adaptGVTInterval(200, 0, 50000, 0, true, maximum), 200u);
+	// History grows twice as fast : halve.
+	EXPECT_EQ(adaptGVTInterval(200, 200, 20000, 10000, true, maximum), 100u);
+	// Same growth rate and the GVT advanced : back off.
+	EXPECT_EQ(adaptGVTInterval(200, 200, 10000, 10000, true, maximum), 251u);
+	// A longer interval holding proportionally more history is not growth.
+	EXPECT_EQ(adaptGVTInterval(251, 200, 12550, 10000, true, maximum), 314u);
+	// GVT stalled, rate steady : keep.
+	EXPECT_EQ(adaptGVTInterval(200, 200, 10000, 10000, false, maximum), 200u);
+	// Small histories never shorten the interval.
+	EXPECT_EQ(adaptGVTInterval(200, 200, 1000, 10, false, maximum), 200u);
+	// Bounds.
+	EXPECT_EQ(adaptGVTInterval(maximum, maximum, 10, 10, true, maximum), maximum);
+	EXPECT_EQ(adaptGVTInterval(1, 1, 5000, 2000, true, maximum), 1u);
+}
@@ -17,6 +17,7 @@
 #include "examples/trafficlight_coupled/policemanc.h"
 #include "control/controller.h"
 #include "model/conservativecore.h"
+#include "model/hybridcore.h"
 #include "control/simpleallocator.h"
 #include "tracers/tracers.h"
 #include "tools/coutredirect.h"
@@ -283,7 +284,7 @@ TEST(Optimisticcore, revert){
 	coreone->shutDown();
 	EXPECT_EQ(coreone->getTime().getTime(), 108u);
         // Message is not sent by any core, it's not processed, it's not queued so delete here (since it won't be otherwise)
-        delete msgaftergvt;
+        msgaftergvt->deleteMe();
 }
 
 
@@ -562,7 +563,7 @@ TEST(Optimisticcore, revertoffbyone){
 			!=
 		std::static_pointer_cast<AtomicModel_impl>(m->getComponents()[1])->getCorenumber());
 
-        delete msg;
+        msg->deleteMe();
 	}
 }
 
@@ -650,8 +651,8 @@ TEST(Optimisticcore, revertstress){
 			!=
 		std::static_pointer_cast<AtomicModel_impl>(m->getComponents()[1])->getCorenumber());
 
-        delete msglater;
-        delete msg;
+        msglater->deleteMe();
+        msg->deleteMe();
 	}
 }
 
@@ -729,8 +730,361 @@ TEST(Optimisticcore, revert_antimessaging){
 }
 
 
+TEST(Optimisticcore, lazycancellation){
+	RecordProperty("description", "Revert with lazy cancellation, the regenerated message is not cancelled.");
+	std::ofstream filestream(TESTFOLDER "controller/tmp.txt");
+	{
+	auto tracers = createObject<n_tracers::t_tracerset>();
+	CoutRedirect myRedirect(filestream);
+	t_networkptr network = createObject<Network>(2);
+	std::vector<t_coreptr> coreMap;
+	std::shared_ptr<n_control::Allocator> allocator = createObject<n_control::SimpleAllocator>(2);
+
+	auto c1 = createObject<Optimisticcore>(network, 0, 2);
+	auto c2 = createObject<Optimisticcore>(network, 1, 2);
+	c1->setLazyCancellation(true);
+	coreMap.push_back(c1);
+	coreMap.push_back(c2);
+
+	t_timestamp endTime(360, 0);
+
+	n_control::Controller ctrl("testController", coreMap, allocator, tracers);
+	ctrl.setSimType(SimType::OPTIMISTIC);
+	ctrl.setTerminationTime(endTime);
+
+	t_coupledmodelptr m = createObject<n_examples_coupled::TrafficSystem>("trafficSystem");
+	ctrl.addModel(m);
+	c1->setTracers(tracers);
+	c1->init();
+	c1->initThread();
+	c1->setTerminationTime(endTime);
+	c1->setLive(true);
+
+	c2->setTracers(tracers);
+	c2->init();
+	c2->initThread();
+	c2->setTerminationTime(endTime);
+	c2->setLive(true);
+	tracers->startTrace();
+	// c1: has policeman
+	// c2: has trafficlight
+	c1->runSmallStep();
+	c1->runSmallStep();
+	EXPECT_EQ(c1->getTime().getTime(), 300u);	// Core 1 has sent 1 message, trafficlight is still at 0.
+	n_tlocal::setRevert(false);
+	c1->revert(t_timestamp(32,0));
+	n_tlocal::setRevert(false);
+	c1->runSmallStep();	// Time goes from 32 -> 200 (first scheduled), the message is not cancelled yet.
+	EXPECT_EQ(c1->getTime().getTime(), 200u);
+	EXPECT_EQ(c1->getAvoidedCancellations(), 0u);
+	c1->runSmallStep();	// The policeman sends the same message again.
+	EXPECT_EQ(c1->getTime().getTime(), 300u);
+	EXPECT_EQ(c1->getAvoidedCancellations(), 1u);
+	EXPECT_TRUE(c2->existTransientMessage());
+	c2->runSmallStep();	// Trafficlight only receives the original message.
+	EXPECT_FALSE(c2->existTransientMessage());
+	EXPECT_EQ(c2->getTime().getTime(), 58u);
+
+	n_tracers::traceUntil(t_timestamp::infinity());
+	n_tracers::clearAll();
+	n_tracers::waitForTracer();
+	tracers->finishTrace();
+
+	c1->setLive(false);
+	c1->shutDown();
+	c2->setLive(false);
+	c2->shutDown();
+	}
+}
+
+namespace {
+/**
+ * Sends on out every 100 time units, until any input makes it passive.
+ */
+class Passivator: public n_model::AtomicModel<int>
+{
+public:
+	Passivator(int coreNum): AtomicModel<int>("passivator", 0, coreNum)
+	{
+		addInPort("in");
+		addOutPort("out");
+	}
+	void extTransition(const std::vector<n_network::t_msgptr>&) override
+	{
+		state() = 1;
+	}
+	void intTransition() override
+	{ }
+	t_timestamp timeAdvance() const override
+	{
+		return state()? t_timestamp::infinity(): t_timestamp(100, 0);
+	}
+	void output(std::vector<n_network::t_msgptr>& msgs) const override
+	{
+		getPort("out")->createMessages(1, msgs);
+	}
+};
+
+/**
+ * Sends on out once, at time 50.
+ */
+class Interrupter: public n_model::AtomicModel<int>
+{
+public:
+	Interrupter(int coreNum): AtomicModel<int>("interrupter", 0, coreNum)
+	{
+		addInPort("in");
+		addOutPort("out");
+	}
+	void extTransition(const std::vector<n_network::t_msgptr>&) override
+	{ }
+	void intTransition() override
+	{
+		state() = 1;
+	}
+	t_timestamp timeAdvance() const override
+	{
+		return state()? t_timestamp::infinity(): t_timestamp(50, 0);
+	}
+	void output(std::vector<n_network::t_msgptr>& msgs) const override
+	{
+		getPort("out")->createMessages(1, msgs);
+	}
+};
+}
+
+TEST(Optimisticcore, lazycancellationpassive){
+	RecordProperty("description", "Revert with lazy cancellation, the re-executed model passivates and the undone message is cancelled.");
+	std::ofstream filestream(TESTFOLDER "controller/tmp.txt");
+	{
+	auto tracers = createObject<n_tracers::t_tracerset>();
+	CoutRedirect myRedirect(filestream);
+	t_networkptr network = createObject<Network>(2);
+	std::vector<t_coreptr> coreMap;
+	std::shared_ptr<n_control::Allocator> allocator = createObject<n_control::SimpleAllocator>(2);
+
+	auto c1 = createObject<Optimisticcore>(network, 0, 2);
+	auto c2 = createObject<Optimisticcore>(network, 1, 2);
+	c1->setLazyCancellation(true);
+	coreMap.push_back(c1);
+	coreMap.push_back(c2);
+
+	t_timestamp endTime(360, 0);
+
+	n_control::Controller ctrl("testController", coreMap, allocator, tracers);
+	ctrl.setSimType(SimType::OPTIMISTIC);
+	ctrl.setTerminationTime(endTime);
+
+	t_coupledmodelptr m = createObject<n_model::CoupledModel>("passive");
+	auto passivator = createObject<Passivator>(0);
+	auto interrupter = createObject<Interrupter>(1);
+	m->addSubModel(passivator);
+	m->addSubModel(interrupter);
+	m->connectPorts(passivator->getPort("out"), interrupter->getPort("in"));
+	m->connectPorts(interrupter->getPort("out"), passivator->getPort("in"));
+	ctrl.addModel(m);
+	for(auto core : {c1, c2}){
+		core->setTracers(tracers);
+		core->init();
+		core->initThread();
+		core->setTerminationTime(endTime);
+		core->setLive(true);
+	}
+	tracers->startTrace();
+	// c1: has the passivator, runs ahead and sends at 100.
+	for(std::size_t i = 0; i < 5 && c1->getTime().getTime() < 200u; ++i)
+		c1->runSmallStep();
+	EXPECT_EQ(c1->getTime().getTime(), 200u);
+	// c2: has the interrupter, sends the straggler at 50.
+	for(std::size_t i = 0; i < 5 && c2->getTime().getTime() <= 50u; ++i)
+		c2->runSmallStep();
+	EXPECT_EQ(c2->getTime().getTime(), 100u);
+	// c1 reverts to 50, the passivator no longer has a next event, so the message at 100 is cancelled.
+	c1->runSmallStep();
+	EXPECT_EQ(c1->getAvoidedCancellations(), 0u);
+	EXPECT_TRUE(c2->existTransientMessage());
+	n_tlocal::setRevert(false);
+	c2->runSmallStep();	// The antimessage annihilates the message at 100.
+	EXPECT_FALSE(c2->existTransientMessage());
+	EXPECT_TRUE(isInfinity(c2->getFirstMessageTime()));
+
+	n_tracers::traceUntil(t_timestamp::infinity());
+	n_tracers::clearAll();
+	n_tracers::waitForTracer();
+	tracers->finishTrace();
+
+	c1->setLive(false);
+	c1->shutDown();
+	c2->setLive(false);
+	c2->shutDown();
+	}
+}
+
+TEST(Optimisticcore, optimismwindow){
+	RecordProperty("description", "A core beyond GVT + window does not simulate until GVT moves.");
+	std::ofstream filestream(TESTFOLDER "controller/tmp.txt");
+	{
+	auto tracers = createObject<n_tracers::t_tracerset>();
+	CoutRedirect myRedirect(filestream);
+	t_networkptr network = createObject<Network>(2);
+	std::vector<t_coreptr> coreMap;
+	std::shared_ptr<n_control::Allocator> allocator = createObject<n_control::SimpleAllocator>(2);
+
+	auto c1 = createObject<Optimisticcore>(network, 0, 2);
+	auto c2 = createObject<Optimisticcore>(network, 1, 2);
+	c1->setOptimismWindow(250);
+	coreMap.push_back(c1);
+	coreMap.push_back(c2);
+
+	t_timestamp endTime(360, 0);
+
+	n_control::Controller ctrl("testController", coreMap, allocator, tracers);
+	ctrl.setSimType(SimType::OPTIMISTIC);
+	ctrl.setTerminationTime(endTime);
+
+	t_coupledmodelptr m = createObject<n_examples_coupled::TrafficSystem>("trafficSystem");
+	ctrl.addModel(m);
+	c1->setTracers(tracers);
+	c1->init();
+	c1->initThread();
+	c1->setTerminationTime(endTime);
+	c1->setLive(true);
+
+	c2->setTracers(tracers);
+	c2->init();
+	c2->initThread();
+	c2->setTerminationTime(endTime);
+	c2->setLive(true);
+	tracers->startTrace();
+	// c1: has policeman
+	c1->runSmallStep();
+	c1->runSmallStep();
+	EXPECT_EQ(c1->getTime().getTime(), 300u);
+	EXPECT_EQ(c1->getThrottledTime(), 0u);
+	c1->runSmallStep();	// 300 > 0 + 250
+	EXPECT_EQ(c1->getTime().getTime(), 300u);
+	std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	c1->runSmallStep();
+	EXPECT_EQ(c1->getTime().getTime(), 300u);
+	c1->setGVT(t_timestamp(100, 0));
+	c1->runSmallStep();	// Back within the window.
+	EXPECT_GT(c1->getTime().getTime(), 300u);
+	EXPECT_GE(c1->getThrottledTime(), 2000u);
+	EXPECT_EQ(c1->getOptimismWindow(), 250u);
+
+	n_tracers::traceUntil(t_timestamp::infinity());
+	n_tracers::clearAll();
+	n_tracers::waitForTracer();
+	tracers->finishTrace();
+
+	c1->setLive(false);
+	c1->shutDown();
+	c2->setLive(false);
+	c2->shutDown();
+	}
+}
+
+TEST(Optimisticcore, cancelback){
+	RecordProperty("description", "Over the history budget, the core furthest ahead rolls back halfway to GVT and holds.");
+	SharedGVT budget(2, 1000000);
+	EXPECT_FALSE(budget.isOverBudget());
+	budget.publish(0, 10, 5);
+	budget.publish(1, 10, 5);
+	EXPECT_FALSE(budget.isOverBudget());
+	budget.setHistoryBudget(9);
+	EXPECT_TRUE(budget.isOverBudget());
+	// Equal times, the lowest id is furthest.
+	EXPECT_TRUE(budget.isFurthest(0));
+	EXPECT_FALSE(budget.isFurthest(1));
+	budget.publish(1, 20, 0);
+	EXPECT_FALSE(budget.isOverBudget());
+	EXPECT_TRUE(budget.isFurthest(1));
+	// An idle core can't cancel back, the next one furthest ahead does.
+	budget.publish(1, t_timestamp::MAXTIME, 0);
+	EXPECT_TRUE(budget.isFurthest(0));
+
+	std::ofstream filestream(TESTFOLDER "controller/tmp.txt");
+	{
+	auto tracers = createObject<n_tracers::t_tracerset>();
+	CoutRedirect myRedirect(filestream);
+	t_networkptr network = createObject<Network>(2);
+	std::vector<t_coreptr> coreMap;
+	std::shared_ptr<n_control::Allocator> allocator = createObject<n_control::SimpleAllocator>(2);
+
+	auto c1 = createObject<Optimisticcore>(network, 0, 2);
+	auto c2 = createObject<Optimisticcore>(network, 1, 2);
+	coreMap.push_back(c1);
+	coreMap.push_back(c2);
+
+	t_timestamp endTime(360, 0);
+
+	n_control::Controller ctrl("testController", coreMap, allocator, tracers);
+	ctrl.setSimType(SimType::OPTIMISTIC);
+	ctrl.setTerminationTime(endTime);
+
+	t_coupledmodelptr m = createObject<n_examples_coupled::TrafficSystem>("trafficSystem");
+	ctrl.addModel(m);
+	c1->setTracers(tracers);
+	c1->init();
+	c1->initThread();
+	c1->setTerminationTime(endTime);
+	c1->setLive(true);
+
+	c2->setTracers(tracers);
+	c2->init();
+	c2->initThread();
+	c2->setTerminationTime(endTime);
+	c2->setLive(true);
+	t_sharedgvtptr gvt = createObject<SharedGVT>(2, 1000000);
+	gvt->setHistoryBudget(1);
+	c1->setSharedGVT(gvt);
+	c2->setSharedGVT(gvt);
+	tracers->startTrace();
+	// c1: has policeman
+	c1->runSmallStep();
+	c1->runSmallStep();
+	EXPECT_EQ(c1->getTime().getTime(), 300u);
+	EXPECT_EQ(c1->getCancelbacks(), 0u);
+	const t_timestamp::t_time gvtnow = c1->getGVT().getTime();
+	c1->runSmallStep();	// Over budget, back from 300 halfway to GVT.
+	EXPECT_EQ(c1->getCancelbacks(), 1u);
+	EXPECT_EQ(gvt->getCancelbacks(), 1u);
+	EXPECT_EQ(c1->getTime().getTime(), gvtnow + (300u - gvtnow) / 2);
+	EXPECT_TRUE(gvt->isActive());
+	const auto held = c1->getTime();
+	c1->runSmallStep();	// Holds until GVT moves.
+	EXPECT_EQ(c1->getTime(), held);
+	EXPECT_EQ(c1->getCancelbacks(), 1u);
+
+	n_tracers::traceUntil(t_timestamp::infinity());
+	n_tracers::clearAll();
+	n_tracers::waitForTracer();
+	tracers->finishTrace();
+
+	c1->setLive(false);
+	c1->shutDown();
+	c2->setLive(false);
+	c2->shutDown();
+	}
+}
+
+TEST(Hybridcore, thresholdpolicy){
+	RecordProperty("description", "The default policy switches on stalls when conservative, on reverts when optimistic.");
+	ThresholdSwitchPolicy policy(0.5, 0.2);
+	SyncCounts counts;
+	counts.m_turns = 100;
+	counts.m_stalls = 50;
+	counts.m_reverts = 50;
+	EXPECT_EQ(policy.choose(SyncMode::CONSERVATIVE, counts), SyncMode::CONSERVATIVE);
+	EXPECT_EQ(policy.choose(SyncMode::OPTIMISTIC, counts), SyncMode::CONSERVATIVE);
+	counts.m_stalls = 51;
+	counts.m_reverts = 20;
+	EXPECT_EQ(policy.choose(SyncMode::CONSERVATIVE, counts), SyncMode::OPTIMISTIC);
+	EXPECT_EQ(policy.choose(SyncMode::OPTIMISTIC, counts), SyncMode::OPTIMISTIC);
+}
+
 TEST(Optimisticcore, GVT){
-	RecordProperty("description", "Manually run GVT.");
+	RecordProperty("description", "Manually run a round of the shared GVT.");
 	std::ofstream filestream(TESTFOLDER "controller/tmp.txt");
 	{
 	CoutRedirect myRedirect(filestream);
@@ -767,6 +1121,10 @@ TEST(Optimisticcore, GVT){
 	c2->setTerminationTime(endTime);
 	c2->setLive(true);
 	c2->logCoreState();
+	// The interval keeps rounds from starting on their own, the test starts one.
+	t_sharedgvtptr gvt = createObject<SharedGVT>(2, 1000000);
+	c1->setSharedGVT(gvt);
+	c2->setSharedGVT(gvt);
 	tracers->startTrace();
 	// c1: has policeman
 	// c2: has trafficlight
@@ -777,12 +1135,27 @@ TEST(Optimisticcore, GVT){
 	c2->logCoreState();	// C2 @108
 	c1->runSmallStep();	// C1
 	c1->logCoreState(); 	// C1 @200, GVT = 108.
-	std::atomic<bool> rungvt(true);
-	n_control::runGVT(ctrl, rungvt);
-	EXPECT_EQ(c1->getGVT().getTime(), 108u);
+	EXPECT_TRUE(gvt->start());
+	EXPECT_FALSE(gvt->start());
+	// Both cores switch to red, then report once all white messages are received.
+	std::size_t steps = 0;
+	while(gvt->isActive() && steps < 10){
+		c2->runSmallStep();
+		c1->runSmallStep();
+		++steps;
+	}
+	EXPECT_FALSE(gvt->isActive());
+	// C2 reports after it moved on from 108, the GVT can't pass either core.
+	EXPECT_GE(gvt->getGVT(), 108u);
+	EXPECT_LE(gvt->getGVT(), c1->getTime().getTime());
+	EXPECT_LE(gvt->getGVT(), c2->getTime().getTime());
+	EXPECT_EQ(c1->getColor(), MessageColor::RED);
+	EXPECT_EQ(c2->getColor(), MessageColor::RED);
+	// The found GVT is applied at the start of the next step.
+	c2->runSmallStep();
+	c1->runSmallStep();
+	EXPECT_EQ(c1->getGVT().getTime(), gvt->getGVT());
 	EXPECT_EQ(c1->getGVT(), c2->getGVT());
-	EXPECT_EQ(c1->getColor(), MessageColor::WHITE);
-	EXPECT_EQ(c2->getColor(), MessageColor::WHITE);
 			EXPECT_TRUE(std::static_pointer_cast<AtomicModel_impl>(m->getComponents()[0])->getCorenumber()
 				!=
 			std::static_pointer_cast<AtomicModel_impl>(m->getComponents()[1])->getCorenumber());
@@ -12,6 +12,7 @@
 #include "network/messageentry.h"
 #include "scheduler/scheduler.h"
 #include "scheduler/schedulerfactory.h"
+#include "scheduler/ladderscheduler.h"
 #include <unordered_map>
 #include <unordered_set>
 #include "tools/objectfactory.h"
@@ -20,6 +21,7 @@
 #include <gtest/gtest.h>
 #include <queue>
 #include <thread>
+#include <random>
 
 using namespace n_tools;
 using namespace n_network;
@@ -177,6 +179,101 @@ TEST(Message, ContentTest){
 	EXPECT_NE(data.i, control.i);
 }
 
+TEST(Message, Multicast){
+	SharedPayload<std::string>* shared = n_tools::createPooledObject<SharedPayload<std::string>>("payload");
+	t_msgptr first = n_tools::createPooledObject<MulticastMessage<std::string>>(n_model::uuid(1, 0), n_model::uuid(42, 0), 1, 3u, 2u, shared);
+	t_msgptr second = n_tools::createPooledObject<MulticastMessage<std::string>>(n_model::uuid(1, 0), n_model::uuid(43, 1), 1, 4u, 2u, shared);
+	EXPECT_EQ(first->getPayload(), "payload");
+	EXPECT_EQ(second->getDestinationCore(), 43u);
+	EXPECT_EQ(second->getDestinationPort(), 4u);
+	EXPECT_EQ(&n_network::getMsgPayload<std::string>(first), &n_network::getMsgPayload<std::string>(second));
+	// A copy shares the payload, and keeps it alive after the originals are released.
+	t_msgptr copy = first->copyMessage();
+	first->releaseMe();
+	second->releaseMe();
+	EXPECT_EQ(n_network::getMsgPayload<std::string>(copy), "payload");
+	EXPECT_EQ(copy->getDestinationModel(), 0u);
+	copy->releaseMe();
+
+	EXPECT_TRUE(is_shared_payload<std::string>::value);
+	EXPECT_FALSE(is_shared_payload<double>::value);
+}
+
+TEST(Message, Header){
+	EXPECT_LE(sizeof(Message), 40u);
+	t_msgptr base = n_tools::createPooledObject<Message>(n_model::uuid(1, 0), n_model::uuid(42, 0), t_timestamp(1, 0), 3u, 2u);
+	t_msgptr str = n_tools::createPooledObject<SpecializedMessage<std::string>>(n_model::uuid(1, 0), n_model::uuid(42, 0), t_timestamp(1, 0), 3u, 2u, "payload");
+	t_msgptr dbl = n_tools::createPooledObject<SpecializedMessage<double>>(n_model::uuid(1, 0), n_model::uuid(42, 0), t_timestamp(1, 0), 3u, 2u, 0.5);
+	EXPECT_EQ(base->getType(), 0u);
+	EXPECT_NE(str->getType(), dbl->getType());
+	EXPECT_EQ(str->getType(), messageType<SpecializedMessage<std::string>>());
+	EXPECT_THROW(base->getPayload(), std::logic_error);
+	EXPECT_EQ(dbl->getPayload(), "0.5");
+	// A copy has the type and payload of the original, but not its flags.
+	str->paint(MessageColor::RED);
+	str->setFlag(Status::HEAPED);
+	t_msgptr copy = str->copyMessage();
+	EXPECT_EQ(copy->getType(), str->getType());
+	EXPECT_EQ(copy->getPayload(), "payload");
+	EXPECT_EQ(copy->getColor(), MessageColor::WHITE);
+	EXPECT_FALSE(copy->flagIsSet(Status::HEAPED));
+	// Sender and receiver flags don't overwrite each other.
+	str->setFlag(Status::ANTICOLOR);
+	str->setFlag(Status::KILL);
+	str->paint(MessageColor::WHITE);
+	EXPECT_TRUE(str->flagIsSet(Status::HEAPED));
+	EXPECT_TRUE(str->flagIsSet(Status::KILL));
+	EXPECT_EQ(str->getAntiColor(), MessageColor::RED);
+	EXPECT_EQ(str->getColor(), MessageColor::WHITE);
+	for(t_msgptr msg : {base, str, dbl, copy})
+		msg->releaseMe();
+}
+
+namespace {
+// Payloads without operator==, one trivially copyable, one not.
+struct PlainPayload{
+	int m_a;
+	int m_b;
+};
+struct NamedPayload{
+	std::string m_name;
+};
+std::ostream& operator<<(std::ostream& os, const PlainPayload& p){return os << p.m_a;}
+std::ostream& operator<<(std::ostream& os, const NamedPayload&){return os;}
+
+template<typename T>
+t_msgptr makePayloadMessage(const T& data){
+	return n_tools::createPooledObject<SpecializedMessage<T>>(n_model::uuid(1, 0), n_model::uuid(42, 0), t_timestamp(1, 0), 3u, 2u, data);
+}
+}
+
+TEST(Message, SamePayload){
+	// Payloads that format the same can still differ.
+	t_msgptr dbl = makePayloadMessage<double>(0.1);
+	t_msgptr close = makePayloadMessage<double>(0.1 + 1e-12);
+	t_msgptr dblcopy = dbl->copyMessage();
+	EXPECT_EQ(dbl->getPayload(), close->getPayload());
+	EXPECT_FALSE(dbl->samePayload(close));
+	EXPECT_TRUE(dbl->samePayload(dblcopy));
+	t_msgptr flt = makePayloadMessage<float>(0.5f);
+	t_msgptr half = makePayloadMessage<double>(0.5);
+	EXPECT_FALSE(half->samePayload(flt));
+	// Trivially copyable payloads without operator== are compared bytewise.
+	t_msgptr plain = makePayloadMessage(PlainPayload{1, 2});
+	t_msgptr other = makePayloadMessage(PlainPayload{1, 3});
+	t_msgptr plaincopy = plain->copyMessage();
+	EXPECT_EQ(plain->getPayload(), other->getPayload());
+	EXPECT_FALSE(plain->samePayload(other));
+	EXPECT_TRUE(plain->samePayload(plaincopy));
+	// Anything else can't be compared, not even with itself.
+	t_msgptr named = makePayloadMessage(NamedPayload{"a"});
+	EXPECT_FALSE(named->samePayload(named));
+	t_msgptr base = n_tools::createPooledObject<Message>(n_model::uuid(1, 0), n_model::uuid(42, 0), t_timestamp(1, 0), 3u, 2u);
+	EXPECT_FALSE(base->samePayload(base));
+	for(t_msgptr msg : {dbl, close, dblcopy, flt, half, plain, other, plaincopy, named, base})
+		msg->releaseMe();
+}
+
 TEST(Message, PackedID){
 	mid z;
         EXPECT_EQ(z.coreid(), 0u);
@@ -264,5 +361,56 @@ TEST(Message, Integrity){
         EXPECT_EQ(msg->getDestinationPort(),n_const::port_max);
         EXPECT_EQ(msg->getDestinationCore(),254u);
         EXPECT_EQ(msg->getDestinationModel(),2096u);
-        delete msg;
+        msg->deleteMe();
+}
+
+TEST(Message, LadderScheduler){
+        /// Compare the ladder queue against the heap scheduler, with pushes interleaved with (partial) dequeues.
+	n_scheduler::LadderScheduler<MessageEntry, MessageEntryTime> ladder;
+	auto heap = n_scheduler::SchedulerFactory<MessageEntry>::makeScheduler(n_scheduler::Storage::FIBONACCI, false, n_scheduler::KeyStorage::NONE);
+        std::mt19937 rng(42);
+        std::vector<t_msgptr> msgs;
+        std::size_t now = 0;
+        for(size_t round = 0; round < 50; ++round){
+                // Mostly future messages, some clustered on a single timestamp, some stragglers close to now.
+                for(size_t i = 0; i < 500; ++i){
+                        const std::size_t choice = rng() % 10;
+                        const std::size_t time = (choice == 0) ? now + 7 : (choice == 1) ? now + rng()%3 : now + rng()%10000;
+                        t_msgptr msg = createRawObject<Message>(n_model::uuid(1, 0), n_model::uuid(42, 0), t_timestamp(time, rng()%4), 3u, 2u);
+                        msgs.push_back(msg);
+                        ladder.push_back(MessageEntry(msg));
+                        heap->push_back(MessageEntry(msg));
+                }
+                EXPECT_EQ(ladder.size(), heap->size());
+                now += 500;
+                t_msgptr token = createRawObject<Message>(n_model::uuid(1, 0), n_model::uuid(42, 0), makeLatest(t_timestamp(now, 0)), 0u, 0u);
+                std::vector<MessageEntry> fromladder, fromheap;
+                ladder.unschedule_until(fromladder, MessageEntry(token));
+                heap->unschedule_until(fromheap, MessageEntry(token));
+                ASSERT_EQ(fromladder.size(), fromheap.size());
+                for(size_t i = 0; i < fromladder.size(); ++i)
+                        EXPECT_EQ(fromladder[i].getMessage()->getTimeStamp(), fromheap[i].getMessage()->getTimeStamp());
+                if(!ladder.empty()){
+                        EXPECT_EQ(ladder.top().getMessage()->getTimeStamp(), heap->top().getMessage()->getTimeStamp());
+                }
+                delete token;
+        }
+        /// Erase/contains
+        MessageEntry victim(msgs.back());
+        EXPECT_TRUE(ladder.contains(victim));
+        EXPECT_TRUE(ladder.erase(victim));
+        EXPECT_FALSE(ladder.contains(victim));
+        EXPECT_FALSE(ladder.erase(victim));
+        EXPECT_EQ(ladder.size() + 1, heap->size());
+        /// Drain
+        t_timestamp last(0, 0);
+        while(!ladder.empty()){
+                const t_timestamp next = ladder.pop().getMessage()->getTimeStamp();
+                EXPECT_TRUE(last <= next);
+                last = next;
+        }
+        ladder.clear();
+        EXPECT_EQ(ladder.size(), 0u);
+        for(auto msg : msgs)
+                delete msg;
 }
@@ -48,6 +48,18 @@ public:
 	{
 	}
 };
+class PoliceRobot: public n_examples_coupled::Policeman
+{
+public:
+	PoliceRobot()
+		: n_examples_coupled::Policeman("policeRobot")
+	{
+		setStaticLookahead(t_timestamp(7));
+	}
+	virtual ~PoliceRobot()
+	{
+	}
+};
 class PoliceSystem: public CoupledModel
 {
 public:
@@ -118,6 +130,15 @@ TEST(Model, AtomicModel)
 	EXPECT_EQ(tl.getName(), "Trafficlight1");
 }
 
+TEST(Model, StaticLookahead)
+{
+	RecordProperty("description", "Verifies a declared static lookahead replaces lookAhead()");
+	PoliceOfficer officer("policeOfficer");
+	EXPECT_EQ(officer.getLookahead(), officer.lookAhead());
+	PoliceRobot robot;
+	EXPECT_EQ(robot.getLookahead(), t_timestamp(7));
+}
+
 TEST(Model, TransitionTesting)
 {
 	RecordProperty("description", "Verifies transition functionality of models using the TrafficLightModel");
@@ -138,6 +159,50 @@ TEST(Model, TransitionTesting)
 	EXPECT_EQ(tl.timeAdvance(), t_timestamp(60));
 }
 
+TEST(Model, CheckpointRevert)
+{
+	RecordProperty("description", "Verifies that a model with sparse checkpoints reverts to the same states as one that copies each state.");
+	for (std::size_t interval : {1u, 3u, 5u}) {
+		n_examples::TrafficLight tl("TrafficLight1");
+		tl.setKeepOldStates(true);
+		tl.setCheckpointInterval(interval);
+		tl.prepareSimulation();
+		tl.setTime(t_timestamp(0));
+		std::vector<std::string> states;
+		std::vector<t_timestamp> times;
+		auto step = [&](std::size_t count) {
+			for (std::size_t i = 0; i < count; ++i) {
+				const t_timestamp now = tl.getTimeNext();
+				tl.doIntTransition();
+				tl.setTime(now);
+				states.push_back(tl.getState()->toString());
+				times.push_back(now);
+			}
+		};
+		auto revertTo = [&](std::size_t index) {
+			// Undo transition index and all after it.
+			EXPECT_EQ(tl.revert(times[index]), times[index]);
+			EXPECT_EQ(tl.getState()->toString(), states[index - 1]);
+			EXPECT_EQ(tl.getTimeLast(), times[index - 1]);
+			states.resize(index);
+			times.resize(index);
+		};
+		step(20);
+		revertTo(14);
+		step(4);
+		revertTo(16);
+		revertTo(11);
+		step(10);
+		tl.setGVT(times[9]);
+		revertTo(10);
+		step(3);
+		tl.setGVT(times[12]);
+		revertTo(13);
+		EXPECT_EQ(tl.getCheckpointInterval(), interval);
+		tl.exitSimulation();
+	}
+}
+
 TEST(State, Basic)
 {
 	RecordProperty("description", "Verifies bassic functionality of state");
@@ -158,6 +223,33 @@ TEST(Port, Basic)
 	EXPECT_TRUE(trafficlight->getPort("INTERRUPT") != nullptr);
 }
 
+TEST(Port, SharedPayload)
+{
+	PoliceBoss boss;
+	PoliceOfficer first("first");
+	PoliceOfficer second("second");
+	PoliceOfficer third("third");
+	boss.initUUID(0, 0);
+	first.initUUID(0, 1);
+	second.initUUID(0, 2);
+	third.initUUID(0, 3);
+	t_portptr out = boss.getPort("POLICECOMMSOUT");
+	out->setZFunc(first.getPort("POLICECOMMSIN").get());
+	out->setZFunc(second.getPort("POLICECOMMSIN").get());
+	out->setZFunc(third.getPort("POLICECOMMSIN").get(), createObject<ZFunc>());
+	std::vector<n_network::t_msgptr> msgs;
+	out->createMessages(std::string("toManual"), msgs);
+	ASSERT_EQ(msgs.size(), 3u);
+	// Connections without a zfunction share the payload, the zfunction gets its own copy.
+	EXPECT_EQ(&n_network::getMsgPayload<std::string>(msgs[0]), &n_network::getMsgPayload<std::string>(msgs[1]));
+	EXPECT_NE(&n_network::getMsgPayload<std::string>(msgs[0]), &n_network::getMsgPayload<std::string>(msgs[2]));
+	for(n_network::t_msgptr msg : msgs){
+		EXPECT_EQ(msg->getPayload(), "toManual");
+		msg->releaseMe();
+	}
+	out->clearSentMessages();
+}
+
 TEST(RootModel, DirectConnectLayered)
 {
 	RecordProperty("description", "Tests directConnect with a layered coupled model");
@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 #include "network/timestamp.h"
 #include "network/network.h"
+#include "network/spscnetwork.h"
 #include "tools/objectfactory.h"
 #include <unordered_set>
 #include <thread>
@@ -175,6 +176,77 @@ TEST(Network, mixedthreadsafety)
 	}
 }
 
+TEST(Network, spscSpill){
+	n_network::SPSCNetwork n(2, 4);
+	EXPECT_EQ(n.empty(), true);
+	constexpr size_t msgcount = 10;
+	for (size_t i = 0; i < msgcount; ++i)
+		n.acceptMessage(n_tools::createRawObject<Message>(n_model::uuid(0, 0), n_model::uuid(1, 0), t_timestamp(i, 0), 0, 0));
+	EXPECT_EQ(n.empty(), false);
+	EXPECT_FALSE(n.havePendingMessages(0));
+	EXPECT_TRUE(n.havePendingMessages(1));
+	EXPECT_EQ(n.spills(), msgcount-4);
+	auto msgs = n.getMessages(1);
+	ASSERT_EQ(msgs.size(), msgcount);
+	for (size_t i = 0; i < msgcount; ++i) {
+		EXPECT_EQ(msgs[i]->getTimeStamp().getTime(), t_timestamp(i, 0).getTime());
+		delete msgs[i];
+	}
+	EXPECT_EQ(n.empty(), true);
+}
+
+void pushSource(size_t pushcount, size_t coreid, n_network::Network& net, size_t cores)
+{
+	for (size_t i = 0; i < pushcount; ++i) {
+		for (size_t j = 0; j < cores; ++j) {
+			if (j == coreid)
+				continue;
+			net.acceptMessage(n_tools::createRawObject<Message>(n_model::uuid(coreid, 0), n_model::uuid(j, 0), t_timestamp(i, 0), 0, 0));
+		}
+	}
+}
+
+void pullOrdered(size_t pushcount, size_t coreid, n_network::Network& net, size_t cores)
+{
+	std::vector<t_timestamp::t_time> last(cores, 0);
+	std::vector<size_t> seen(cores, 0);
+	size_t received = 0;
+	while (received != pushcount * (cores - 1)) {
+		if (!net.havePendingMessages(coreid)) {
+			std::this_thread::yield();
+			continue;
+		}
+		for (t_msgptr msg : net.getMessages(coreid)) {
+			const size_t src = msg->getSourceCore();
+			// Messages from a single source arrive in the order they were sent.
+			if (seen[src]) {
+				EXPECT_TRUE(last[src] < msg->getTimeStamp().getTime());
+			}
+			last[src] = msg->getTimeStamp().getTime();
+			++seen[src];
+			++received;
+			delete msg;
+		}
+	}
+}
+
+TEST(Network, spscthreadsafety)
+{
+	constexpr size_t cores = 4;
+	constexpr size_t msgcount = 500;
+	// Small channels, so both the ring and the overflow path are hit.
+	n_network::SPSCNetwork n(cores, 16);
+	std::vector<std::thread> workers;
+	for (size_t i = 0; i < cores; ++i) {
+		workers.push_back(std::thread(pushSource, msgcount, i, std::ref(n), cores));
+		workers.push_back(std::thread(pullOrdered, msgcount, i, std::ref(n), cores));
+	}
+	for (auto& t : workers) {
+		t.join();
+	}
+	EXPECT_EQ(n.empty(), true);
+}
+
 void benchNetworkSpeed()
 {
 	// Each thread pushes msgcount * cores-1 messages, pulls msgcount * cores-1messages.
@@ -16,6 +16,12 @@
 #include "control/controllerconfig.h"
 #include "tools/objectfactory.h"
 #include "performance/devstone/devstone.h"
+#include "scheduler/modelscheduler.h"
+#include "control/controller.h"
+#include "control/simpleallocator.h"
+#include "tracers/tracers.h"
+#include <chrono>
+#include <algorithm>
 
 using namespace n_control;
 using namespace n_devstone;
@@ -66,3 +72,202 @@ TEST(Performance, PHOLD)
 		ctrl->simulate();
 	}
 }
+
+#ifndef FPTIME
+namespace {
+
+/**
+ * Atomic model with a time advance set from outside, to replay the timing behaviour of a benchmark.
+ */
+class HoldModel: public n_model::AtomicModel<void>
+{
+public:
+	t_timestamp::t_time m_ta;
+	HoldModel(std::size_t id):
+		n_model::AtomicModel<void>("hold_" + std::to_string(id)), m_ta(1)
+	{ }
+	virtual void intTransition() override
+	{ }
+	virtual t_timestamp timeAdvance() const override
+	{ return (m_ta == t_timestamp::MAXTIME)? t_timestamp::infinity(): t_timestamp(m_ta, 0); }
+};
+
+/**
+ * What the model scheduler of a core sees in one step : the time, the nr of imminents
+ * and the new time next of each model that transitioned.
+ */
+struct ScheduleStep
+{
+	t_timestamp::t_time m_time;
+	std::size_t m_imminents;
+	std::vector<std::pair<std::size_t, t_timestamp::t_time>> m_updates;
+};
+
+t_timestamp::t_time timeNext(const n_model::t_atomicmodelptr& model)
+{
+	const t_timestamp next = model->getTimeNext();
+	return isInfinity(next)? t_timestamp::MAXTIME: next.getTime();
+}
+
+/**
+ * Simulate model on a classic core up to endTime and record the scheduler's work in each step.
+ * @return the time next of each model after init, indexed by local id.
+ */
+std::vector<t_timestamp::t_time>
+recordSchedule(const n_model::t_coupledmodelptr& model, t_timestamp::t_time endTime, std::vector<ScheduleStep>& steps)
+{
+	n_tracers::t_tracersetptr tracers = createObject<n_tracers::t_tracerset>();
+	tracers->stopTracers();	//disable the output
+	n_model::t_coreptr core = createObject<n_model::Core>();
+	std::vector<n_model::t_coreptr> coreMap(1, core);
+	std::shared_ptr<Allocator> allocator = createObject<SimpleAllocator>(1);
+	Controller ctrl("recorder", coreMap, allocator, tracers);
+	ctrl.setSimType(SimType::CLASSIC);
+	ctrl.setTerminationTime(t_timestamp(endTime, 0));
+	ctrl.addModel(model);
+	core->setTracers(tracers);
+	core->init();
+	core->setTerminationTime(t_timestamp(endTime, 0));
+	core->setLive(true);
+	core->syncTime();
+
+	std::vector<t_timestamp::t_time> initial;
+	for(std::size_t i = 0; i < core->getModelCount(); ++i)
+		initial.push_back(timeNext(core->getModel(i)));
+	std::vector<t_timestamp::t_time> next = initial;
+	while(core->isLive()){
+		ScheduleStep step;
+		step.m_time = core->getTime().getTime();
+		step.m_imminents = std::count(next.begin(), next.end(), step.m_time);
+		core->runSmallStep();
+		for(std::size_t i = 0; i < next.size(); ++i){
+			const n_model::t_atomicmodelptr& atomic = core->getModel(i);
+			if(atomic->getTimeLast().getTime() != step.m_time)
+				continue;
+			next[i] = timeNext(atomic);
+			step.m_updates.push_back(std::make_pair(i, next[i]));
+		}
+		if(!step.m_updates.empty())
+			steps.push_back(step);
+	}
+	return initial;
+}
+
+/**
+ * Cheap deterministic mix of model id and time, for time advances that don't depend on the scheduler.
+ */
+std::size_t mix(std::size_t id, std::size_t time)
+{
+	std::size_t z = id * 0x9E3779B97F4A7C15ull + time;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+/**
+ * Steps of models with time advances spread over [1, 200000], wider than the wheel, found by a linear search.
+ * @return the time next of each model at time 0.
+ */
+std::vector<t_timestamp::t_time>
+spreadSchedule(std::size_t nmodels, std::size_t rounds, std::vector<ScheduleStep>& steps)
+{
+	std::vector<t_timestamp::t_time> initial;
+	for(std::size_t i = 0; i < nmodels; ++i)
+		initial.push_back(1 + mix(i, 0) % 200000);
+	std::vector<t_timestamp::t_time> next = initial;
+	for(std::size_t round = 0; round < rounds; ++round){
+		ScheduleStep step;
+		step.m_time = *std::min_element(next.begin(), next.end());
+		for(std::size_t i = 0; i < nmodels; ++i){
+			if(next[i] != step.m_time)
+				continue;
+			next[i] = step.m_time + 1 + mix(i, step.m_time) % 200000;
+			step.m_updates.push_back(std::make_pair(i, next[i]));
+		}
+		step.m_imminents = step.m_updates.size();
+		steps.push_back(step);
+	}
+	return initial;
+}
+
+/**
+ * Replay a recorded simulation on a model scheduler the way a core drives it (topTime, findUntil, transition, update).
+ * @return the time spent in the scheduler loop, trace holds (time, #imminents) per step.
+ */
+template<typename Scheduler>
+std::chrono::microseconds
+replaySchedule(const std::vector<t_timestamp::t_time>& initial, const std::vector<ScheduleStep>& steps, std::vector<std::size_t>& trace)
+{
+	std::vector<std::shared_ptr<HoldModel>> models;
+	Scheduler sched;
+	sched.reserve(initial.size());
+	for(std::size_t i = 0; i < initial.size(); ++i){
+		models.push_back(std::make_shared<HoldModel>(i));
+		models[i]->initUUID(0, i);
+		models[i]->m_ta = initial[i];
+		models[i]->setTime(t_timestamp(0, 0));
+		sched.push_back(models[i].get());
+	}
+	sched.updateAll();
+	std::vector<n_model::t_raw_atomic> imms;
+	const auto start = std::chrono::steady_clock::now();
+	for(const ScheduleStep& step : steps){
+		const t_timestamp now = sched.topTime();
+		imms.clear();
+		sched.findUntil(imms, t_timestamp(now.getTime(), 0));
+		sched.signalUpdateSize(step.m_updates.size());
+		for(n_model::t_raw_atomic imm: imms)
+			imm->markNone();
+		for(const auto& update : step.m_updates){
+			HoldModel* model = models[update.first].get();
+			model->m_ta = (update.second == t_timestamp::MAXTIME)? t_timestamp::MAXTIME: update.second - step.m_time;
+			model->setTime(t_timestamp(step.m_time, 0));
+			if(sched.doSingleUpdate())
+				sched.update(model);
+		}
+		if(!sched.doSingleUpdate())
+			sched.updateAll();
+		trace.push_back(now.getTime());
+		trace.push_back(imms.size());
+	}
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+void compareModelSchedulers(const std::string& name, const std::vector<t_timestamp::t_time>& initial, const std::vector<ScheduleStep>& steps)
+{
+	std::vector<std::size_t> expected;
+	for(const ScheduleStep& step : steps){
+		expected.push_back(step.m_time);
+		expected.push_back(step.m_imminents);
+	}
+	std::vector<std::size_t> heaptrace, wheeltrace;
+	const auto heaptime = replaySchedule<n_scheduler::ModelScheduler<n_scheduler::ModelHeapScheduler, std::vector>::t_type>(initial, steps, heaptrace);
+	const auto wheeltime = replaySchedule<n_scheduler::ModelScheduler<n_scheduler::ModelWheelScheduler, std::vector>::t_type>(initial, steps, wheeltrace);
+	EXPECT_EQ(heaptrace, expected);
+	EXPECT_EQ(wheeltrace, expected);
+	::testing::Test::RecordProperty(name + "_models", int(initial.size()));
+	::testing::Test::RecordProperty(name + "_steps", int(steps.size()));
+	::testing::Test::RecordProperty(name + "_heap_us", int(heaptime.count()));
+	::testing::Test::RecordProperty(name + "_wheel_us", int(wheeltime.count()));
+}
+
+} /* anonymous namespace */
+
+TEST(Performance, ModelScheduler)
+{
+	RecordProperty("description", "Compares the heap and timing wheel model schedulers on the steps of a PHOLD and a DEVStone simulation");
+
+	std::vector<ScheduleStep> steps;
+	const auto phold = recordSchedule(createObject<PHOLD>(1, 250, 0, 0), 10000, steps);
+	compareModelSchedulers("PHOLD", phold, steps);
+
+	steps.clear();
+	const auto devstone = recordSchedule(createObject<DEVStone>(1000, 2, false), 5000, steps);
+	compareModelSchedulers("DEVStone", devstone, steps);
+
+	// Not a benchmark run : time advances that don't fit in the wheel, the far list is used.
+	steps.clear();
+	const auto spread = spreadSchedule(2000, 2000, steps);
+	compareModelSchedulers("Spread", spread, steps);
+}
+#endif /* FPTIME */
@@ -28,6 +28,8 @@
 #include "tools/globallog.h"
 #include "tools/coutredirect.h"
 #include "tools/sharedvector.h"
+#include "tools/waitstrategy.h"
+#include "tools/forkjoin.h"
 #include "tools/gviz.h"
 #include "tools/flags.h"
 #include "tools/misc.h"
@@ -995,6 +997,67 @@ TEST(Factory, PoolCalls){
         n_tools::destroyPooledObject<mystr>(ptrtostr);
 }
 
+TEST(Pool, RemoteFree){
+        typedef n_pools::RemoteFreePool<mystr, n_pools::MCObjectPool> t_pool;
+        constexpr size_t psize = 100;
+        constexpr size_t threads = 4;
+        t_pool owner(psize);
+        std::vector<mystr*> objects;
+        for(size_t i = 0; i < threads*psize; ++i)
+                objects.push_back(new (owner.allocate()) mystr(int(i), 1.0));
+        std::vector<std::thread> ts;
+        for(size_t t = 0; t < threads; ++t){
+                ts.push_back(std::thread([&objects, t]()->void{
+                        t_pool local(psize);
+                        for(size_t i = t*psize; i < (t+1)*psize; ++i){
+                                mystr* own = new (local.allocate()) mystr(0, 0.0);
+                                EXPECT_EQ(objects[i]->i, int(i));
+                                local.deallocate(objects[i]);   // remote
+                                local.deallocate(own);          // local
+                        }
+                }));
+        }
+        for(auto& t : ts)
+                t.join();
+        // All remote frees are reclaimed at once, and handed out first.
+        std::set<mystr*> freed(objects.begin(), objects.end());
+        for(size_t i = 0; i < threads*psize; ++i){
+                objects[i] = new (owner.allocate()) mystr(0, 0.0);
+                EXPECT_EQ(freed.erase(objects[i]), 1u);
+        }
+        for(mystr* o : objects)
+                owner.deallocate(o);
+}
+
+TEST(Pool, SizeClass){
+        struct twin{
+                double d;
+                int i;
+        };
+        static_assert(n_pools::SizeClassHeap::classOf(sizeof(mystr)) == n_pools::SizeClassHeap::classOf(sizeof(twin)), "Test needs a single class.");
+        EXPECT_TRUE(n_pools::size_class_pooled<n_network::SpecializedMessage<int>>::value);
+        EXPECT_FALSE(n_pools::size_class_pooled<n_network::Message>::value);
+        n_pools::SizeClassPool<mystr> strs(0);
+        n_pools::SizeClassPool<twin> twins(0);
+        std::vector<mystr*> objects;
+        for(size_t i = 0; i < 1000; ++i){
+                objects.push_back(new (strs.allocate()) mystr(int(i), 0.0));
+                EXPECT_EQ(uintptr_t(objects.back()) % n_pools::size_class_step, 0u);
+        }
+        std::set<void*> freed(objects.begin(), objects.end());
+        for(mystr* o : objects)
+                strs.deallocate(o);
+        // Same size class, same memory.
+        for(size_t i = 0; i < 1000; ++i){
+                twin* t = twins.allocate();
+                EXPECT_EQ(freed.erase(t), 1u);
+                objects[i] = (mystr*) t;
+        }
+        for(mystr* o : objects)
+                twins.deallocate((twin*) o);
+        EXPECT_GE(n_pools::SizeClassHeap::local().slabs(), 1u);
+}
+
 TEST(Bits, FBS)
 {
         size_t i = 1;
@@ -1192,3 +1255,72 @@ TEST(RNG, Rnd){
     auto md = std::minmax(rvs,svs);
     EXPECT_TRUE(md.second - md.first <= EPSILON_FPTIME);
 }
+
+TEST(WaitStrategy, Park){
+        n_tools::WaitStrategy w(1, 1, 10000000);
+        // Spin and pause rounds return at once.
+        w.wait(1, w.getVersion());
+        w.wait(2, w.getVersion());
+        EXPECT_EQ(w.getParked(), 0u);
+        // A stale version doesn't park.
+        const std::size_t seen = w.getVersion();
+        w.notify();
+        w.wait(3, seen);
+        EXPECT_EQ(w.getParked(), 0u);
+        // A notification wakes a parked waiter long before its timeout.
+        std::atomic<bool> done(false);
+        const std::size_t cur = w.getVersion();
+        auto start = std::chrono::steady_clock::now();
+        std::thread waiter([&]{w.wait(3, cur); done = true;});
+        while(w.getParked() == 0)
+                std::this_thread::yield();
+        w.notify();
+        waiter.join();
+        EXPECT_TRUE(done);
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+        // Without notification, the timeout ends the wait.
+        n_tools::WaitStrategy t(0, 0, 1000);
+        t.wait(1, t.getVersion());
+        EXPECT_EQ(t.getParked(), 1u);
+}
+
+TEST(ForkJoin, Loops){
+        n_tools::ForkJoinPool pool(4, 16, 2);
+        EXPECT_EQ(pool.threads(), 4u);
+        EXPECT_FALSE(pool.shouldSplit(15));
+        EXPECT_TRUE(pool.shouldSplit(16));
+        // A short loop runs as one chunk on the caller.
+        std::size_t calls = 0;
+        pool.parallelFor(10, [&](std::size_t begin, std::size_t end, std::size_t slot){
+                ++calls;
+                EXPECT_EQ(begin, 0u);
+                EXPECT_EQ(end, 10u);
+                EXPECT_EQ(slot, 0u);
+        });
+        EXPECT_EQ(calls, 1u);
+        // Each iteration of a long loop runs exactly once.
+        for(std::size_t round = 0; round < 50; ++round){
+                std::vector<std::atomic<std::size_t>> hits(1000);
+                for(auto& h : hits)
+                        h = 0;
+                pool.parallelFor(hits.size(), [&](std::size_t begin, std::size_t end, std::size_t slot){
+                        EXPECT_LT(slot, 4u);
+                        EXPECT_LT(begin, end);
+                        for(std::size_t i = begin; i < end; ++i)
+                                ++hits[i];
+                });
+                for(auto& h : hits)
+                        EXPECT_EQ(h.load(), 1u);
+        }
+        // Each slot runs once, on its own thread.
+        std::vector<std::thread::id> ids(4);
+        pool.forEachSlot([&](std::size_t slot){ids[slot] = std::this_thread::get_id();});
+        EXPECT_EQ(ids[0], std::this_thread::get_id());
+        std::sort(ids.begin(), ids.end());
+        EXPECT_EQ(std::unique(ids.begin(), ids.end()), ids.end());
+        // An exception on a helper is rethrown by the caller, and the pool stays usable.
+        EXPECT_THROW(pool.forEachSlot([](std::size_t slot){if(slot == 2) throw std::runtime_error("slot");}), std::runtime_error);
+        std::atomic<std::size_t> count(0);
+        pool.forEachSlot([&](std::size_t){++count;});
+        EXPECT_EQ(count.load(), 4u);
+}
@@ -604,6 +604,55 @@ SINGLETRACERTEST(TESTFOLDERTRACE, XmlTracer)
 
 SINGLETRACERTEST(TESTFOLDERTRACE, JsonTracer)
 
+template<typename Tracer>
+void traceInternal(Tracer& tracer, const n_model::t_atomicmodelptr& model, t_timestamp::t_time time)
+{
+	model->getState()->setTimeLast(time);
+	model->setTime(time);
+	tracer.tracesInternal(model, 0u);
+	n_tracers::traceUntil(t_timestamp(400, 0));
+	n_tracers::clearAll();
+	n_tracers::waitForTracer();
+}
+
+TEST(tracing, continueTrace){
+	// A continued trace is a single trace, also in a fork.
+	n_model::t_atomicmodelptr model = std::make_shared<TestModel>();
+	{
+		XmlTracer<FileWriter> tracer;
+		tracer.initialize(TESTFOLDERTRACE "XmlTracer_whole.txt");
+		tracer.startTrace();
+		traceInternal(tracer, model, 12);
+		traceInternal(tracer, model, 13);
+		tracer.finishTrace();
+	}
+	{
+		XmlTracer<FileWriter> tracer;
+		tracer.initialize(TESTFOLDERTRACE "XmlTracer_continued.txt");
+		tracer.startTrace();
+		traceInternal(tracer, model, 12);
+		tracer.finishTrace();
+		tracer.continueTrace();
+		traceInternal(tracer, model, 13);
+		tracer.finishTrace();
+	}
+	EXPECT_EQ(n_misc::filecmp(TESTFOLDERTRACE "XmlTracer_continued.txt", TESTFOLDERTRACE "XmlTracer_whole.txt"), 0);
+	{
+		XmlTracer<FileWriter> tracer;
+		tracer.initialize(TESTFOLDERTRACE "XmlTracer_parent.txt");
+		tracer.startTrace();
+		traceInternal(tracer, model, 12);
+		tracer.finishTrace();
+		tracer.flushTracer();
+		tracer.forkTracer(".fork");
+		tracer.continueTrace();
+		traceInternal(tracer, model, 13);
+		tracer.finishTrace();
+	}
+	EXPECT_EQ(n_misc::filecmp(TESTFOLDERTRACE "XmlTracer_parent.txt.fork", TESTFOLDERTRACE "XmlTracer_whole.txt"), 0);
+	EXPECT_NE(n_misc::filecmp(TESTFOLDERTRACE "XmlTracer_parent.txt", TESTFOLDERTRACE "XmlTracer_whole.txt"), 0);
+}
+
 /* TEST(tracing, tracerCellTracer){
 	{
 		CellTracer<n_tracers::FileWriter, 5u, 5u> tracer1;
@@ -0,0 +1,135 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include "tools/forkjoin.h"
+#include "tools/globallog.h"
+#include <cassert>
+#include <algorithm>
+
+namespace n_tools {
+
+ForkJoinPool::ForkJoinPool(std::size_t threads, std::size_t minimum, std::size_t grain)
+	: m_threads(threads), m_minimum(minimum), m_grain(grain), m_generation(0), m_busy(0), m_stop(false),
+	  m_next(0), m_end(0), m_error(nullptr)
+{
+	assert(threads > 0 && "Fork join pool needs at least the calling thread.");
+	assert(grain > 0 && "Fork join grain can't be zero.");
+	for (std::size_t slot = 1; slot < m_threads; ++slot)
+		m_helpers.push_back(std::thread(&ForkJoinPool::help, this, slot));
+	LOG_INFO("FORKJOIN: Started ", m_helpers.size(), " helpers.");
+}
+
+ForkJoinPool::~ForkJoinPool()
+{
+	m_stop.store(true);
+	m_generation.fetch_add(1);
+	m_wait.notify();
+	for (auto& t : m_helpers) {
+		if (t.joinable())
+			t.join();
+	}
+}
+
+bool ForkJoinPool::claim(std::size_t& begin, std::size_t& end)
+{
+	std::size_t current = m_next.load(std::memory_order_relaxed);
+	while (current < m_end) {
+		const std::size_t chunk = std::max(m_grain, (m_end - current) / (2 * m_threads));
+		const std::size_t next = std::min(m_end, current + chunk);
+		if (m_next.compare_exchange_weak(current, next)) {
+			begin = current;
+			end = next;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ForkJoinPool::run(std::size_t slot)
+{
+	try {
+		m_job(slot);
+	} catch (...) {
+		std::lock_guard<std::mutex> lock(m_errorlock);
+		if (!m_error)
+			m_error = std::current_exception();
+	}
+}
+
+void ForkJoinPool::help(std::size_t slot)
+{
+	std::size_t seen = 0;
+	std::size_t round = 0;
+	while (true) {
+		const std::size_t version = m_wait.getVersion();
+		const std::size_t generation = m_generation.load();
+		if (generation != seen) {
+			seen = generation;
+			round = 0;
+			if (m_stop.load())
+				return;
+			run(slot);
+			m_busy.fetch_sub(1);
+			continue;
+		}
+		m_wait.wait(++round, version);
+	}
+}
+
+void ForkJoinPool::fork(const t_slotfunctor& job)
+{
+	m_job = job;
+	m_busy.store(m_threads - 1);
+	m_generation.fetch_add(1);
+	m_wait.notify();
+	run(0);
+	// The helpers are awake and the chunks are evened out, so this wait is short.
+	std::size_t round = 0;
+	while (m_busy.load()) {
+		if (++round < 1024)
+			cpuPause();
+		else
+			std::this_thread::yield();
+	}
+	m_job = nullptr;
+	if (m_error) {
+		std::exception_ptr error = m_error;
+		m_error = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+void ForkJoinPool::parallelFor(std::size_t n, const t_rangefunctor& fn)
+{
+	if (!shouldSplit(n)) {
+		if (n)
+			fn(0, n, 0);
+		return;
+	}
+	m_next.store(0);
+	m_end = n;
+	fork([&](std::size_t slot)->void {
+		std::size_t begin = 0;
+		std::size_t end = 0;
+		while (claim(begin, end))
+			fn(begin, end, slot);
+	});
+}
+
+void ForkJoinPool::forEachSlot(const t_slotfunctor& fn)
+{
+	if (m_threads == 1) {
+		fn(0);
+		return;
+	}
+	fork(fn);
+}
+
+} /* namespace n_tools */
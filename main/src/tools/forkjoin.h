@@ -0,0 +1,148 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_TOOLS_FORKJOIN_H_
+#define SRC_TOOLS_FORKJOIN_H_
+
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <functional>
+#include "tools/waitstrategy.h"
+
+namespace n_tools {
+
+/**
+ * @brief Runs loops of a single simulation thread on a fixed set of helper threads.
+ *
+ * The calling thread and threads()-1 helpers each have a slot, the caller is slot 0.
+ * A loop is split into chunks that the participants claim from a shared counter. A chunk is
+ * a fraction of the iterations that are left, but never less than the grain, so the first chunks are large
+ * and the last ones small enough to even out the load. Loops shorter than the minimum run on the caller.
+ * Idle helpers back off with a WaitStrategy, so they don't keep a cpu busy between steps.
+ *
+ * A helper runs a chunk with its own thread local pools. Memory it allocates has to be
+ * released from the same slot, with forEachSlot.
+ * @attention : not reentrant, only the thread that owns the pool may call parallelFor and forEachSlot.
+ */
+class ForkJoinPool
+{
+public:
+	/**
+	 * Run iterations [begin, end) of a loop.
+	 * @param slot : the slot of the participant running the chunk.
+	 */
+	typedef std::function<void(std::size_t begin, std::size_t end, std::size_t slot)> t_rangefunctor;
+
+	/**
+	 * Called once on each participant.
+	 */
+	typedef std::function<void(std::size_t slot)> t_slotfunctor;
+
+private:
+	const std::size_t m_threads;
+	const std::size_t m_minimum;
+	const std::size_t m_grain;
+
+	WaitStrategy m_wait;
+
+	/**
+	 * Incremented for each job, a helper runs the job when it sees a new value.
+	 */
+	std::atomic<std::size_t> m_generation;
+	/**
+	 * Nr of helpers that have not finished the current job.
+	 */
+	std::atomic<std::size_t> m_busy;
+	std::atomic<bool> m_stop;
+
+	/**
+	 * The current job, written by the caller before it increments m_generation.
+	 */
+	t_slotfunctor m_job;
+
+	/**
+	 * Next unclaimed iteration and end of the current loop.
+	 */
+	std::atomic<std::size_t> m_next;
+	std::size_t m_end;
+
+	/**
+	 * First exception thrown by a participant, rethrown by the caller.
+	 */
+	std::mutex m_errorlock;
+	std::exception_ptr m_error;
+
+	std::vector<std::thread> m_helpers;
+
+	bool claim(std::size_t& begin, std::size_t& end);
+
+	void run(std::size_t slot);
+
+	void help(std::size_t slot);
+
+	/**
+	 * Run job on every slot, return when all are done.
+	 */
+	void fork(const t_slotfunctor& job);
+
+public:
+	/**
+	 * Spawns threads-1 helpers.
+	 * @param threads : nr of participants, including the calling thread.
+	 * @param minimum : loops with fewer iterations are not split.
+	 * @param grain : smallest nr of iterations in a chunk.
+	 * @pre threads > 0 && grain > 0
+	 */
+	explicit ForkJoinPool(std::size_t threads, std::size_t minimum = 128, std::size_t grain = 8);
+
+	ForkJoinPool(const ForkJoinPool&) = delete;
+	ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+	/**
+	 * Stops and joins the helpers.
+	 */
+	~ForkJoinPool();
+
+	std::size_t threads() const
+	{
+		return m_threads;
+	}
+
+	/**
+	 * @return true if a loop of n iterations is split over the participants.
+	 */
+	bool shouldSplit(std::size_t n) const
+	{
+		return m_threads > 1 && n >= m_minimum;
+	}
+
+	/**
+	 * Run fn over [0, n) and wait until all iterations are done.
+	 * If !shouldSplit(n), fn is called once on the calling thread with slot 0.
+	 * @throw the first exception thrown by fn.
+	 */
+	void parallelFor(std::size_t n, const t_rangefunctor& fn);
+
+	/**
+	 * Run fn once on each slot, and wait until all are done.
+	 * @throw the first exception thrown by fn.
+	 */
+	void forEachSlot(const t_slotfunctor& fn);
+};
+
+typedef std::shared_ptr<ForkJoinPool> t_forkjoinptr;
+
+} /* namespace n_tools */
+
+#endif /* SRC_TOOLS_FORKJOIN_H_ */
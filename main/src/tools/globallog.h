@@ -91,6 +91,11 @@
 #define LOG_MOVE(file, append) LOG_NOOP
 #endif
 #if LOG_LEVEL
+#define LOG_FORK(suffix) LOG_BLOCK(LOG_GLOBAL.logFork(suffix))
+#else
+#define LOG_FORK(suffix) LOG_NOOP
+#endif
+#if LOG_LEVEL
 #define LOG_ARGV(argc, argv) \
 	LOG_BLOCK(LOG_GLOBAL.logDebug("DEBUG" " \t[ ", FILE_SHORT, " L: " STRINGIFY(__LINE__) " F: ", __FUNCTION__, "] \t");\
 	for(int i = 0; i < argc; ++i) { LOG_GLOBAL.logDebug(argv[i], ' ');} \
@@ -192,6 +192,19 @@ public:
 	        m_out.rdbuf(m_buf);
 	}
 
+	/**
+	 * @brief Continue logging in a forked process, in the log file with the given suffix.
+	 * The writer thread of the old file only exists in the parent process, so the old buffer is abandoned instead of
+	 * flushed or joined. Flush before forking, or output written before the fork may be lost for this process.
+	 * @param suffix Appended to the current filename.
+	 */
+	void logFork(const std::string& suffix){
+		// No lock, a thread of the parent holding it does not exist here.
+		m_filename += suffix;
+		m_buf = new ASynchWriter(m_filename);
+		m_out.rdbuf(m_buf);
+	}
+
 private:
 	std::string m_filename;
 	ASynchWriter* m_buf;
@@ -0,0 +1,51 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#include "tools/waitstrategy.h"
+
+namespace n_tools {
+
+constexpr std::size_t WaitStrategy::FOREVER;
+
+WaitStrategy::WaitStrategy(std::size_t spins, std::size_t pauses, std::size_t park)
+	: m_spins(spins), m_pauses(pauses), m_park(park), m_version(0), m_waiters(0), m_parked(0)
+{
+}
+
+void WaitStrategy::notify()
+{
+	m_version.fetch_add(1);
+	// Either we see the waiter, or the waiter sees the new version before it parks.
+	if(m_waiters.load()){
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_cv.notify_all();
+	}
+}
+
+void WaitStrategy::wait(std::size_t round, std::size_t seen)
+{
+	if(round <= m_spins)
+		return;
+	if(round - m_spins <= m_pauses){
+		cpuPause();
+		return;
+	}
+	m_waiters.fetch_add(1);
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if(m_version.load() == seen){
+			m_parked.fetch_add(1, std::memory_order_relaxed);
+			m_cv.wait_for(lock, m_park, [&]{return m_version.load() != seen;});
+		}
+	}
+	m_waiters.fetch_sub(1);
+}
+
+} /* namespace n_tools */
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the DEVS Ex Machina project.
+ * Copyright 2014 - 2016 University of Antwerp
+ * https://www.uantwerpen.be/en/
+ * Licensed under the EUPL V.1.1
+ * A full copy of the license is in COPYING.txt, or can be found at
+ * https://joinup.ec.europa.eu/community/eupl/og_page/eupl
+ *      Author: Ben Cardoen
+ */
+
+#ifndef SRC_TOOLS_WAITSTRATEGY_H_
+#define SRC_TOOLS_WAITSTRATEGY_H_
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <limits>
+#include <condition_variable>
+
+namespace n_tools {
+
+/**
+ * Hint the cpu that the calling thread is busy waiting.
+ */
+inline void cpuPause()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief Backoff for threads waiting on a value that other threads publish.
+ *
+ * A waiter first spins (retries at once), then executes a cpu pause per retry, then parks on a condition variable.
+ * Publishers call notify after each change, which bumps a version counter and wakes parked waiters.
+ * A waiter only parks if the version has not changed since it last looked at the published values,
+ * and never longer than the park timeout, so a missed notification can't hang it.
+ * One instance is shared by all threads that wait on each other.
+ */
+class WaitStrategy
+{
+private:
+	const std::size_t m_spins;
+	const std::size_t m_pauses;
+	const std::chrono::microseconds m_park;
+
+	std::atomic<std::size_t> m_version;
+	std::atomic<std::size_t> m_waiters;
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+
+	std::atomic<std::size_t> m_parked;
+
+public:
+	/// Use as spins or pauses to never leave that phase.
+	static constexpr std::size_t FOREVER = std::numeric_limits<std::size_t>::max();
+
+	/**
+	 * @param spins : nr of consecutive waiting rounds that retry at once.
+	 * @param pauses : nr of rounds after that which execute a cpu pause first.
+	 * @param park : maximum time (us) a later round is parked.
+	 */
+	WaitStrategy(std::size_t spins = 64, std::size_t pauses = 1024, std::size_t park = 1000);
+
+	WaitStrategy(const WaitStrategy&) = delete;
+	WaitStrategy& operator=(const WaitStrategy&) = delete;
+
+	/**
+	 * @return the current version, read it before looking at the published values.
+	 */
+	std::size_t
+	getVersion() const
+	{
+		return m_version.load();
+	}
+
+	/**
+	 * Signal that a published value changed, wakes all parked waiters.
+	 */
+	void
+	notify();
+
+	/**
+	 * Wait one round.
+	 * @param round : nr of consecutive rounds the caller has waited, starting at 1.
+	 * @param seen : the version read before the caller last looked at the published values.
+	 */
+	void
+	wait(std::size_t round, std::size_t seen);
+
+	/**
+	 * @return the nr of times a waiter parked.
+	 */
+	std::size_t
+	getParked() const
+	{
+		return m_parked.load(std::memory_order_relaxed);
+	}
+};
+
+typedef std::shared_ptr<WaitStrategy> t_waitstrategyptr;
+
+} /* namespace n_tools */
+
+#endif /* SRC_TOOLS_WAITSTRATEGY_H_ */
@@ -169,6 +169,14 @@ public:
 	inline void finishTrace()
 	{
 	}
+
+	/**
+	 * @brief Continues the trace output after finishTrace
+	 * Certain tracers can use this to take back their footer
+	 */
+	inline void continueTrace()
+	{
+	}
 };
 
 
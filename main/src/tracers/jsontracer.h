@@ -180,8 +180,17 @@ public:
 	 */
 	inline void finishTrace()
 	{
+		OutputPolicy::markTracer();
 		OutputPolicy::print("\n]}");
 	}
+
+	/**
+	 * @brief Continues the trace output after finishTrace, without the footer
+	 */
+	inline void continueTrace()
+	{
+		OutputPolicy::rewindTracer();
+	}
 };
 
 } /* namespace n_tracers */
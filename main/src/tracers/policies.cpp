@@ -11,6 +11,9 @@
 #include "tracers/policies.h"
 #include "tools/globallog.h"
 #include <sstream>
+#include <algorithm>
+#include <iterator>
+#include <unistd.h>
 
 void n_tracers::FileWriter::initialize(const std::string& fileName, bool append)
 {
@@ -54,20 +57,77 @@ bool n_tracers::FileWriter::isInitialized() const
 	return (m_stream != nullptr && !m_filename.empty());
 }
 
+namespace {
+std::streamoff fileSize(const std::string& fileName)
+{
+	std::ifstream in(fileName, std::ifstream::binary | std::ifstream::ate);
+	return in.is_open()? std::streamoff(in.tellg()) : 0;
+}
+} /* namespace */
+
+void n_tracers::FileWriter::flushTracer()
+{
+	assert(isInitialized());
+	m_stream->flush();
+	m_flushed = fileSize(m_filename);
+}
+
+void n_tracers::FileWriter::forkTracer(const std::string& suffix)
+{
+	assert(isInitialized());
+	// The buffer is empty since flushTracer, closing our copy of the file leaves the other process alone.
+	n_tools::takeBack(m_stream);
+	std::ifstream in(m_filename, std::ifstream::binary);
+	m_filename += suffix;
+	m_stream = new std::ofstream(m_filename, std::ofstream::out | std::ofstream::binary);
+	if (!(in.is_open() && m_stream->good() && m_stream->is_open())) {
+		n_tools::takeBack(m_stream);
+		m_stream = nullptr;
+		throw std::ios_base::failure("FileWriter::forkTracer Failed to copy the output.");
+	}
+	std::copy_n(std::istreambuf_iterator<char>(in), m_flushed, std::ostreambuf_iterator<char>(*m_stream));
+}
+
+void n_tracers::FileWriter::markTracer()
+{
+	assert(isInitialized());
+	m_stream->flush();
+	m_mark = fileSize(m_filename);
+}
+
+void n_tracers::FileWriter::rewindTracer()
+{
+	assert(isInitialized());
+	if (m_mark < 0)
+		return;
+	n_tools::takeBack(m_stream);
+	if (truncate(m_filename.c_str(), m_mark) != 0)
+		LOG_ERROR("FileWriter::rewindTracer Failed to truncate ", m_filename);
+	m_mark = -1;
+	m_stream = new std::ofstream(m_filename, std::ofstream::app);
+	if (!(m_stream->good() && m_stream->is_open())) {
+		n_tools::takeBack(m_stream);
+		m_stream = nullptr;
+		throw std::ios_base::failure("FileWriter::rewindTracer Failed to open file for output.");
+	}
+}
+
 n_tracers::FileWriter::~FileWriter()
 {
 	n_tools::takeBack(m_stream);	//delete should cope with nullptr. It should also close the stream and clear the buffer
 }
 
 n_tracers::FileWriter::FileWriter()
-	: m_stream(nullptr), m_disabled(false)
+	: m_stream(nullptr), m_disabled(false), m_flushed(0), m_mark(-1)
 {
 }
 
 n_tracers::FileWriter::FileWriter(FileWriter&& other)
 	: m_stream(std::move(other.m_stream)),
 	  m_disabled(std::move(other.m_disabled)),
-	  m_filename(std::move(other.m_filename))
+	  m_filename(std::move(other.m_filename)),
+	  m_flushed(other.m_flushed),
+	  m_mark(other.m_mark)
 {
 }
 
@@ -122,6 +182,27 @@ bool n_tracers::MultiFileWriter::isInitialized() const
 	return (!m_filename.empty());
 }
 
+void n_tracers::MultiFileWriter::flushTracer()
+{
+	if (m_stream.is_open())
+		m_stream.flush();
+}
+
+void n_tracers::MultiFileWriter::forkTracer(const std::string& suffix)
+{
+	if (m_stream.is_open())
+		m_stream.close();
+	m_filename += suffix;
+}
+
+void n_tracers::MultiFileWriter::markTracer()
+{
+}
+
+void n_tracers::MultiFileWriter::rewindTracer()
+{
+}
+
 n_tracers::CoutWriter::CoutWriter()
 	: m_disabled(false)
 {
@@ -146,3 +227,20 @@ void n_tracers::CoutWriter::startTracer(bool)
 {
 	m_disabled = false;
 }
+
+void n_tracers::CoutWriter::flushTracer()
+{
+	std::cout.flush();
+}
+
+void n_tracers::CoutWriter::forkTracer(const std::string&)
+{
+}
+
+void n_tracers::CoutWriter::markTracer()
+{
+}
+
+void n_tracers::CoutWriter::rewindTracer()
+{
+}
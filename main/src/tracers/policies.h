@@ -54,6 +54,29 @@ public:
 	 */
 	bool isInitialized() const;
 
+	/**
+	 * @brief Writes all buffered output to the file.
+	 */
+	void flushTracer();
+
+	/**
+	 * @brief Continues the output in a forked process, in a copy of the file with the given suffix.
+	 * The copy holds the output up to the last flushTracer, the other process keeps writing to the original file.
+	 * @precondition flushTracer was called before the fork.
+	 * @throws std::ios_base::failure If the copy could not be opened for output.
+	 */
+	void forkTracer(const std::string& suffix);
+
+	/**
+	 * @brief Remembers where the output ends now, for rewindTracer.
+	 */
+	void markTracer();
+
+	/**
+	 * @brief Removes the output written since the last markTracer, e.g. the footer of a trace that continues.
+	 */
+	void rewindTracer();
+
 protected:
 	/**
 	 * @brief Destructor. Will release all resources associated with the output file.
@@ -103,6 +126,8 @@ private:
 	std::ofstream* m_stream;
 	bool m_disabled;
 	std::string m_filename;
+	std::streamoff m_flushed;	// size of the file at the last flushTracer
+	std::streamoff m_mark;		// size of the file at the last markTracer, -1 if none
 
 	template<typename T, typename ... Args>
 	inline void printImpl(const T& data, const Args&... args)
@@ -187,6 +212,27 @@ public:
 	 */
 	void closeFile();
 
+	/**
+	 * @brief Writes all buffered output to the current file.
+	 */
+	void flushTracer();
+
+	/**
+	 * @brief Continues the output in a forked process, new files get the given suffix after the file name.
+	 * @precondition flushTracer was called before the fork.
+	 */
+	void forkTracer(const std::string& suffix);
+
+	/**
+	 * @brief Does nothing, each file is complete.
+	 */
+	void markTracer();
+
+	/**
+	 * @brief Does nothing, each file is complete.
+	 */
+	void rewindTracer();
+
 protected:
 	/**
 	 * @brief Destructor. Will release all resources associated with the output file(s).
@@ -276,6 +322,26 @@ public:
 	 */
 	void startTracer(bool recover);
 
+	/**
+	 * @brief Writes all buffered output to the console.
+	 */
+	void flushTracer();
+
+	/**
+	 * @brief Does nothing, a forked process writes to the same console.
+	 */
+	void forkTracer(const std::string& suffix);
+
+	/**
+	 * @brief Does nothing, see rewindTracer.
+	 */
+	void markTracer();
+
+	/**
+	 * @brief Does nothing, output on the console can't be taken back.
+	 */
+	void rewindTracer();
+
 protected:
 
 	/**
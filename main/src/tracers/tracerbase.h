@@ -28,6 +28,7 @@ namespace n_tracers {
 	void tracesConfluentImpl(const t_atomicmodelptr&, std::ostringstream*);
 	void startTrace();
 	void finishTrace();
+	void continueTrace();
  * @endcode
  * @see XmlTracer, @see JsonTracer, @see VerboseTracer for examples.
  */
@@ -165,6 +165,30 @@ public:
 	inline void finishTrace()
 	{
 	}
+
+	/**
+	 * @brief Continues the trace output after finishTrace
+	 * Certain tracers can use this to take back their footer
+	 */
+	inline void continueTrace()
+	{
+	}
+
+	/**
+	 * @brief Writes all buffered output of the tracers
+	 */
+	inline void flushTracers()
+	{
+	}
+
+	/**
+	 * @brief Lets the tracers continue in a forked process, with their own output where possible
+	 * @param suffix Appended to the names of the files of the output.
+	 * @precondition flushTracers was called before the fork.
+	 */
+	inline void forkTracers(const std::string&)
+	{
+	}
 };
 
 //recursive case; take one type from the pack and continue with the rest.
@@ -409,6 +433,36 @@ public:
 		m_elem.finishTrace();
 		getNext().finishTrace();
 	}
+
+	/**
+	 * @brief Continues the trace output after finishTrace
+	 * Certain tracers can use this to take back their footer
+	 */
+	inline void continueTrace()
+	{
+		m_elem.continueTrace();
+		getNext().continueTrace();
+	}
+
+	/**
+	 * @brief Writes all buffered output of the tracers
+	 */
+	inline void flushTracers()
+	{
+		m_elem.flushTracer();
+		getNext().flushTracers();
+	}
+
+	/**
+	 * @brief Lets the tracers continue in a forked process, with their own output where possible
+	 * @param suffix Appended to the names of the files of the output.
+	 * @precondition flushTracers was called before the fork.
+	 */
+	inline void forkTracers(const std::string& suffix)
+	{
+		m_elem.forkTracer(suffix);
+		getNext().forkTracers(suffix);
+	}
 private:
 	T m_elem;
 
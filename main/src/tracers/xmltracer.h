@@ -162,8 +162,17 @@ public:
 	 */
 	inline void finishTrace()
 	{
+		OutputPolicy::markTracer();
 		OutputPolicy::print("</trace>");
 	}
+
+	/**
+	 * @brief Continues the trace output after finishTrace, without the footer
+	 */
+	inline void continueTrace()
+	{
+		OutputPolicy::rewindTracer();
+	}
 };
 
 } /* namespace n_tracers */
@@ -16,11 +16,7 @@
 
 OUT_DIR="./bmarkdata/pdevs"
 EXEC_NORM="./binary/nonpdevs"
-EXEC_1THREADSLEEP="./binary/pdevs1sleep"
-EXEC_4THREAD="./binary/pdevs4"
-EXEC_16THREAD="./binary/pdevs16"
-EXEC_4THREADSLEEP="./binary/pdevs4sleep"
-EXEC_16THREADSLEEP="./binary/pdevs16sleep"
+EXEC_SLEEP="./binary/pdevssleep"
 BMARKDIR="./build/Benchmark"
 
 mkdir -p "./binary"
@@ -33,45 +29,12 @@ if [ ! -f "$EXEC_NORM" ]; then
 	cp build/Benchmark/dxexmachina_devstone $EXEC_NORM
 fi
 
-if [ ! -f "$EXEC_4THREAD" ]; then
+if [ ! -f "$EXEC_SLEEP" ]; then
 	if [ -d "$BMARKDIR" ]; then
 		rm -r "$BMARKDIR"
 	fi
-	./setup.sh -x "-DPDEVS=ON -DPDEVS_THREADS=4 -DPDEVS_LOAD=0" -b dxexmachina_devstone
-	cp build/Benchmark/dxexmachina_devstone $EXEC_4THREAD
-fi
-
-if [ ! -f "$EXEC_16THREAD" ]; then
-	if [ -d "$BMARKDIR" ]; then
-		rm -r "$BMARKDIR"
-	fi
-	./setup.sh -x "-DPDEVS=ON -DPDEVS_THREADS=16 -DPDEVS_LOAD=0" -b dxexmachina_devstone
-	cp build/Benchmark/dxexmachina_devstone $EXEC_16THREAD
-fi
-
-if [ ! -f "$EXEC_1THREADSLEEP" ]; then
-	if [ -d "$BMARKDIR" ]; then
-		rm -r "$BMARKDIR"
-	fi
-	./setup.sh -x "-DPDEVS=ON -DPDEVS_THREADS=1 -DPDEVS_LOAD=5" -b dxexmachina_devstone
-	cp build/Benchmark/dxexmachina_devstone $EXEC_1THREADSLEEP
-fi
-
-
-if [ ! -f "$EXEC_4THREADSLEEP" ]; then
-	if [ -d "$BMARKDIR" ]; then
-		rm -r "$BMARKDIR"
-	fi
-	./setup.sh -x "-DPDEVS=ON -DPDEVS_THREADS=4 -DPDEVS_LOAD=5" -b dxexmachina_devstone
-	cp build/Benchmark/dxexmachina_devstone $EXEC_4THREADSLEEP
-fi
-
-if [ ! -f "$EXEC_16THREADSLEEP" ]; then
-	if [ -d "$BMARKDIR" ]; then
-		rm -r "$BMARKDIR"
-	fi
-	./setup.sh -x "-DPDEVS=ON -DPDEVS_THREADS=16 -DPDEVS_LOAD=5" -b dxexmachina_devstone
-	cp build/Benchmark/dxexmachina_devstone $EXEC_16THREADSLEEP
+	./setup.sh -x "-DPDEVS_LOAD=5" -b dxexmachina_devstone
+	cp build/Benchmark/dxexmachina_devstone $EXEC_SLEEP
 fi
 
 ARGS_NOSLEEP=" -d 4 -w 400 -t 5000000 "
@@ -82,26 +45,18 @@ echo "Executing benchmarks"
 perf stat -r $REPEAT -o "$OUT_DIR/normal_seq.txt" $EXEC_NORM $ARGS_NOSLEEP
 perf stat -r $REPEAT -o "$OUT_DIR/normal_con.txt" $EXEC_NORM $ARGS_NOSLEEP cpdevs -c 16
 perf stat -r $REPEAT -o "$OUT_DIR/normal_opt.txt" $EXEC_NORM $ARGS_NOSLEEP opdevs -c 16
-perf stat -r $REPEAT -o "$OUT_DIR/pdevs_seq.txt" $EXEC_16THREAD $ARGS_NOSLEEP
-perf stat -r $REPEAT -o "$OUT_DIR/pdevs_con.txt" $EXEC_4THREAD $ARGS_NOSLEEP cpdevs -c 4
-perf stat -r $REPEAT -o "$OUT_DIR/pdevs_opt.txt" $EXEC_4THREAD $ARGS_NOSLEEP opdevs -c 4
-perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_seq.txt" $EXEC_1THREADSLEEP $ARGS_SLEEP
-perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_con.txt" $EXEC_1THREADSLEEP $ARGS_SLEEP cpdevs -c 16
-perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_opt.txt" $EXEC_1THREADSLEEP $ARGS_SLEEP opdevs -c 16
-perf stat -r $REPEAT -o "$OUT_DIR/pdevs_sleep_seq.txt" $EXEC_16THREADSLEEP $ARGS_SLEEP
-perf stat -r $REPEAT -o "$OUT_DIR/pdevs_sleep_con.txt" $EXEC_4THREADSLEEP $ARGS_SLEEP cpdevs -c 4
-perf stat -r $REPEAT -o "$OUT_DIR/pdevs_sleep_opt.txt" $EXEC_4THREADSLEEP $ARGS_SLEEP opdevs -c 4
-
-#perf stat -r $REPEAT -o "$OUT_DIR/normal_seq_r.txt" $EXEC_NORM $ARGS_NOSLEEP -r
-#perf stat -r $REPEAT -o "$OUT_DIR/normal_con_r.txt" $EXEC_NORM $ARGS_NOSLEEP cpdevs -c 16 -r
-#perf stat -r $REPEAT -o "$OUT_DIR/normal_opt_r.txt" $EXEC_NORM $ARGS_NOSLEEP opdevs -c 16 -r
-perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_seq_r.txt" $EXEC_1THREADSLEEP $ARGS_SLEEP -r
-perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_con_r.txt" $EXEC_1THREADSLEEP $ARGS_SLEEP cpdevs -c 16 -r
-perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_opt_r.txt" $EXEC_1THREADSLEEP $ARGS_SLEEP opdevs -c 16 -r
-#perf stat -r $REPEAT -o "$OUT_DIR/pdevs_seq_r.txt" $EXEC_16THREAD $ARGS_NOSLEEP -r
-#perf stat -r $REPEAT -o "$OUT_DIR/pdevs_con_r.txt" $EXEC_4THREAD $ARGS_NOSLEEP cpdevs -c 4 -r
-#perf stat -r $REPEAT -o "$OUT_DIR/pdevs_opt_r.txt" $EXEC_4THREAD $ARGS_NOSLEEP opdevs -c 4 -r
-perf stat -r $REPEAT -o "$OUT_DIR/pdevs_sleep_seq_r.txt" $EXEC_16THREADSLEEP $ARGS_SLEEP -r
-perf stat -r $REPEAT -o "$OUT_DIR/pdevs_sleep_con_r.txt" $EXEC_4THREADSLEEP $ARGS_SLEEP cpdevs -c 4 -r
-perf stat -r $REPEAT -o "$OUT_DIR/pdevs_sleep_opt_r.txt" $EXEC_4THREADSLEEP $ARGS_SLEEP opdevs -c 4 -r
-
+perf stat -r $REPEAT -o "$OUT_DIR/pdevs_seq.txt" $EXEC_NORM $ARGS_NOSLEEP -p 16
+perf stat -r $REPEAT -o "$OUT_DIR/pdevs_con.txt" $EXEC_NORM $ARGS_NOSLEEP cpdevs -c 4 -p 4
+perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_seq.txt" $EXEC_SLEEP $ARGS_SLEEP
+perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_con.txt" $EXEC_SLEEP $ARGS_SLEEP cpdevs -c 16
+perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_opt.txt" $EXEC_SLEEP $ARGS_SLEEP opdevs -c 16
+perf stat -r $REPEAT -o "$OUT_DIR/pdevs4_sleep_seq.txt" $EXEC_SLEEP $ARGS_SLEEP -p 4
+perf stat -r $REPEAT -o "$OUT_DIR/pdevs_sleep_seq.txt" $EXEC_SLEEP $ARGS_SLEEP -p 16
+perf stat -r $REPEAT -o "$OUT_DIR/pdevs_sleep_con.txt" $EXEC_SLEEP $ARGS_SLEEP cpdevs -c 4 -p 4
+
+perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_seq_r.txt" $EXEC_SLEEP $ARGS_SLEEP -r
+perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_con_r.txt" $EXEC_SLEEP $ARGS_SLEEP cpdevs -c 16 -r
+perf stat -r $REPEAT -o "$OUT_DIR/npdevs_sleep_opt_r.txt" $EXEC_SLEEP $ARGS_SLEEP opdevs -c 16 -r
+perf stat -r $REPEAT -o "$OUT_DIR/pdevs4_sleep_seq_r.txt" $EXEC_SLEEP $ARGS_SLEEP -r -p 4
+perf stat -r $REPEAT -o "$OUT_DIR/pdevs_sleep_seq_r.txt" $EXEC_SLEEP $ARGS_SLEEP -r -p 16
+perf stat -r $REPEAT -o "$OUT_DIR/pdevs_sleep_con_r.txt" $EXEC_SLEEP $ARGS_SLEEP cpdevs -c 4 -r -p 4
@@ -0,0 +1,56 @@
+/* src/config.hpp.  Generated from config.hpp.in by configure.  */
+/* src/config.hpp.in.  Generated from configure.ac by autoheader.  */
+
+/* Define to 1 if you have BOOST library. */
+#define TRNG_HAVE_BOOST 1
+
+/* Define to 1 if you have the `errf' function. */
+#define TRNG_HAVE_ERF 1
+
+/* Define to 1 if you have the `erfc' function. */
+#define TRNG_HAVE_ERFC 1
+
+/* Define to 1 if you have the `erfcf' function. */
+#define TRNG_HAVE_ERFCF 1
+
+/* Define to 1 if you have the `erfcl' function. */
+#define TRNG_HAVE_ERFCL 1
+
+/* Define to 1 if you have the `errff' function. */
+#define TRNG_HAVE_ERFF 1
+
+/* Define to 1 if you have the `errfl' function. */
+#define TRNG_HAVE_ERFL 1
+
+/* Define to 1 if you have the `lgamma' function. */
+#define TRNG_HAVE_LGAMMA 1
+
+/* Define to 1 if you have the `lgammaf' function. */
+#define TRNG_HAVE_LGAMMAF 1
+
+/* Define to 1 if you have the `lgammal' function. */
+#define TRNG_HAVE_LGAMMAL 1
+
+/* Define to 1 if long long is a built-in type. */
+#define TRNG_HAVE_LONG_LONG /**/
+
+/* Define to 1 if you have a MPI library. */
+#define TRNG_HAVE_MPI 1
+
+/* Define if OpenMP is enabled */
+#define TRNG_HAVE_OPENMP 1
+
+/* Define to 1 if Intel Threading Building Blocks are available. */
+#define TRNG_HAVE_TBB 1
+
+/* Define to 1 if you have the `tgamma' function. */
+#define TRNG_HAVE_TGAMMA 1
+
+/* Define to 1 if you have the `tgammaf' function. */
+#define TRNG_HAVE_TGAMMAF 1
+
+/* Define to 1 if you have the `tgammal' function. */
+#define TRNG_HAVE_TGAMMAL 1
+
+/* TRNG version number. */
+#define TRNG_VERSION 4.19
@@ -0,0 +1,254 @@
+// Copyright (c) 2000-2015, Heiko Bauke
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 
+//   * Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.  
+// 
+//   * Redistributions in binary form must reproduce the above
+//     copyright notice, this list of conditions and the following
+//     disclaimer in the documentation and/or other materials provided
+//     with the distribution.  
+// 
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived
+//     from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#if !(defined TRNG_LOGNORMAL_DIST_HPP)
+
+#define TRNG_LOGNORMAL_DIST_HPP
+
+#include <trng/cuda.hpp>
+#include <trng/constants.hpp>
+#include <trng/limits.hpp>
+#include <trng/utility.hpp>
+#include <trng/math.hpp>
+#include <trng/special_functions.hpp>
+#include <ostream>
+#include <istream>
+#include <iomanip>
+#include <cerrno>
+
+namespace trng {
+
+  // uniform random number generator class
+  template<typename float_t=double>
+  class lognormal_dist {
+  public:
+    typedef float_t result_type;
+    class param_type;
+    
+    class param_type {
+    private:
+      result_type mu_, sigma_;
+    public:
+      TRNG_CUDA_ENABLE
+      result_type mu() const { return mu_; }
+      TRNG_CUDA_ENABLE
+      void mu(result_type mu_new) { mu_=mu_new; }
+      TRNG_CUDA_ENABLE
+      result_type sigma() const { return sigma_; }
+      TRNG_CUDA_ENABLE
+      void sigma(result_type sigma_new) { sigma_=sigma_new; }
+      TRNG_CUDA_ENABLE
+      explicit param_type() : mu_(0), sigma_(1) {
+      }
+      TRNG_CUDA_ENABLE
+      param_type(result_type mu, result_type sigma) : mu_(mu), sigma_(sigma) {
+      }
+
+      friend class lognormal_dist;
+
+      // Streamable concept
+      template<typename char_t, typename traits_t>
+      friend std::basic_ostream<char_t, traits_t> &
+      operator<<(std::basic_ostream<char_t, traits_t> &out,
+                 const param_type &p) {
+        std::ios_base::fmtflags flags(out.flags());
+        out.flags(std::ios_base::dec | std::ios_base::fixed |
+                  std::ios_base::left);
+        out << '('
+            << std::setprecision(math::numeric_limits<float_t>::digits10+1) 
+            << p.mu() << ' ' << p.sigma() 
+            << ')';
+        out.flags(flags);
+        return out;
+      }
+      
+      template<typename char_t, typename traits_t>
+      friend std::basic_istream<char_t, traits_t> &
+      operator>>(std::basic_istream<char_t, traits_t> &in,
+                 param_type &p) {
+        float_t mu, sigma;
+        std::ios_base::fmtflags flags(in.flags());
+        in.flags(std::ios_base::dec | std::ios_base::fixed |
+                 std::ios_base::left);
+        in >> utility::delim('(')
+           >> mu >> utility::delim(' ')
+           >> sigma >> utility::delim(')');
+        if (in)
+          p=param_type(mu, sigma);
+        in.flags(flags);
+        return in;
+      }
+
+    };
+    
+  private:
+    param_type p;
+    
+  public:
+    // constructor
+    TRNG_CUDA_ENABLE
+    lognormal_dist(result_type mu, result_type sigma) : p(mu, sigma) {
+    }
+    TRNG_CUDA_ENABLE
+    explicit lognormal_dist(const param_type &p) : p(p) {
+    }
+    // reset internal state
+    TRNG_CUDA_ENABLE
+    void reset() { }
+    // random numbers
+    template<typename R>
+    TRNG_CUDA_ENABLE
+    result_type operator()(R &r) {
+      return icdf(utility::uniformoo<result_type>(r));
+    }
+    template<typename R>
+    TRNG_CUDA_ENABLE
+    result_type operator()(R &r, const param_type &p) {
+      lognormal_dist g(p);
+      return g(r);
+    }
+    // property methods
+    TRNG_CUDA_ENABLE
+    result_type min() const { return 0; }
+    TRNG_CUDA_ENABLE
+    result_type max() const { return math::numeric_limits<result_type>::infinity(); }
+    TRNG_CUDA_ENABLE
+    param_type param() const { return p; }
+    TRNG_CUDA_ENABLE
+    void param(const param_type &p_new) { p=p_new; }
+    TRNG_CUDA_ENABLE
+    result_type mu() const { return p.mu(); }
+    TRNG_CUDA_ENABLE
+    void mu(result_type mu_new) { p.mu(mu_new); }
+    TRNG_CUDA_ENABLE
+    result_type sigma() const { return p.sigma(); }
+    TRNG_CUDA_ENABLE
+    void sigma(result_type sigma_new) { p.sigma(sigma_new); }
+    // probability density function  
+    TRNG_CUDA_ENABLE
+    result_type pdf(result_type x) const {
+      if (x<=0)
+        return 0;
+      result_type t((math::ln(x)-p.mu())/p.sigma());
+      return math::constants<result_type>::one_over_sqrt_2pi()/(x*p.sigma())*math::exp(-t*t/2);
+    }
+    // cumulative density function 
+    TRNG_CUDA_ENABLE
+    result_type cdf(result_type x) const {
+      if (x<=0)
+        return 0;
+      return math::erfc(math::constants<result_type>::one_over_sqrt_2()*
+			(p.mu()-math::ln(x))/p.sigma())/2;
+    }
+    // inverse cumulative density function 
+    TRNG_CUDA_ENABLE
+    result_type icdf(result_type x) const {
+      if (x<0 or x>1) {
+#if !(defined __CUDA_ARCH__)
+	errno=EDOM;
+#endif
+        return math::numeric_limits<result_type>::quiet_NaN();
+      }
+      if (x==0)
+        return 0;
+      if (x==1)
+        return math::numeric_limits<result_type>::infinity();
+      return math::exp(math::inv_Phi(x)*p.sigma()+p.mu());
+    }
+  };
+    
+  // -------------------------------------------------------------------
+
+  // EqualityComparable concept
+  template<typename float_t>
+  TRNG_CUDA_ENABLE
+  inline bool operator==(const typename lognormal_dist<float_t>::param_type &p1, 
+                         const typename lognormal_dist<float_t>::param_type &p2) {
+    return p1.mu()==p2.mu() and p1.sigma()==p2.sigma();
+  }
+
+  template<typename float_t>
+  TRNG_CUDA_ENABLE
+  inline bool operator!=(const typename lognormal_dist<float_t>::param_type &p1, 
+                         const typename lognormal_dist<float_t>::param_type &p2) {
+    return not (p1==p2);
+  }  
+  
+  // -------------------------------------------------------------------
+
+  // EqualityComparable concept
+  template<typename float_t>
+  TRNG_CUDA_ENABLE
+  inline bool operator==(const lognormal_dist<float_t> &g1, 
+                         const lognormal_dist<float_t> &g2) {
+    return g1.param()==g2.param();
+  }
+
+  template<typename float_t>
+  TRNG_CUDA_ENABLE
+  inline bool operator!=(const lognormal_dist<float_t> &g1, 
+                         const lognormal_dist<float_t> &g2) {
+    return g1.param()!=g2.param();
+  }
+  
+  // Streamable concept
+  template<typename char_t, typename traits_t, typename float_t>
+  std::basic_ostream<char_t, traits_t> &
+  operator<<(std::basic_ostream<char_t, traits_t> &out,
+	     const lognormal_dist<float_t> &g) {
+    std::ios_base::fmtflags flags(out.flags());
+    out.flags(std::ios_base::dec | std::ios_base::fixed |
+	      std::ios_base::left);
+    out << "[lognormal " << g.param() << ']';
+    out.flags(flags);
+    return out;
+  }
+  
+  template<typename char_t, typename traits_t, typename float_t>
+  std::basic_istream<char_t, traits_t> &
+  operator>>(std::basic_istream<char_t, traits_t> &in,
+	     lognormal_dist<float_t> &g) {
+    typename lognormal_dist<float_t>::param_type p;
+    std::ios_base::fmtflags flags(in.flags());
+    in.flags(std::ios_base::dec | std::ios_base::fixed |
+	     std::ios_base::left);
+    in >> utility::ignore_spaces()
+       >> utility::delim("[lognormal ") >> p >> utility::delim(']');
+    if (in)
+      g.param(p);
+    in.flags(flags);
+    return in;
+  }
+  
+}
+
+#endif